@@ -0,0 +1,14 @@
+#ifndef ASTRA_DRIVER_H
+#define ASTRA_DRIVER_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "config.h"
+#include "oled_flusher.h"
+
+// astra-ui-lite绘制驱动 (astra_ui_draw_driver.h中的oled_*宏) 的目标
+// 图元直接画到Adafruit_SSD1306的帧缓冲，发送经由OledFlusher与传感器共享总线。
+// flusher为nullptr时发送使用display()。
+void astraDriverAttach(Adafruit_SSD1306* display, OledFlusher* flusher);
+
+#endif // ASTRA_DRIVER_H
@@ -0,0 +1,128 @@
+#ifndef ASTRA_FRONTEND_H
+#define ASTRA_FRONTEND_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "config.h"
+#include "oled_flusher.h"
+#include "ui_adapter.h"
+#include "num_format.h"
+#include "user_input.h"
+
+// astra-ui-lite 动画菜单前端，与UIAdapter二选一
+// 主页面长按进入，在astra根菜单双击 (或任意位置长按) 退出回到UIAdapter。
+// 激活期间每ASTRA_FRAME_INTERVAL毫秒检查一次: 有输入或动画未停止时整帧重绘，
+// 全部补间到位且没有计时元素后不再绘制。绘制耗时计入PROF_ZONE_DRAW，
+// 同时单独统计，与UIAdapter的 `UI` 统计行对比。
+// astra每帧重画整个帧缓冲，但只有选择框、信息栏和弹窗移动时只用oled_send_area_buffer()
+// 发送新旧位置的并集；相机/列表项滚动、退场遮罩和用户项页面整屏发送。
+// 动画停止后再整屏提交一次，补上窗口之外遗留的变化 (刷新器逐列比较，通常不发送数据)。
+class AstraFrontend {
+private:
+    // 屏幕区域 (像素，含两端)，x0 > x1时为空
+    struct Area {
+        int16_t x0;
+        int16_t y0;
+        int16_t x1;
+        int16_t y1;
+    };
+    
+    Adafruit_SSD1306* display;  // 显示屏指针 (帧缓冲)
+    OledFlusher* flusher;       // 分页刷新器 (可选)
+    UIAdapter* uiAdapter;       // 目标温度写回UIAdapter，由输入任务交给控制任务
+    bool initialized;
+    bool active;                // astra前端正在显示
+    
+    // 菜单项绑定的数值
+    int16_t targetSetting;      // 目标温度 (°C)
+    
+    uint32_t lastFrameTime;     // 上一帧的时间 (毫秒)，动画按经过的时间推进
+    bool inputPending;          // 有输入尚未绘制 (输入会改变补间目标)
+    
+    // 局部发送: 上一帧各元素的位置，本帧与之合并为发送窗口
+    Area lastSelector;
+    Area lastInfoBar;
+    Area lastPopUp;
+    Area lastRow;               // 选中项所在行 (开关/滑块数值)
+    uint8_t lastSelectedIndex;  // 右侧进度条的位置
+    bool layoutSettled;         // 上一帧相机和列表项都已到位
+    bool fullFrame;             // 下一帧整屏发送 (进入前端后屏幕内容未知)
+    bool settlePending;         // 局部发送过，动画停止后需要整屏提交一次
+    bool transferPending;       // 已提交、传输耗时尚未计入统计
+    
+    // 状态页数据
+    float currentTemp;
+    uint8_t powerPercentage;
+    
+    // 帧统计
+    uint32_t frameCount;        // 绘制帧数
+    uint32_t skippedFrames;     // 刷新器忙而跳过的帧数
+    uint32_t idleFrames;        // 画面静止而未绘制的帧数
+    uint64_t totalCycles;       // 绘制耗时累计 (周期)
+    uint32_t maxCycles;         // 最长绘制耗时 (周期)
+    uint64_t totalAreaPixels;   // 发送窗口面积累计 (像素)
+    uint32_t transferCount;     // 已计入的传输次数
+    uint64_t totalTransferTime; // 传输耗时累计 (微秒)
+    uint32_t maxTransferTime;   // 最长传输耗时 (微秒)
+    
+    // 创建菜单树，内存池不足时返回false
+    bool buildMenu();
+    
+    // 状态页 (astra用户项) 的绘制函数
+    static void statusLoop();
+    
+    // 区域运算
+    static Area emptyArea();
+    static void unite(Area& area, const Area& other);
+    
+    // 本帧各元素的绘制位置 (在astra绘制之后读取，未显示时为空)
+    static Area selectorArea();
+    static Area infoBarArea();
+    static Area popUpArea();
+    static Area selectedRowArea();
+    
+    // 相机和当前列表的列表项都已到位
+    static bool isLayoutSettled();
+    
+    // 计算本帧的发送窗口，返回false表示需要整屏发送
+    bool computeDamage(Area& damage);
+    
+    // 提交发送并记录传输耗时
+    void send(const Area* area);
+    
+    // 上一次提交的传输已完成时计入统计 (刷新器空闲时调用)
+    void collectTransfer();
+
+public:
+    AstraFrontend(Adafruit_SSD1306* _display, OledFlusher* _flusher, UIAdapter* _uiAdapter);
+    
+    // 绑定绘制驱动并创建菜单
+    bool begin();
+    
+    // 切换到astra前端
+    void enter();
+    
+    // 回到UIAdapter
+    void leave();
+    
+    // astra前端是否正在显示
+    bool isActive();
+    
+    // 更新状态页数据
+    void setStatus(float current, uint8_t power);
+    
+    // 绘制一帧并提交刷新 (激活时由调度器按ASTRA_FRAME_INTERVAL周期调用)
+    void update();
+    
+    // 处理一个用户输入事件
+    void handleInput(const InputEvent& event);
+    
+    // 串口输出统计: ASTRA,绘制帧数,忙时跳过帧数,静止帧数,平均绘制us,最长绘制us,
+    // 平均发送窗口占屏幕%,平均传输us,最长传输us
+    void printStats();
+    
+    // 清零统计
+    void resetStats();
+};
+
+#endif // ASTRA_FRONTEND_H
@@ -0,0 +1,21 @@
+#ifndef BIG_DIGITS_H
+#define BIG_DIGITS_H
+
+#include <Arduino.h>
+
+// 16x24大号数字字模 (当前温度显示)
+// 按SSD1306帧缓冲格式存放: 每个字符3页，每页每列一个字节 (低位在上)，
+// 纵坐标按8对齐时可以整字节复制到帧缓冲，不需要逐像素绘制。
+#define BIG_DIGIT_WIDTH 16          // 数字和负号宽度 (含右侧间隔)
+#define BIG_DIGIT_HEIGHT 24
+#define BIG_DIGIT_PAGES (BIG_DIGIT_HEIGHT / 8)
+#define BIG_DIGIT_POINT_WIDTH 6     // 小数点宽度
+#define BIG_DIGIT_MINUS 10          // 负号在字模表中的序号
+
+// 字模: '0'-'9'、'-'
+extern const uint8_t BIG_DIGIT_GLYPHS[11][BIG_DIGIT_PAGES][BIG_DIGIT_WIDTH];
+
+// 小数点
+extern const uint8_t BIG_DIGIT_POINT[BIG_DIGIT_PAGES][BIG_DIGIT_POINT_WIDTH];
+
+#endif // BIG_DIGITS_H
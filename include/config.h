@@ -13,6 +13,7 @@
 // ADS1115
 #define ADS1115_ADDR 0x48
 #define NTC_CHANNEL 0
+#define SUPPLY_CHANNEL 1   // 加热器电源分压检测通道
 
 // OLED
 #define OLED_ADDR 0x3C
@@ -24,6 +25,10 @@
 #define ENCODER_PIN_B 4
 #define ENCODER_BTN_PIN 7
 #define ENCODER_STEPS_PER_NOTCH 4
+#define ENCODER_BTN_ACTIVE_LEVEL LOW    // 按钮按下时的电平
+#define INPUT_DEBOUNCE_MS 20            // 按钮消抖时间
+#define INPUT_EDGE_QUEUE_SIZE 16        // 中断->任务按钮边沿队列容量 (2的幂)
+#define INPUT_EVENT_QUEUE_SIZE 8        // 手势事件队列容量 (2的幂)
 
 // PWM输出
 #define PWM_PIN 8
@@ -31,6 +36,12 @@
 #define PWM_FREQ 20000  // 20kHz
 #define PWM_RESOLUTION 10 // 10bit分辨率，0-1023
 
+// 整周期输出模式 (Burst-fire): 以整窗口为单位通断，适用于热时间常数较大的PTC负载
+#define BURST_TIMER_ID 1        // 硬件定时器编号 (定时器0用于看门狗)
+#define BURST_WINDOW_MS 20      // 窗口长度 (毫秒)，每个窗口整体导通或关断
+#define BURST_WINDOW_MIN_MS 1   // BURST_WINDOW_MS的允许范围 (编译时检查)
+#define BURST_WINDOW_MAX_MS 1000
+
 // 温度控制参数
 #define TEMP_MIN 0.0f
 #define TEMP_MAX 100.0f
@@ -42,20 +53,128 @@
 #define NTC_SERIES_R 100000.0f // 串联电阻 (100K)
 #define NTC_VCC 3.3f       // 参考电压
 
+// 加热器电源电压检测 (12V --- 47K --- 分压点 --- 10K --- GND)
+#define SUPPLY_VOLTAGE_NOMINAL 12.0f   // 额定供电电压
+#define SUPPLY_DIVIDER_RATIO 5.7f      // 分压比 (47K + 10K) / 10K
+#define SUPPLY_VOLTAGE_MIN 6.0f        // 低于此电压不做补偿 (未接分压或电源异常)
+#define SUPPLY_SAMPLE_INTERVAL 200     // 毫秒
+#define SUPPLY_COMPENSATION_ENABLED 1  // 默认启用电压补偿 (恒功率输出)
+
+// PTC输出线性化表 (占空比 -> 有效功率，按加热器温度索引)
+#define OUTPUT_MAP_ENABLED 1
+#define OUTPUT_MAP_TEMP_POINTS 6        // 温度节点数 (TEMP_MIN到TEMP_MAX等分)
+#define OUTPUT_MAP_DUTY_POINTS 5        // 占空比节点数 (0到满占空比等分)
+
+// 加热器能耗统计
+#define HEATER_POWER_NOMINAL 20.0f     // 额定电压下满占空比加热功率 (W)
+#define ENERGY_SAVE_INTERVAL 600000    // 累计能耗保存间隔 (10分钟，减少Flash写入)
+
 // PID参数默认值
 #define PID_KP_DEFAULT 10.0f
 #define PID_KI_DEFAULT 0.1f
 #define PID_KD_DEFAULT 1.0f
+#define PID_OUTPUT_MIN 0.0  // PID输出 (功率指令) 范围，对应10位PWM分辨率
+#define PID_OUTPUT_MAX 1023.0
 
 // 安全保护参数
 #define TEMP_PROTECTION_MAX 100.0f
 #define TEMP_PROTECTION_MIN 0.0f
 #define WATCHDOG_TIMEOUT 3000 // 3秒
 
-// UI刷新间隔
+// 加热器故障检测 (一阶热模型: dT/dt = (G·u - (T - Tamb)) / τ)
+// 高占空比下实测/预期温升比低于DETACHED_RATIO时视为加热器或传感器故障，二者由电源压降区分:
+// 加热器有电流时分压检测到的电源电压比关断时低 (线路和电源内阻)，开路时不变。
+// 电压无效 (未接分压) 或压降检测关闭时退回按温升比区分: 低于OPEN_RATIO为开路，
+// 因为脱落的传感器仍会经空气和PCB缓慢升温，而开路时只有环境温度的漂移。
+// 从输出进入高占空比到报警: 宽限期 + 确认时间 ≈ 7秒，期间最多多升温 G·u·7/τ ≈ 11℃。
+#define HEATER_MODEL_GAIN 120.0f            // 满占空比稳态温升 (℃)
+#define HEATER_MODEL_TAU 60.0f              // 热时间常数 (秒)
+#define HEATER_MONITOR_INTERVAL 200         // 检测周期 (毫秒)
+#define HEATER_RATE_FILTER_TIME 1.0f        // 温升速率滤波时间常数 (秒)
+#define HEATER_FAULT_HIGH_DUTY 0.8f         // 高占空比判定阈值
+#define HEATER_FAULT_SETTLE_TIME 4000       // 输出变化后的热滞后宽限期 (毫秒)
+#define HEATER_FAULT_CONFIRM_TIME 3000      // 故障持续确认时间 (毫秒)
+#define HEATER_FAULT_STUCK_RATE 0.3f        // 零输出时判定MOS常通的温升速率 (℃/s)
+#define HEATER_FAULT_MIN_EXPECTED_RATE 0.3f // 预期温升速率低于此值时不做判定 (℃/s)
+#define HEATER_FAULT_OPEN_RATIO 0.1f        // 实测/预期温升低于此比例判定加热器开路
+#define HEATER_FAULT_DETACHED_RATIO 0.3f    // 低于此比例判定传感器脱落
+#define HEATER_AMBIENT_STABLE_RATE 0.02f    // 输出关断时温度平稳的判定速率 (℃/s)
+#define HEATER_LOAD_DROOP_MIN 0.1f          // 加热时电源电压至少下降此值才认为有电流 (V，0为不使用)
+
+// FreeRTOS任务配置 (采集+控制与UI分核运行)
+#define CONTROL_TASK_CORE 1         // 控制任务运行核心
+#define CONTROL_TASK_PRIORITY 5     // 控制任务优先级 (高于UI)
+#define CONTROL_TASK_STACK 4096
+#define UI_TASK_CORE 0              // UI/输入/日志任务运行核心
+#define UI_TASK_PRIORITY 2
+#define UI_TASK_STACK 8192
+#define UI_TASK_PERIOD_MS 10        // UI任务轮询周期 (输入响应)
+#define FLUSH_TASK_CORE 0           // OLED刷新任务运行核心 (与UI任务相同)
+#define FLUSH_TASK_PRIORITY 1       // 低于UI任务，总线传输不影响输入响应
+#define FLUSH_TASK_STACK 3072
+#define TELEMETRY_QUEUE_SIZE 16     // 控制->UI遥测队列容量 (2的幂)
+
+// 调度器
+#define SCHEDULER_MAX_JOBS 8            // 每个调度器最多任务数
+#define SCHEDULER_HISTOGRAM_BINS 8      // 启动延迟分布区间数 (按2的幂划分)
+#define CONTROL_PHASE_MS 20             // 控制计算相对温度采样的相位 (等待采样完成)
+#define SUPPLY_PHASE_MS 60              // 电压采样相位 (避开温度采样和控制计算)
+#define STATS_INTERVAL 10000            // 总线/调度统计输出间隔 (毫秒)
+
+// 电源管理 (空闲时自动降频并进入light sleep)
+// 注意: USB CDC串口在light sleep期间会断开，需要连续串口日志时将LIGHT_SLEEP_ENABLED设为0
+#define POWER_MANAGEMENT_ENABLED 1
+#define LIGHT_SLEEP_ENABLED 1
+#define PM_MAX_FREQ_MHZ 240
+#define PM_MIN_FREQ_MHZ 80              // 不低于80MHz，保证APB时钟不变
+#define ADS_READY_PIN 9                 // ADS1115 ALERT/RDY引脚 (转换完成时拉低)
+
+// 性能分析 (开销约几十个时钟周期，可在正式版本中保持开启)
+#define PROFILER_ENABLED 1
+#define PROFILER_HISTOGRAM_BINS 124     // 每个2的幂区间再分4档，覆盖全部32位周期数
+
+// 串口命令
+#define CONSOLE_MAX_COMMANDS 8
+#define CONSOLE_LINE_LENGTH 48
+#define CONSOLE_POLL_INTERVAL 50        // 毫秒
+
+// 现场记录/回放 (ADC原始码、按钮边沿、编码器旋转)
+#define TRACE_BUFFER_SIZE 4096          // 记录条数 (每条8字节)，写满后覆盖最旧记录
+
+// I2C总线仲裁 (ADS1115与SSD1306共用一条总线)
+#define OLED_PAGE_COUNT (SCREEN_HEIGHT / 8)
+#define OLED_CHUNK_SIZE 64              // 每次I2C传输的显示数据字节数 (Wire缓冲区为128字节)
+#define ADS_CONVERSION_TIME_MS 8        // 128SPS单次转换时间
+#define ADS_CONVERSION_TIMEOUT_MS 30    // 转换超时
+
+// UI控件
+#define UI_LABEL_LENGTH 32              // 标签文本最大长度 (含结束符)
+#define UI_LIST_VALUE_LENGTH 8          // 列表行右侧值的最大长度 (含结束符)
+#define NUM_FORMAT_LENGTH 16            // 数值格式化缓冲区大小 (符号+10位数字+小数点+补齐，含结束符)
+#define NUM_FORMAT_MAX_DECIMALS 4       // 浮点数格式化最多小数位数
+#define UI_BENCH_ITERATIONS 100         // page bench 默认每页绘制次数
+#define UI_BENCH_MAX_ITERATIONS 500     // 每页最多绘制次数 (UI任务在测试期间不处理输入)
+
+// 温度趋势 (每个时间尺度一个环形缓冲，每列保存最小/最大值)
+#define TREND_COLUMNS 120               // 每个尺度的列数 (绘图宽度，像素)
+#define TREND_SCALE_COUNT 3             // 时间尺度: 1分钟、10分钟、1小时
+#define TREND_SAMPLES_PER_COLUMN 5      // 1分钟尺度每列的控制周期数 (100ms x 5 = 0.5s)
+#define TREND_SCALE_RATIO_10MIN 10      // 10分钟尺度每列合并的1分钟尺度列数 (5s)
+#define TREND_SCALE_RATIO_1H 6          // 1小时尺度每列合并的10分钟尺度列数 (30s)
+#define TREND_RANGE_STEP 10             // 纵轴范围取整步长 (0.1°C)
+#define TREND_MIN_SPAN 20               // 纵轴最小跨度 (0.1°C)
+
+// astra-ui-lite 前端 (oled-ui-astra-lite-main/Source_code)
+#define ASTRA_FRAME_INTERVAL 20         // astra动画帧周期 (毫秒)，仅在astra前端激活时使用
+#define ASTRA_FONT_WIDTH 6              // GFX内置字体字符宽度 (含间隔)
+#define ASTRA_FONT_ASCENT 7             // 基线以上的高度，astra按u8g2的基线坐标绘制文字
+#define ASTRA_FONT_LINE_HEIGHT 12       // 报告给astra的字高，决定选择框与文字的相对位置
+
+// 调度周期 (由Scheduler按周期运行对应任务)
 #define UI_REFRESH_INTERVAL 100 // 毫秒
 #define TEMP_SAMPLE_INTERVAL 100 // 毫秒
 #define PID_COMPUTE_INTERVAL 100 // 毫秒
+#define TELEMETRY_INTERVAL 1000  // 串口遥测输出间隔 (毫秒)
 
 // EEPROM参数
 #define EEPROM_SIZE 512
@@ -64,6 +183,7 @@
 #define EEPROM_PID_KD_ADDR 8
 #define EEPROM_TARGET_TEMP_ADDR 12
 #define EEPROM_TEMP_CALIBRATION_ADDR 16
+#define EEPROM_ENERGY_LIFETIME_ADDR 20  // double, 8字节 (Wh)
 
 // 错误代码
 enum ErrorCode {
@@ -0,0 +1,63 @@
+#ifndef CONTROL_CHANNEL_H
+#define CONTROL_CHANNEL_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+#include "spsc_ring.h"
+
+// 控制命令 (UI -> 控制任务，位掩码)
+enum ControlCommand {
+    CMD_START = 0x01,   // 开始加热
+    CMD_STOP = 0x02,    // 停止加热
+    CMD_RESET = 0x04,   // 错误复位
+    CMD_SET_TUNINGS = 0x08, // 应用kp/ki/kd
+    CMD_SET_OUTPUT_MODE = 0x10, // 应用burstMode
+    CMD_SET_CALIBRATION = 0x20  // 应用tempOffset
+};
+
+// 遥测帧: 控制任务每个周期发布一帧完整快照
+struct TelemetryFrame {
+    uint32_t timestamp;         // 采样时间 (毫秒)
+    float currentTemp;          // 当前温度
+    float targetTemp;           // 目标温度
+    float supplyVoltage;        // 加热器电源电压 (V)
+    float sessionEnergy;        // 本次加热能耗 (Wh)
+    double lifetimeEnergy;      // 累计能耗 (Wh)，double保证保存到EEPROM时不丢失精度
+    const char* errorMessage;   // 错误信息 (指向静态字符串)
+    uint32_t errorSequence;     // 每产生一次新错误递增，UI据此弹出错误页面
+    uint16_t dutyCycle;         // 实际输出占空比
+    uint8_t powerPercentage;    // 功率百分比
+    uint8_t systemState;        // 系统状态
+    uint8_t errorCode;          // 错误代码
+};
+
+// 控制任务与UI任务之间的无锁通道，双方都不会阻塞
+struct ControlChannel {
+    // UI -> 控制任务
+    std::atomic<uint32_t> commands;         // 待处理命令
+    std::atomic<float> targetTemp;          // 目标温度
+    std::atomic<float> kp;                  // PID参数 (UI编辑后发送CMD_SET_TUNINGS)
+    std::atomic<float> ki;
+    std::atomic<float> kd;
+    std::atomic<bool> burstMode;            // 整周期输出模式 (发送CMD_SET_OUTPUT_MODE)
+    std::atomic<float> tempOffset;          // 温度校准值 (发送CMD_SET_CALIBRATION)
+    
+    // 控制任务 -> UI
+    SpscRing<TelemetryFrame, TELEMETRY_QUEUE_SIZE> telemetry;
+    
+    ControlChannel() : commands(0), targetTemp(TEMP_DEFAULT), kp(0.0f), ki(0.0f), kd(0.0f),
+                       burstMode(false), tempOffset(0.0f) {}
+    
+    // 发送命令 (UI任务)
+    void postCommand(uint32_t command) {
+        commands.fetch_or(command, std::memory_order_release);
+    }
+    
+    // 取出全部待处理命令 (控制任务)
+    uint32_t takeCommands() {
+        return commands.exchange(0, std::memory_order_acquire);
+    }
+};
+
+#endif // CONTROL_CHANNEL_H
@@ -0,0 +1,84 @@
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "temp_sensor.h"
+#include "pid_controller.h"
+#include "pwm_controller.h"
+#include "heater_monitor.h"
+#include "output_map.h"
+#include "control_channel.h"
+#include "trace_recorder.h"
+
+// 控制回路 (控制任务): 采样、处理命令、安全检查、PID计算和PWM输出
+// 固件的控制任务和主机端回放测试调用同一份代码。
+// 记录时除ADC原始码外还记录收到的命令和控制参数 (开始记录时先写入一份参数快照)；
+// 回放期间由记录中的命令和参数代替UI发来的命令和参数，实际输出被抑制，
+// 回放结束后停止加热并恢复控制通道中的参数。
+class ControlLoop {
+private:
+    TempSensor* sensor;
+    PIDController* pid;
+    PWMController* pwm;
+    HeaterMonitor* monitor;
+    OutputMap* outputMap;
+    ControlChannel* channel;
+    TraceRecorder* recorder;        // 现场记录/回放 (可选)
+
+    // 系统状态 (仅由控制任务修改)
+    SystemState state;
+    ErrorCode errorCode;
+    const char* errorMessage;       // 错误信息 (指向静态字符串)
+    uint32_t errorSequence;         // 每产生一次新错误递增
+
+    // 记录
+    bool recordingSynced;           // 本次记录已写入参数快照
+    float recordedTarget;           // 最近记录的目标温度
+
+    // 回放
+    bool replaying;
+    float replayTarget;             // 记录中的目标温度
+    int16_t pendingSetting;         // 已收到低16位的参数记录 (channel)，没有时为-1
+    uint16_t pendingLow;
+
+    // 进入错误状态
+    void raiseError(ErrorCode code, const char* message);
+
+    // 记录本周期收到的命令和参数
+    void recordCommands(uint32_t commands, float targetTemp, unsigned long now);
+
+    // 记录全部控制参数 (开始记录时的快照)
+    void recordSnapshot(float targetTemp, unsigned long now);
+
+    // 取出已到时间的回放命令，参数记录直接生效，返回CMD_START/CMD_STOP/CMD_RESET位掩码
+    uint32_t takeReplayCommands(unsigned long now);
+
+    // 应用一个回放的控制参数
+    void applySetting(uint8_t setting, float value);
+
+    // 回放开始/结束时切换参数来源
+    void beginReplay();
+    void endReplay();
+
+public:
+    ControlLoop(TempSensor* _sensor, PIDController* _pid, PWMController* _pwm,
+                HeaterMonitor* _monitor, OutputMap* _outputMap, ControlChannel* _channel);
+
+    // 记录/回放命令和参数
+    void attachRecorder(TraceRecorder* _recorder);
+
+    // 温度采样 (回放时送入记录的ADC码)
+    void sampleTemperature(unsigned long now);
+
+    // 电源电压采样 (回放时由sampleTemperature一并送入)
+    void sampleSupply();
+
+    // 一个控制周期: 处理命令、安全检查、PID计算、PWM输出，发布遥测帧
+    void step(unsigned long now);
+
+    // 获取系统状态
+    SystemState getState();
+};
+
+#endif // CONTROL_LOOP_H
@@ -0,0 +1,63 @@
+#ifndef HEATER_MONITOR_H
+#define HEATER_MONITOR_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 加热器故障类型
+enum HeaterFault {
+    HEATER_FAULT_NONE = 0,
+    HEATER_FAULT_OPEN,              // 加热器开路 (高占空比无温升)
+    HEATER_FAULT_STUCK_ON,          // MOS管常通 (零输出仍持续升温)
+    HEATER_FAULT_SENSOR_DETACHED    // 传感器脱落 (温升远低于预期)
+};
+
+// 通过比较实测温升与一阶热模型预期温升检测加热器故障
+// 温升不足时再比较加热与关断时的电源电压，有压降 (有电流) 为传感器脱落，无压降为加热器开路
+// 每次更新为常数时间，不保存历史数据
+class HeaterMonitor {
+private:
+    bool initialized;
+    float lastTemp;
+    unsigned long lastUpdateTime;
+    
+    // 模型状态
+    float ambientTemp;          // 环境温度估计
+    float observedRate;         // 实测温升速率 (滤波后, ℃/s)
+    float expectedRate;         // 模型预期温升速率 (滤波后, ℃/s)
+    
+    // 电源电压 (滤波后)，用于判断加热器是否有电流
+    float idleSupply;           // 输出关断时
+    float loadSupply;           // 高占空比时
+    bool idleSupplyValid;
+    bool loadSupplyValid;       // 本次进入高占空比后已有有效采样
+    
+    // 输出区间跟踪 (用于热滞后宽限)
+    float lastDuty;
+    unsigned long dutyChangeTime;
+    
+    // 故障确认
+    HeaterFault suspectFault;
+    unsigned long suspectTime;
+    HeaterFault fault;
+    
+    // 温升远低于预期时区分加热器开路和传感器脱落
+    HeaterFault classifyNoResponse(float ratio, bool supplyValid);
+    
+public:
+    HeaterMonitor();
+    
+    // 重置检测状态 (清除错误后调用)
+    void reset();
+    
+    // 更新检测 (duty为实际输出占空比 0.0-1.0，supplyVoltage为加热器电源电压)，检测到故障时返回true
+    bool update(float temp, float duty, float supplyVoltage, unsigned long now);
+    
+    // 获取故障类型
+    HeaterFault getFault();
+    
+    // 获取故障描述
+    const char* getFaultMessage();
+};
+
+#endif // HEATER_MONITOR_H
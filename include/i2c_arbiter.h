@@ -0,0 +1,63 @@
+#ifndef I2C_ARBITER_H
+#define I2C_ARBITER_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+
+// 总线客户端，编号越小优先级越高
+enum I2CClient {
+    I2C_CLIENT_SENSOR = 0,      // ADS1115温度/电压采样
+    I2C_CLIENT_DISPLAY,         // SSD1306显示刷新
+    I2C_CLIENT_COUNT
+};
+
+// 单个客户端的总线统计
+struct I2CClientStats {
+    uint32_t transactions;      // 占用次数
+    uint64_t busyTime;          // 累计占用时间 (微秒)
+    uint64_t waitTime;          // 累计等待时间 (微秒)
+    uint32_t maxWait;           // 最长等待时间 (微秒)
+};
+
+// I2C总线仲裁器
+// 客户端每次事务前后调用acquire/release。传感器有等待时，显示客户端
+// 不会再取得总线，因此长传输按页拆分后传感器最多只需等待一页的时间。
+class I2CArbiter {
+private:
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t sensorDone;                  // 传感器事务结束 (二值信号量，显示客户端在其上阻塞)
+    std::atomic<uint32_t> highPriorityWaiting;     // 正在等待的传感器事务数
+    I2CClientStats stats[I2C_CLIENT_COUNT];
+    unsigned long holdStartTime[I2C_CLIENT_COUNT]; // 本次占用开始时间 (微秒)
+    unsigned long statsStartTime;                  // 统计窗口开始时间 (毫秒)
+
+public:
+    I2CArbiter();
+    
+    // 初始化仲裁器 (在Wire.begin之后、任务启动之前调用)
+    bool begin();
+    
+    // 占用总线，必要时阻塞等待
+    void acquire(I2CClient client);
+    
+    // 释放总线
+    void release(I2CClient client);
+    
+    // 获取统计窗口内的总线利用率 (%)
+    float getUtilization();
+    
+    // 获取统计窗口内某个客户端的总线占用率 (%)
+    float getClientUtilization(I2CClient client);
+    
+    // 获取某个客户端的最长等待时间 (微秒)
+    uint32_t getWorstWait(I2CClient client);
+    
+    // 清零统计并开始新的统计窗口
+    void resetStats();
+    
+    // 串口输出统计: I2C,总利用率,传感器占用率,传感器最长等待,显示占用率,显示最长等待
+    void printStats();
+};
+
+#endif // I2C_ARBITER_H
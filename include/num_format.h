@@ -0,0 +1,59 @@
+#ifndef NUM_FORMAT_H
+#define NUM_FORMAT_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 无分配的数值格式化
+// 数值先按显示精度量化为定点整数 (放大10^decimals)，再只用整数除法逐位生成文本，
+// 写入调用者栈上的缓冲区；不经过printf/Print::print(float)，不使用堆。
+// 以下函数的out至少为NUM_FORMAT_LENGTH字节，width大于文本长度时左侧补空格右对齐。
+
+// 定点数转文本 (253, 1 -> "25.3")，返回文本长度
+uint8_t formatFixed(char* out, int32_t value, uint8_t decimals, uint8_t width = 0);
+
+// 整数转文本
+uint8_t formatInt(char* out, int32_t value, uint8_t width = 0);
+
+// 无符号整数转文本 (微秒、运行时间等)
+uint8_t formatUnsigned(char* out, uint32_t value, uint8_t width = 0);
+
+// 浮点数四舍五入到decimals位后转文本 (最多NUM_FORMAT_MAX_DECIMALS位)
+// 按float的实际值取整，恰好为.5时远离0；结果为0时不输出负号 (Print::print对-0.04输出"-0.0")
+uint8_t formatFloat(char* out, float value, uint8_t decimals, uint8_t width = 0);
+
+// 浮点数按decimals位小数量化为定点整数，控件据此判断显示内容是否变化
+// 放大后的幅值小于2^23时结果为正确舍入 (主机端测试test_num_format)
+int32_t toFixed(float value, uint8_t decimals);
+
+// 在调用者的缓冲区中拼接一行文本，超出容量时截断，始终以'\0'结尾
+class TextBuilder {
+private:
+    char* buffer;
+    uint8_t capacity;       // 缓冲区大小 (含结束符)
+    uint8_t length;
+
+    // 追加count个字符
+    void append(const char* text, uint8_t count);
+
+public:
+    TextBuilder(char* _buffer, uint8_t _capacity);
+
+    // 追加字符串
+    TextBuilder& text(const char* str);
+
+    // 追加定点数/浮点数/整数 (右对齐到width)
+    TextBuilder& fixed(int32_t value, uint8_t decimals, uint8_t width = 0);
+    TextBuilder& decimal(float value, uint8_t decimals, uint8_t width = 0);
+    TextBuilder& integer(int32_t value, uint8_t width = 0);
+    TextBuilder& unsignedInteger(uint32_t value, uint8_t width = 0);
+
+    // 用空格补齐到第column个字符 (左对齐的列)
+    TextBuilder& pad(uint8_t column);
+
+    // 拼接结果
+    const char* c_str();
+    uint8_t size();
+};
+
+#endif // NUM_FORMAT_H
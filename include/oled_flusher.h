@@ -0,0 +1,94 @@
+#ifndef OLED_FLUSHER_H
+#define OLED_FLUSHER_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include "config.h"
+#include "i2c_arbiter.h"
+#include <atomic>
+
+// 按页把SSD1306帧缓冲发送到屏幕
+// 每页单独占用总线，页与页之间传感器事务可以插入，
+// 代替一次占用总线约25ms的Adafruit_SSD1306::display()。
+// 保留上一次发送的帧，每页只发送有变化的列区间，未变化的页不占用总线。
+// 双缓冲: UI在Adafruit帧缓冲 (后台缓冲) 中绘制，submit()把完成的一帧复制到前台缓冲，
+// 由刷新任务在后台发送；传输期间UI继续在后台缓冲中绘制，但不接受提交，
+// 前台缓冲只在传输完成后更新，画面不会撕裂。
+// submitArea()只发送指定窗口覆盖的页和列，窗口外即使有变化也保留到下一次整屏提交。
+class OledFlusher {
+private:
+    Adafruit_SSD1306* display;  // 显示屏指针 (提供帧缓冲)
+    TwoWire* wire;              // I2C总线
+    I2CArbiter* arbiter;        // 总线仲裁器
+    uint8_t address;            // 显示屏I2C地址
+    
+    // 前台缓冲: 刷新任务正在发送的帧
+    uint8_t front[SCREEN_WIDTH * OLED_PAGE_COUNT];
+    TaskHandle_t task;          // 刷新任务 (未启动时flush()同步发送)
+    std::atomic<bool> busy;     // 前台缓冲正在传输
+    
+    // 本次传输的窗口 (页和列，含两端)
+    uint8_t firstPage;
+    uint8_t lastPage;
+    uint8_t firstColumn;
+    uint8_t lastColumn;
+    
+    // 屏幕上当前的内容 (最近一次发送的帧)
+    uint8_t shadow[SCREEN_WIDTH * OLED_PAGE_COUNT];
+    bool shadowValid;           // 屏幕内容是否与shadow一致
+    
+    // 统计
+    uint32_t frameCount;        // flush次数
+    uint32_t pageCount;         // 实际发送的页数
+    uint32_t byteCount;         // 实际发送的显示数据字节数
+    uint32_t busyCount;         // 传输未完成而被推迟的提交次数
+    uint32_t errorCount;        // 发送失败 (I2C无应答等) 的页数
+    uint32_t lastTransferTime;  // 最近一次传输的耗时 (微秒，含等待总线)
+    
+    // 发送一页 (8行) 中 [firstColumn, lastColumn] 列的数据，任一次I2C事务失败时返回false
+    bool sendWindow(const uint8_t* buffer, uint8_t page, uint8_t firstColumn, uint8_t lastColumn);
+    
+    // 把一帧中窗口内变化的部分发送到屏幕，有页发送失败时下一帧整屏重发
+    void transfer(const uint8_t* buffer);
+    
+    // 设置传输窗口 (像素坐标)，窗口与屏幕没有交集时返回false
+    bool setWindow(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    // 刷新任务: 等待submit()的通知后发送前台缓冲
+    static void flushTask(void* param);
+
+public:
+    OledFlusher(Adafruit_SSD1306* _display, TwoWire* _wire, I2CArbiter* _arbiter, uint8_t _address);
+    
+    // 启动后台刷新任务
+    bool begin();
+    
+    // 提交帧缓冲中绘制完成的一帧，不阻塞
+    // 上一帧仍在传输时返回false，帧缓冲不受影响，调用者在isBusy()变为false后重新提交
+    bool submit();
+    
+    // 只提交帧缓冲中 (x, y, w, h) 窗口的内容，按页对齐，不阻塞
+    // 与submit()相同，上一帧仍在传输时返回false
+    bool submitArea(int16_t x, int16_t y, int16_t w, int16_t h);
+    
+    // 上一帧是否仍在传输
+    bool isBusy();
+    
+    // 最近一次完成的传输耗时 (微秒)，在isBusy()为false时读取
+    uint32_t getLastTransferTime();
+    
+    // 同步把帧缓冲中变化的部分刷新到屏幕 (启动画面等任务启动前的场合)
+    void flush();
+    
+    // 屏幕内容被其他途径改写 (如初始化、display())，下一次flush发送整屏
+    void invalidate();
+    
+    // 串口输出统计: OLED,帧数,发送页数,发送字节数,平均每帧字节数,忙时推迟提交次数,发送失败页数
+    void printStats();
+    
+    // 清零统计
+    void resetStats();
+};
+
+#endif // OLED_FLUSHER_H
@@ -0,0 +1,42 @@
+#ifndef OUTPUT_MAP_H
+#define OUTPUT_MAP_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// PTC输出线性化
+// PTC电阻随温度急剧上升，相同占空比在不同温度下的实际功率差异很大。
+// 表中记录各温度下占空比对应的有效功率 (以冷态满功率为1023)，
+// PID输出作为功率指令，经查表反插值得到实际占空比，使回路增益与温度无关。
+// 表为固定的默认表 (不提供标定接口)，热态下可达到的最大功率低于1023，
+// PID的输出和积分上限需按maxPower()随温度调整。
+class OutputMap {
+private:
+    bool enabled;
+    
+    // 有效功率表 [温度节点][占空比节点]，每行需单调递增
+    uint16_t powerTable[OUTPUT_MAP_TEMP_POINTS][OUTPUT_MAP_DUTY_POINTS];
+    
+    // 定位温度所在的表行及行间插值系数
+    void locateTemp(float temp, uint8_t* row, float* frac);
+    
+public:
+    OutputMap();
+    
+    // 恢复默认表
+    void loadDefaults();
+    
+    // 当前温度下满占空比对应的有效功率 (功率指令的可达上限)
+    float maxPower(float temp);
+    
+    // 功率指令 (0-1023) 转换为占空比 (0-1023)
+    uint16_t powerToDuty(double power, float temp);
+    
+    // 启用/禁用线性化 (禁用时功率指令直接作为占空比)
+    void setEnabled(bool enable);
+    
+    // 是否启用
+    bool isEnabled();
+};
+
+#endif // OUTPUT_MAP_H
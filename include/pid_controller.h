@@ -2,27 +2,30 @@
 #define PID_CONTROLLER_H
 
 #include <Arduino.h>
-#include <PID_v1.h>
 #include "config.h"
 
+// PID控制器 (比例/积分按误差，微分按测量值，积分限幅在输出范围内，上限可随执行器能力调整)
+// 计算时机由调度器决定，积分和微分项按两次计算之间的实际间隔缩放，参数本身不随间隔改变
 class PIDController {
 private:
     double input;        // 当前温度
     double output;       // 控制输出 (PWM占空比)
     double setpoint;     // 设定温度
+    double outputLimit;  // 输出和积分上限 (不超过PID_OUTPUT_MAX)
     
-    // PID参数
+    // PID参数 (ki: 1/秒, kd: 秒)
     double kp, ki, kd;
     
-    // PID控制器
-    PID* pid;
+    // 计算状态
+    double integral;     // 积分项 (已乘ki)
+    double lastInput;    // 上次计算时的输入
+    bool running;        // 是否已有上次计算
     
     // 最后一次计算时间
     unsigned long lastCompute;
     
 public:
     PIDController();
-    ~PIDController();
     
     // 初始化PID控制器
     bool begin();
@@ -39,7 +42,10 @@ public:
     // 获取控制输出
     double getOutput();
     
-    // 计算PID输出
+    // 设置输出和积分上限 (执行器在当前工况下可达到的最大输出，避免积分饱和)
+    void setOutputLimit(double limit);
+    
+    // 计算PID输出 (由调度器按PID_COMPUTE_INTERVAL周期调用)
     bool compute();
     
     // 设置PID参数
@@ -0,0 +1,45 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include "config.h"
+#include "scheduler.h"
+
+// 电源管理
+// 两个任务都由调度器休眠到下一个释放时间，空闲时FreeRTOS无节拍空闲自动进入light sleep，
+// 由定时器、编码器/按钮GPIO或ADS1115 RDY唤醒。加热器工作时LEDC需要APB时钟，
+// 持有电源锁禁止降频和light sleep。
+//
+// GPIO唤醒只支持电平触发，且与该引脚的中断共用触发类型，不能加在边沿中断的引脚上
+// (电平保持期间会反复进入中断)。按钮和编码器引脚因此改为"与当前电平相反的电平"触发，
+// 每次中断中立即改为等待下一次跳变 (armInputWake)，效果等同双边沿中断，同时始终可以唤醒。
+class PowerManager {
+private:
+    bool initialized;
+    bool lightSleepEnabled;         // light sleep是否配置成功
+    esp_pm_lock_handle_t heaterLock;
+    bool heaterLockHeld;
+
+public:
+    PowerManager();
+    
+    // 配置动态调频和自动light sleep，不支持light sleep时只启用动态调频
+    bool begin();
+    
+    // 输入引脚改为在当前电平的反相触发中断并唤醒 (在该引脚的中断处理中调用)，
+    // light sleep未启用时不做修改，保持原来的边沿中断
+    static void IRAM_ATTR armInputWake(uint8_t pin);
+    
+    // 加热器工作状态变化时调用，工作期间禁止降频和light sleep
+    void setHeaterActive(bool active);
+    
+    // light sleep是否启用
+    bool isLightSleepEnabled();
+    
+    // 串口输出调度器忙碌比例: PWR,light sleep,控制任务忙碌%,UI任务忙碌%
+    // (任务执行时间占比，不是实测的light sleep驻留时间：其余时间可能空闲但未进入睡眠)
+    void printStats(Scheduler* controlScheduler, Scheduler* uiScheduler);
+};
+
+#endif // POWER_MANAGER_H
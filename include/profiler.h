@@ -0,0 +1,110 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 性能分析区段
+enum ProfileZone {
+    PROF_ZONE_ADC_READ = 0,     // ADS1115读取转换结果
+    PROF_ZONE_VOLTAGE_TO_TEMP,  // 电压换算温度
+    PROF_ZONE_PID_COMPUTE,      // PID计算
+    PROF_ZONE_HANDLE_INPUT,     // UI输入处理
+    PROF_ZONE_DRAW,             // 页面绘制
+    PROF_ZONE_FLUSH,            // 显示刷新
+    PROF_ZONE_COUNT
+};
+
+// 单个区段的统计 (单位: CPU时钟周期)
+struct ProfileZoneStats {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[PROFILER_HISTOGRAM_BINS];
+};
+
+// 基于Xtensa周期计数器的区段性能统计
+// 每个区段只由一个任务写入，记录为常数时间，无锁。
+class Profiler {
+private:
+    ProfileZoneStats zones[PROF_ZONE_COUNT];
+    
+    // 周期数对应的直方图区间
+    static inline uint8_t binOf(uint32_t cycles) {
+        if (cycles < 4) {
+            return cycles;
+        }
+        uint8_t msb = 31 - __builtin_clz(cycles);
+        return 4 * (msb - 1) + ((cycles >> (msb - 2)) & 3);
+    }
+    
+    // 直方图区间的下界
+    static uint32_t binLowerBound(uint8_t bin);
+
+public:
+    Profiler();
+    
+    // 记录一次区段耗时
+    inline void record(ProfileZone zone, uint32_t cycles) {
+        ProfileZoneStats& stats = zones[zone];
+        stats.count++;
+        stats.total += cycles;
+        if (cycles < stats.min) {
+            stats.min = cycles;
+        }
+        if (cycles > stats.max) {
+            stats.max = cycles;
+        }
+        stats.histogram[binOf(cycles)]++;
+    }
+    
+    // 清零全部统计
+    void reset();
+    
+    // 获取区段名称
+    const char* getZoneName(ProfileZone zone);
+    
+    // 获取统计值 (周期数)
+    uint32_t getCount(ProfileZone zone);
+    uint32_t getMin(ProfileZone zone);
+    uint32_t getMax(ProfileZone zone);
+    uint32_t getMean(ProfileZone zone);
+    
+    // 获取百分位数 (千分比，如990为p99)，返回所在直方图区间的上界
+    uint32_t getPercentile(ProfileZone zone, uint16_t permille);
+    
+    // 周期数换算为微秒 (按当前CPU频率)
+    uint32_t cyclesToMicros(uint32_t cycles);
+    
+    // 串口输出统计，每个区段一行:
+    // PROF,区段,次数,最小,平均,p99,最大 (周期),平均us,p99us,最大us
+    void printStats();
+};
+
+extern Profiler profiler;
+
+// 作用域计时: 构造时读取周期计数器，析构时记录
+class ProfileScope {
+private:
+    ProfileZone zone;
+    uint32_t start;
+
+public:
+    inline ProfileScope(ProfileZone _zone) : zone(_zone), start(ESP.getCycleCount()) {}
+    inline ~ProfileScope() {
+        profiler.record(zone, ESP.getCycleCount() - start);
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// 统计当前作用域的耗时
+#if PROFILER_ENABLED
+#define PROFILE_ZONE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#else
+#define PROFILE_ZONE(zone)
+#endif
+
+#endif // PROFILER_H
@@ -4,11 +4,48 @@
 #include <Arduino.h>
 #include "config.h"
 
+// 输出模式
+enum PWMMode {
+    PWM_MODE_CONTINUOUS = 0,  // 20kHz连续PWM
+    PWM_MODE_BURST            // 整周期通断 (低频)
+};
+
 class PWMController {
 private:
     bool initialized;
-    uint16_t dutyCycle;   // 占空比 (0-1023)
+    uint16_t dutyCycle;   // 请求占空比 (0-1023)，电压补偿模式下表示额定电压下的功率指令
+    uint16_t outputDuty;  // 实际输出占空比 (经电压补偿后)
     bool enabled;         // 是否启用输出
+    volatile bool inhibited; // 输出抑制 (回放时控制逻辑照常运行，但不实际加热)
+    
+    // 电压补偿
+    bool compensationEnabled;
+    float supplyVoltage;  // 最近测得的加热器电源电压
+    
+    // 整周期输出模式
+    volatile PWMMode mode;
+    hw_timer_t* burstTimer;
+    uint16_t burstWindowMs;     // 窗口长度 (毫秒)
+    uint32_t burstAccumulator;  // Bresenham误差累加器
+    portMUX_TYPE burstMux;      // 保护与定时器中断共享的输出状态
+    
+    // 能耗统计 (微焦耳 / 满功率等效微秒)
+    uint64_t sessionEnergy;     // 本次加热能耗
+    uint64_t lifetimeEnergy;    // 累计能耗
+    uint64_t sessionDutyTime;   // 本次加热的占空比×时间
+    unsigned long lastAccountTime; // 上次累计时间 (微秒)
+    
+    // 根据请求占空比和电源电压计算实际输出
+    void applyOutput();
+    
+    // 将上次累计以来的输出能量计入统计 (在输出变化前调用)
+    void accumulateEnergy();
+    
+    // 整周期模式下每个窗口执行一次 (定时器中断上下文)
+    void IRAM_ATTR burstStep();
+    
+    // 直接写LEDC占空比寄存器并更新 (IRAM，可在中断和临界区中调用)
+    static void IRAM_ATTR writeDuty(uint32_t duty);
     
 public:
     PWMController();
@@ -22,9 +59,51 @@ public:
     // 获取当前占空比
     uint16_t getDutyCycle();
     
+    // 获取实际输出占空比
+    uint16_t getOutputDutyCycle();
+    
     // 获取当前功率百分比
     uint8_t getPowerPercentage();
     
+    // 更新加热器电源电压 (每个采样周期调用)
+    void setSupplyVoltage(float voltage);
+    
+    // 获取加热器电源电压
+    float getSupplyVoltage();
+    
+    // 启用/禁用电压补偿 (恒功率输出)
+    void setVoltageCompensation(bool enable);
+    
+    // 是否启用电压补偿
+    bool isVoltageCompensationEnabled();
+    
+    // 设置输出抑制: 抑制期间引脚保持低电平，不计能耗
+    void setOutputInhibit(bool inhibit);
+    
+    // 是否处于输出抑制
+    bool isOutputInhibited();
+    
+    // 获取本次加热能耗 (Wh)
+    float getSessionEnergy();
+    
+    // 获取本次加热的满功率等效时间 (秒)
+    float getSessionDutySeconds();
+    
+    // 获取累计能耗 (Wh)
+    double getLifetimeEnergy();
+    
+    // 设置累计能耗 (Wh, 从EEPROM恢复)
+    void setLifetimeEnergy(double wh);
+    
+    // 设置输出模式 (运行时切换，在窗口边界生效，无需重新初始化LEDC)
+    void setOutputMode(PWMMode newMode);
+    
+    // 获取输出模式
+    PWMMode getOutputMode();
+    
+    // 获取整周期模式窗口长度 (毫秒，由BURST_WINDOW_MS配置)
+    uint16_t getBurstWindow();
+    
     // 启用PWM输出
     void enable();
     
@@ -34,8 +113,11 @@ public:
     // 是否已启用
     bool isEnabled();
     
-    // 紧急停止 (立即断开输出)
+    // 紧急停止 (立即断开输出)，输出已停止时可重复调用，只在实际停止时输出日志
     void emergencyStop();
+    
+    // 整周期模式定时器中断处理
+    static void IRAM_ATTR burstTimerInterrupt();
 };
 
-#endif // PWM_CONTROLLER_H 
\ No newline at end of file
+#endif // PWM_CONTROLLER_H
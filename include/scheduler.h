@@ -0,0 +1,79 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 任务函数，context为注册时传入的对象指针
+typedef void (*SchedulerJobFunction)(void* context);
+
+// 周期任务及其运行统计
+struct SchedulerJob {
+    const char* name;               // 任务名 (用于统计输出)
+    SchedulerJobFunction function;  // 任务函数
+    void* context;                  // 任务函数参数
+    uint32_t period;                // 周期 (毫秒)
+    uint32_t deadline;              // 截止期限，相对释放时间 (毫秒)
+    uint8_t priority;               // 优先级，数值越大越先运行
+    uint32_t nextRelease;           // 下次释放时间 (毫秒)
+    
+    // 统计
+    uint32_t runs;                  // 运行次数
+    uint32_t overruns;              // 超过截止期限完成的次数
+    uint32_t skipped;               // 因延迟超过一个周期而跳过的次数
+    uint32_t maxLateness;           // 最大启动延迟 (毫秒)
+    uint32_t maxExecTime;           // 最长执行时间 (微秒)
+    uint32_t latenessHistogram[SCHEDULER_HISTOGRAM_BINS]; // 启动延迟分布: 0, 1, 2-3, 4-7 ... 毫秒
+};
+
+// 协作式周期任务调度器
+// 每个FreeRTOS任务一个实例。到期任务按优先级依次运行，
+// 没有到期任务时休眠到最近的释放时间，不再由各模块自行轮询millis()。
+class Scheduler {
+private:
+    const char* name;
+    SchedulerJob jobs[SCHEDULER_MAX_JOBS];
+    uint8_t jobCount;
+    bool started;
+    unsigned long startTime;        // 统计开始时间 (毫秒)
+    uint64_t busyTime;              // 累计执行时间 (微秒)
+    
+    // 选出已到期且优先级最高的任务，没有则返回nullptr
+    SchedulerJob* selectDue(unsigned long now);
+    
+    // 运行一个任务并更新统计
+    void runJob(SchedulerJob* job, unsigned long now);
+
+public:
+    Scheduler(const char* _name);
+    
+    // 注册周期任务 (start之前调用)，返回任务编号，失败返回-1
+    // phase为首次释放相对start的偏移，用于错开同周期的任务
+    int8_t addJob(const char* jobName, SchedulerJobFunction function, void* context,
+                  uint32_t period, uint32_t phase, uint8_t priority, uint32_t deadline);
+    
+    // 修改任务周期和截止期限，从该任务下一次释放后生效 (在同一调度器的任务中调用)
+    void setPeriod(int8_t index, uint32_t period, uint32_t deadline);
+    
+    // 以当前时间为基准释放所有任务
+    void start();
+    
+    // 运行所有已到期任务，返回距下一次释放的毫秒数
+    uint32_t runDue();
+    
+    // 调度循环，不返回 (在FreeRTOS任务中调用)
+    void run();
+    
+    // 获取任务数量和统计
+    uint8_t getJobCount();
+    const SchedulerJob* getJob(uint8_t index);
+    
+    // 获取CPU占用率 (%)
+    float getLoad();
+    
+    // 串口输出统计，每个任务一行:
+    // SCH,调度器,任务,运行次数,超期次数,跳过次数,最大延迟ms,最长执行us,延迟分布...
+    void printStats();
+};
+
+#endif // SCHEDULER_H
@@ -0,0 +1,38 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 命令处理函数，args为命令名之后的参数 (可能为空字符串)
+typedef void (*ConsoleHandler)(const char* args);
+
+// 串口命令
+struct ConsoleCommand {
+    const char* name;           // 命令名
+    const char* help;           // 帮助说明
+    ConsoleHandler handler;     // 处理函数
+};
+
+// 串口命令行: 按行读取串口输入并分发到注册的命令，"help"列出全部命令
+class SerialConsole {
+private:
+    ConsoleCommand commands[CONSOLE_MAX_COMMANDS];
+    uint8_t commandCount;
+    char line[CONSOLE_LINE_LENGTH];
+    uint8_t lineLength;
+    
+    // 执行一行命令
+    void execute();
+
+public:
+    SerialConsole();
+    
+    // 注册命令
+    bool addCommand(const char* name, const char* help, ConsoleHandler handler);
+    
+    // 读取串口输入，收到完整一行后执行 (由调度器周期调用，不阻塞)
+    void poll();
+};
+
+#endif // SERIAL_CONSOLE_H
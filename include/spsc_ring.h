@@ -0,0 +1,65 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+// 单生产者/单消费者无锁环形缓冲区
+// push和pop均为常数时间、无等待、不分配内存，可在任务或中断上下文中使用
+// (同一实例只能有一个生产者和一个消费者)。缓冲区满时丢弃新数据并计数。
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing容量必须为2的幂");
+    
+private:
+    T buffer[N];
+    std::atomic<uint32_t> head;     // 下一个写入位置 (仅生产者修改)
+    std::atomic<uint32_t> tail;     // 下一个读取位置 (仅消费者修改)
+    std::atomic<uint32_t> dropped;  // 因缓冲区满丢弃的数量 (仅生产者修改)
+    
+public:
+    SpscRing() : head(0), tail(0), dropped(0) {}
+    
+    // 写入一项 (生产者)，缓冲区满时返回false
+    // 强制内联，IRAM中断函数调用时代码随调用者放入IRAM
+    inline __attribute__((always_inline)) bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        buffer[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // 读出一项 (消费者)，缓冲区空时返回false
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        
+        item = buffer[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // 当前缓冲的数量 (近似值，仅供统计)
+    uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    
+    // 是否为空 (消费者)
+    bool empty() const {
+        return size() == 0;
+    }
+    
+    // 获取丢弃计数
+    uint32_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // SPSC_RING_H
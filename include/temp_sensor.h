@@ -4,22 +4,34 @@
 #include <Arduino.h>
 #include <Adafruit_ADS1X15.h>
 #include "config.h"
+#include "i2c_arbiter.h"
+#include "trace_recorder.h"
 
 class TempSensor {
 private:
     Adafruit_ADS1115 ads;
+    I2CArbiter* arbiter;    // 总线仲裁器 (可选)
+    int8_t readyPin;        // ALERT/RDY引脚 (可选，-1为未使用)
+    TraceRecorder* recorder; // 现场记录 (可选)
     bool initialized;
     float lastTemp;
     float tempOffset;       // 温度校准偏移
     float tempBuffer[10];   // 用于滤波的缓冲区
     uint8_t bufferIndex;
-    unsigned long lastSampleTime;
+    float lastSupplyVoltage;        // 最近一次的加热器电源电压
 
     // 将ADS1115的电压值转换为NTC温度
     float voltageToTemp(float voltage);
     
     // 移动平均滤波
     float applyFilter(float newTemp);
+    
+    // 单次转换读取一个通道，转换期间不占用总线
+    bool readChannel(uint8_t channel, int16_t& code);
+    
+    // 占用/释放总线
+    void lockBus();
+    void unlockBus();
 
 public:
     TempSensor();
@@ -27,9 +39,33 @@ public:
     // 初始化温度传感器
     bool begin();
     
-    // 读取当前温度
+    // 接入总线仲裁器，之后所有ADS1115访问都经过仲裁
+    void attachBus(I2CArbiter* _arbiter);
+    
+    // 使用ALERT/RDY引脚等待转换完成，等待期间CPU可以进入light sleep
+    void attachReadyPin(int8_t pin);
+    
+    // 记录每次转换的原始码
+    void attachRecorder(TraceRecorder* _recorder);
+    
+    // 处理一个NTC通道原始码 (采样或回放)
+    void processRawCode(int16_t code);
+    
+    // 处理一个电源通道原始码 (采样或回放)
+    void processSupplyCode(int16_t code);
+    
+    // 采样一次温度并更新滤波结果 (由调度器按TEMP_SAMPLE_INTERVAL调用)
+    bool sample();
+    
+    // 采样一次加热器电源电压 (由调度器按SUPPLY_SAMPLE_INTERVAL调用)
+    bool sampleSupplyVoltage();
+    
+    // 读取最近一次滤波后的温度
     float readTemperature();
     
+    // 读取最近一次的加热器电源电压 (V)
+    float readSupplyVoltage();
+    
     // 设置温度校准偏移
     void setCalibration(float offset);
     
@@ -0,0 +1,53 @@
+#ifndef TEMP_TREND_H
+#define TEMP_TREND_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 趋势图的一列: 该列时间段内的最低和最高温度 (0.1°C)
+struct TrendColumn {
+    int16_t minValue;
+    int16_t maxValue;           // minValue > maxValue 为空列
+};
+
+// 温度趋势记录
+// 每个时间尺度保存最近TREND_COLUMNS列，每列为一段时间内的最小/最大值包络。
+// 采样先合并进1分钟尺度的当前列，列完成时再合并进10分钟尺度的当前列，以此类推，
+// 每个采样的处理时间为常数，不需要保存原始采样或重新计算历史。
+class TempTrend {
+private:
+    TrendColumn columns[TREND_SCALE_COUNT][TREND_COLUMNS];
+    TrendColumn pending[TREND_SCALE_COUNT];     // 正在累积的列
+    uint8_t pendingCount[TREND_SCALE_COUNT];    // 当前列已合并的采样数/下级列数
+    uint8_t head[TREND_SCALE_COUNT];            // 下一列的写入位置
+    uint32_t columnCount[TREND_SCALE_COUNT];    // 已完成的列数 (单调递增)
+
+    // 当前列合并一个采样或下级列
+    static void merge(TrendColumn& column, int16_t minValue, int16_t maxValue);
+
+    // 写入一列完成的数据，并合并到上一级尺度
+    void push(uint8_t scale, const TrendColumn& column);
+
+public:
+    TempTrend();
+
+    // 清除全部记录
+    void clear();
+
+    // 添加一个采样 (每个控制周期一次)
+    void addSample(float temperature);
+
+    // 尺度已完成的列数，绘图据此判断需要滚动几列
+    uint32_t getColumnCount(uint8_t scale);
+
+    // 读取一列，age为0是最新完成的列；尚无数据时返回空列
+    TrendColumn getColumn(uint8_t scale, uint16_t age);
+
+    // 尺度内全部已保存列的最低/最高温度 (0.1°C)，没有数据时返回false
+    bool getRange(uint8_t scale, int16_t* minValue, int16_t* maxValue);
+
+    // 尺度名称
+    static const char* getScaleName(uint8_t scale);
+};
+
+#endif // TEMP_TREND_H
@@ -0,0 +1,110 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// 记录类型
+enum TraceType {
+    TRACE_ADC = 1,          // ADS1115原始码 (channel为通道)
+    TRACE_BUTTON,           // 按钮边沿 (value为引脚电平)
+    TRACE_ROTATION,         // 编码器旋转 (value为带符号格数)
+    TRACE_COMMAND,          // 控制任务收到的命令 (value为CMD_START/CMD_STOP/CMD_RESET位掩码)
+    TRACE_SETTING           // 控制参数 (channel为参数编号×2+半字序号，value为float的低/高16位)
+};
+
+// 控制参数编号 (TRACE_SETTING)
+enum TraceSetting {
+    TRACE_SETTING_TARGET = 0,   // 目标温度
+    TRACE_SETTING_KP,           // PID参数
+    TRACE_SETTING_KI,
+    TRACE_SETTING_KD,
+    TRACE_SETTING_OUTPUT_MODE,  // 输出模式 (0连续，1整周期)
+    TRACE_SETTING_CALIBRATION,  // 温度校准值
+    TRACE_SETTING_COUNT
+};
+
+// 回放消费者，各自按顺序读取属于自己的记录
+enum TraceSource {
+    TRACE_SOURCE_SENSOR = 0,    // 采样任务: ADC
+    TRACE_SOURCE_INPUT,         // UI任务: 按钮和编码器
+    TRACE_SOURCE_CONTROL,       // 控制任务: 命令和控制参数
+    TRACE_SOURCE_COUNT
+};
+
+// 一条记录 (8字节)
+struct TraceRecord {
+    uint32_t timestamp;     // 时间 (毫秒)
+    uint8_t type;           // TraceType
+    uint8_t channel;        // ADC通道 / 参数编号
+    int16_t value;          // ADC原始码 / 按钮电平 / 旋转格数 / 命令 / 参数的半个float
+};
+
+// 现场数据记录与回放
+// 记录模式下采集全部原始ADC码、输入事件以及控制任务收到的命令和参数，缓冲区写满后覆盖最旧记录；
+// 回放模式下按原始时间间隔把记录重新送入TempSensor、UserInput和ControlLoop。
+// 回放时钟由调用者传入: 目标上为millis()，主机端测试用虚拟时钟逐步推进，结果可重复。
+class TraceRecorder {
+private:
+    enum TraceMode {
+        TRACE_MODE_IDLE = 0,
+        TRACE_MODE_RECORDING,
+        TRACE_MODE_REPLAYING
+    };
+    
+    TraceRecord buffer[TRACE_BUFFER_SIZE];
+    uint16_t head;                          // 下一条写入位置
+    uint16_t count;                         // 有效记录数
+    volatile TraceMode mode;
+    uint32_t replayStartTime;               // 回放开始时间 (毫秒)
+    uint32_t firstTimestamp;                // 最旧记录的时间
+    uint16_t replayCursor[TRACE_SOURCE_COUNT]; // 各消费者的读取位置 (相对最旧记录)
+    portMUX_TYPE mux;                       // 保护多任务写入
+    
+    // 按从旧到新的序号访问记录
+    const TraceRecord& at(uint16_t index);
+    
+    // 记录所属的消费者
+    static TraceSource sourceOf(uint8_t type);
+
+public:
+    TraceRecorder();
+    
+    // 清空缓冲区并开始记录
+    void startRecording();
+    
+    // 停止记录或回放
+    void stop();
+    
+    // 清空缓冲区
+    void clear();
+    
+    // 开始回放缓冲区中的记录，now为回放时钟的当前时间 (毫秒)
+    bool startReplay(uint32_t now);
+    
+    // 追加一条记录 (记录模式下由各模块调用)
+    void record(TraceType type, uint8_t channel, int16_t value, uint32_t timestamp);
+    
+    // 追加一个控制参数 (两条记录: 低16位在前，float按位保存，回放时数值不变)
+    void recordSetting(TraceSetting setting, float value, uint32_t timestamp);
+    
+    // 直接追加一条记录 (空闲时从串口上传现场记录)
+    bool append(const TraceRecord& record);
+    
+    // 取出某个消费者下一条已到时间的记录，时间戳换算为当前时钟
+    bool nextReplay(TraceSource source, uint32_t now, TraceRecord& record);
+    
+    // 状态
+    bool isRecording();
+    bool isReplaying();
+    bool replayFinished();
+    uint16_t getCount();
+    
+    // 串口输出全部记录: TRC,BEGIN,条数 / TRC,16位十六进制 / TRC,END
+    void dump();
+    
+    // 解析dump输出的一条十六进制记录
+    static bool parseRecord(const char* hex, TraceRecord& record);
+};
+
+#endif // TRACE_RECORDER_H
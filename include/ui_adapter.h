@@ -5,10 +5,12 @@
 #include <Adafruit_SSD1306.h>
 #include <Adafruit_GFX.h>
 #include "config.h"
-#include "temp_sensor.h"
-#include "pid_controller.h"
-#include "pwm_controller.h"
 #include "user_input.h"
+#include "oled_flusher.h"
+#include "profiler.h"
+#include "ui_widgets.h"
+#include "temp_trend.h"
+#include "control_channel.h"
 
 // UI页面定义
 enum UIPage {
@@ -17,7 +19,25 @@ enum UIPage {
     UI_PAGE_PID_MENU,        // PID参数菜单
     UI_PAGE_CALIBRATION,     // 校准菜单
     UI_PAGE_SYSTEM_INFO,     // 系统信息页面
-    UI_PAGE_ERROR            // 错误页面
+    UI_PAGE_PROFILER,        // 性能分析页面
+    UI_PAGE_TREND,           // 温度趋势页面
+    UI_PAGE_ERROR,           // 错误页面
+    UI_PAGE_COUNT
+};
+
+// 界面元素脏标记: 数据变化时置位，只有当前页面用到的元素变化才重绘
+enum UIDirtyFlag {
+    UI_DIRTY_TEMP        = 0x01,    // 当前温度 (0.1°C)
+    UI_DIRTY_TARGET      = 0x02,    // 目标温度
+    UI_DIRTY_POWER       = 0x04,    // 功率百分比
+    UI_DIRTY_STATE       = 0x08,    // 系统状态
+    UI_DIRTY_ENERGY      = 0x10,    // 能耗统计
+    UI_DIRTY_INPUT       = 0x20,    // 页面内输入 (菜单选择、编辑值)
+    UI_DIRTY_CLOCK       = 0x40,    // 运行时间秒数
+    UI_DIRTY_ERROR       = 0x80,    // 错误信息
+    UI_DIRTY_PAGE        = 0x100,   // 页面切换，整页重绘
+    UI_DIRTY_TREND       = 0x200,   // 趋势图有新列
+    UI_DIRTY_ALL         = 0x3FF
 };
 
 // 菜单项类型
@@ -28,25 +48,42 @@ enum MenuItemType {
     ITEM_SUBMENU         // 子菜单项
 };
 
-// 菜单项定义
+// 菜单项绑定的参数: 开关和滑块直接读写实际参数，不保存副本
+enum MenuParam {
+    PARAM_NONE = 0,
+    PARAM_HEATING,           // 开关: 加热 (发送启动/停止命令)
+    PARAM_BURST_MODE,        // 开关: 整周期输出模式
+    PARAM_PID_KP,            // 滑块: PID参数 (经控制通道交给控制任务)
+    PARAM_PID_KI,
+    PARAM_PID_KD,
+    PARAM_TEMP_OFFSET        // 滑块: 温度校准偏移
+};
+
+// 菜单项定义 (编译期常量表，存放在Flash)
 struct MenuItem {
-    char title[20];          // 菜单项标题
+    const char* title;       // 菜单项标题
     MenuItemType type;       // 菜单项类型
     UIPage targetPage;       // 目标页面（仅适用于子菜单）
-    float* valuePtr;         // 值指针（用于滑块和开关）
+    MenuParam param;         // 绑定的参数（用于滑块和开关）
     float minValue;          // 最小值（用于滑块）
     float maxValue;          // 最大值（用于滑块）
     float stepValue;         // 步长（用于滑块）
 };
 
+// 菜单定义
+struct MenuDefinition {
+    const char* title;       // 页面标题
+    const MenuItem* items;   // 菜单项表
+    uint8_t itemCount;       // 菜单项数量
+};
+
 // UI适配器类
 class UIAdapter {
 private:
     Adafruit_SSD1306* display;  // 显示屏指针
-    TempSensor* tempSensor;     // 温度传感器指针
-    PIDController* pidController; // PID控制器指针
-    PWMController* pwmController; // PWM控制器指针
     UserInput* userInput;       // 用户输入指针
+    OledFlusher* flusher;       // 分页刷新器 (可选)
+    ControlChannel* control;    // 控制任务通道 (可选，菜单中的开关和参数)
     
     // UI状态
     UIPage currentPage;         // 当前页面
@@ -64,52 +101,201 @@ private:
     float targetTemp;           // 目标温度
     uint8_t powerPercentage;    // 功率百分比
     SystemState systemState;    // 系统状态
+    float sessionEnergy;        // 本次加热能耗 (Wh)
+    float lifetimeEnergy;       // 累计能耗 (Wh)
     
     // 动画参数
     uint8_t animationFrame;     // 动画帧
-    unsigned long lastRefreshTime; // 上次刷新时间
-    
-    // 菜单参数
-    static const uint8_t MAX_MENU_ITEMS = 6;            // 最大菜单项数
-    MenuItem mainMenuItems[MAX_MENU_ITEMS];             // 主菜单项
-    MenuItem pidMenuItems[MAX_MENU_ITEMS];              // PID菜单项
-    MenuItem calibrationMenuItems[MAX_MENU_ITEMS];      // 校准菜单项
-    uint8_t mainMenuItemCount;                          // 主菜单项数量
-    uint8_t pidMenuItemCount;                           // PID菜单项数量
-    uint8_t calibrationMenuItemCount;                   // 校准菜单项数量
-    
-    // 绘制不同页面
-    void drawMainPage();
-    void drawMainMenu();
-    void drawPIDMenu();
-    void drawCalibrationPage();
-    void drawSystemInfoPage();
-    void drawErrorPage();
-    
-    // 通用菜单绘制函数
-    void drawMenu(MenuItem* items, uint8_t itemCount, const char* title);
-    
-    // 辅助绘制函数
-    void drawProgressBar(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t percentage);
-    void drawAnimatedBar(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t percentage);
-    void drawSelector(uint16_t y, uint16_t width);
-    
-    // 初始化菜单项
-    void initMenuItems();
+    
+    // 变化驱动刷新: 每次可见数据变化时generation加1并置位对应脏标记
+    uint32_t generation;        // 数据版本
+    uint32_t renderedGeneration; // 最近一次绘制时的数据版本
+    uint16_t dirtyFlags;        // 自上次绘制以来变化的元素
+    uint32_t lastClockSecond;   // 最近一次置位UI_DIRTY_CLOCK的秒数
+    uint32_t renderedFrames;    // 绘制帧数
+    uint32_t skippedFrames;     // 数据未变化而跳过的帧数
+    bool pageChanged;           // 页面切换，下一帧清屏并重绘全部控件
+    bool framePending;          // 已绘制到帧缓冲但刷新器忙、尚未提交的帧
+    
+    // 主页面控件
+    WidgetScreen mainScreen;
+    NumberField mainTarget;
+    NumberField mainPower;
+    BarWidget mainBar;
+    BigNumberField mainTemp;
+    Label mainUnit;
+    Label mainState;
+    Label mainHint;
+    
+    // 菜单页面控件 (主菜单和PID菜单共用)
+    WidgetScreen menuScreen;
+    Label menuTitle;
+    SelectorWidget menuSelector;
+    ListWidget menuList;
+    Label menuHint;
+    
+    // 校准页面控件
+    WidgetScreen calibrationScreen;
+    Label calibrationTitle;
+    NumberField calibrationCurrent;
+    NumberField calibrationReal;
+    NumberField calibrationOffset;
+    Label calibrationHint;
+    
+    // 系统信息页面控件
+    WidgetScreen infoScreen;
+    Label infoTitle;
+    Label infoVersion;
+    Label infoUptime;
+    Label infoPID;
+    Label infoEnergy;
+    Label infoHint;
+    
+    // 性能分析页面控件
+    WidgetScreen profilerScreen;
+    Label profilerHeader;
+    Label profilerRows[PROF_ZONE_COUNT];
+    
+    // 温度趋势页面控件
+    WidgetScreen trendScreen;
+    Label trendTitle;
+    Label trendRange;
+    TrendWidget trendPlot;
+    
+    // 错误页面控件
+    WidgetScreen errorScreen;
+    Label errorTitle;
+    Label errorCodeLabel;
+    Label errorText;
+    Label errorHeater;
+    Label errorHint;
+    
+    // 菜单列表正在显示的菜单
+    const MenuDefinition* shownMenu;
+    
+    // 页面输入处理函数，steps为旋转格数 (顺时针为正，点击事件为0)
+    typedef void (UIAdapter::*InputHandler)(int16_t steps);
+    
+    // 一个页面对各输入事件的处理 (nullptr为忽略)
+    struct PageInput {
+        InputHandler rotate;
+        InputHandler click;
+        InputHandler doubleClick;
+        InputHandler longPress;
+    };
+    
+    // 按页面索引的输入分发表 (常量，存放在Flash)
+    static const PageInput PAGE_INPUT[UI_PAGE_COUNT];
+    
+    // 创建各页面控件
+    void buildScreens();
+    
+    // 页面对应的控件集合
+    WidgetScreen* getScreen(UIPage page);
+    
+    // 把当前数据写入各页面控件，内容变化的控件自动失效
+    void bindMainPage();
+    void bindMenu(const MenuDefinition* menu, uint16_t flags);
+    void bindCalibrationPage();
+    void bindSystemInfoPage();
+    void bindProfilerPage();
+    bool bindTrendPage();       // 返回趋势图是否增量滚动 (不经过render())
+    void bindErrorPage();
+    
+    // 把数据写入页面的控件，返回趋势图是否增量滚动
+    bool bindPage(UIPage page, uint16_t flags);
+    
+    // 清屏并绘制整页到帧缓冲 (不发送)
+    void renderPage(UIPage page);
+    
+    // 按脏标记增量绘制当前页面到帧缓冲，返回是否有内容变化
+    bool drawFrame(bool animating);
+    
+    // 菜单列表的行内容
+    static void menuRow(void* context, uint8_t index, ListRow& row);
+    
+    // 页面对应的菜单 (不是菜单页面时返回nullptr)
+    static const MenuDefinition* getMenu(UIPage page);
+    
+    // 读写菜单项绑定的参数
+    bool getSwitch(MenuParam param);
+    void toggleSwitch(MenuParam param);
+    float getSlider(MenuParam param);
+    void setSlider(MenuParam param, float value);
+    
+    // 滑块按步长调整steps格并限制在范围内
+    void adjustSlider(const MenuItem& item, int16_t steps);
+    
+    // 输入处理 (PAGE_INPUT表中引用)
+    void adjustTarget(int16_t steps);       // 主页面: 调整目标温度
+    void openMenu(int16_t steps);           // 主页面: 进入主菜单
+    void rotateMenu(int16_t steps);         // 菜单: 移动选择或调整编辑中的值
+    void selectMenuItem(int16_t steps);     // 菜单: 执行选中项或结束编辑
+    void leaveMenu(int16_t steps);          // 菜单: 不在编辑时返回上一级
+    void adjustCalibration(int16_t steps);  // 校准页面: 调整温度偏移
+    void rotateTrendScale(int16_t steps);   // 趋势页面: 切换时间尺度
+    void goBack(int16_t steps);             // 返回上一页面
+    void resetError(int16_t steps);         // 错误页面: 清除错误回到主页面
+    
+    // 标记元素变化
+    void markDirty(uint16_t flags);
+    
+    // 页面用到的元素
+    static uint16_t pageDirtyMask(UIPage page);
+    
+    // 当前页面是否有持续变化的内容 (动画、实时统计)
+    bool isAnimating();
 
 public:
-    UIAdapter(Adafruit_SSD1306* _display, TempSensor* _tempSensor, 
-              PIDController* _pidController, PWMController* _pwmController,
-              UserInput* _userInput);
+    UIAdapter(Adafruit_SSD1306* _display, UserInput* _userInput);
     
     // 初始化UI
     bool begin();
     
-    // 更新UI显示
+    // 使用分页刷新器代替display()，与传感器共享总线
+    void attachFlusher(OledFlusher* _flusher);
+    
+    // 设置趋势页面的数据来源
+    void attachTrend(TempTrend* trend);
+    
+    // 设置控制任务通道，菜单中的开关和参数只经此读写 (控制任务的对象属于另一个核心)
+    void attachControl(ControlChannel* _control);
+    
+    // 当前页面内容有变化或有动画时绘制并刷新UI，否则跳过 (由调度器按UI_REFRESH_INTERVAL周期调用)
+    // 上一帧仍在传输时照常绘制到帧缓冲 (后台缓冲)，等刷新器空闲后再提交
     void update();
     
-    // 处理用户输入
-    void handleInput();
+    // 是否有已绘制但尚未提交的帧 (调度器据此缩短下一次调用的间隔)
+    bool hasPendingFrame();
+    
+    // 数据版本，每次可见数据变化时递增
+    uint32_t getGeneration();
+    
+    // 串口输出统计: UI,绘制帧数,跳过帧数
+    void printStats();
+    
+    // 清零统计
+    void resetStats();
+    
+    // 每个页面离屏整页绘制iterations次，串口输出 BENCH,页面,次数,平均us,最长us (目标上的实际耗时)
+    // 完成后重绘当前页面；页面内容的回归基准见主机端测试test_page_render
+    void benchmark(uint16_t iterations);
+    
+    // 离屏绘制一个页面并输出帧缓冲: PBM,BEGIN,页面 / PBM,<P1格式的一行> / PBM,END
+    void snapshot(UIPage page);
+    
+    // 页面名称 (main/menu/pid/cal/info/prof/trend/error)
+    static const char* getPageName(UIPage page);
+    
+    // 按名称查找页面
+    static bool findPage(const char* name, UIPage* page);
+    
+    // 加热命令输入: 主界面待机时单击开始、加热时双击停止、错误时长按复位 (经控制通道发送)，
+    // 事件已被消耗时返回true；错误时的长按仍需交给handleInput关闭错误页面
+    bool handleControlInput(const InputEvent& event);
+    
+    // 处理一个用户输入事件
+    void handleInput(const InputEvent& event);
     
     // 设置当前页面
     void setPage(UIPage page);
@@ -117,6 +303,9 @@ public:
     // 获取当前页面
     UIPage getPage();
     
+    // 帧缓冲被其他前端改写后，下一帧清屏并重绘当前页面全部控件
+    void redraw();
+    
     // 设置温度
     void setTemperature(float current, float target);
     
@@ -126,6 +315,9 @@ public:
     // 设置系统状态
     void setSystemState(SystemState state);
     
+    // 设置能耗统计 (Wh)
+    void setEnergy(float session, float lifetime);
+    
     // 显示错误信息
     void showError(ErrorCode code, const char* message);
     
@@ -134,6 +326,9 @@ public:
     
     // 获取目标温度（通过UI修改后）
     float getTargetTemp();
+    
+    // 设置目标温度 (其他前端修改，限制在TEMP_MIN~TEMP_MAX)
+    void setTargetTemp(float target);
 };
 
 #endif // UI_ADAPTER_H 
\ No newline at end of file
@@ -0,0 +1,280 @@
+#ifndef UI_WIDGETS_H
+#define UI_WIDGETS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "config.h"
+#include "big_digits.h"
+#include "temp_trend.h"
+#include "num_format.h"
+
+// 保留模式控件
+// 每个控件记住自己的边界和内容，内容变化时只把该控件失效；
+// WidgetScreen只清除并重绘失效的控件，帧缓冲中其余部分保持不变。
+
+// 控件基类
+class Widget {
+protected:
+    int16_t x;              // 边界左上角
+    int16_t y;
+    uint8_t width;          // 边界大小
+    uint8_t height;
+    bool visible;
+    bool dirty;             // 内容变化，下一次render()重绘
+    Widget* next;           // 同一屏幕中的下一个控件 (绘制顺序)
+    
+    // 在边界内绘制内容 (边界已被清除)
+    virtual void paint(Adafruit_GFX* gfx) = 0;
+    
+    friend class WidgetScreen;
+
+public:
+    Widget();
+    virtual ~Widget() {}
+    
+    // 设置边界
+    void setBounds(int16_t _x, int16_t _y, uint8_t _width, uint8_t _height);
+    
+    // 显示/隐藏
+    void setVisible(bool show);
+    
+    // 标记失效
+    void invalidate();
+    
+    // 是否失效
+    bool isDirty();
+    
+    // 边界是否与另一个控件重叠
+    bool overlaps(const Widget* other) const;
+};
+
+// 文本标签 (在边界内按行排版，超出边界的字符不绘制)
+class Label : public Widget {
+private:
+    char text[UI_LABEL_LENGTH];
+    uint8_t textSize;
+    bool underline;         // 在边界底部画一条横线 (页面标题)
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    Label();
+    
+    // 设置文本，内容相同时不失效
+    void setText(const char* _text);
+    
+    // 设置字号
+    void setTextSize(uint8_t size);
+    
+    // 设置底部横线
+    void setUnderline(bool enable);
+};
+
+// 数值字段: 前缀 + 数值 + 后缀
+class NumberField : public Widget {
+private:
+    int32_t shownValue;     // 按显示精度量化后的值 (定点数，绘制时直接格式化)
+    uint8_t decimals;       // 小数位数
+    const char* prefix;
+    const char* suffix;
+    uint8_t textSize;
+    uint8_t suffixSize;     // 后缀字号 (单位可以比数值小)
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    NumberField();
+    
+    // 设置格式 (在setValue之前调用，数值按小数位数量化)
+    void setFormat(uint8_t _decimals, const char* _prefix, const char* _suffix, uint8_t _textSize = 1, uint8_t _suffixSize = 1);
+    
+    // 设置数值，显示内容不变时不失效
+    void setValue(float _value);
+};
+
+// 大号数值 (16x24字模，一位小数)，宽度不够时只显示整数，在边界内右对齐
+// 纵坐标按8对齐时字模整字节复制到帧缓冲，否则退回放大的GFX字体
+class BigNumberField : public Widget {
+private:
+    int32_t shownValue;     // 显示值 (0.1单位)
+    uint8_t* framebuffer;   // SSD1306帧缓冲 (可选)
+    
+    // 把一个字符的字模复制到帧缓冲，返回下一个字符的列
+    int16_t blit(int16_t column, const uint8_t* glyph, uint8_t glyphWidth);
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    BigNumberField();
+    
+    // 设置帧缓冲，之后直接复制字模
+    void attachFramebuffer(uint8_t* buffer);
+    
+    // 设置数值，0.1位不变时不失效
+    void setValue(float value);
+};
+
+// 进度条，可带流动动画点
+class BarWidget : public Widget {
+private:
+    uint8_t percentage;
+    bool animated;
+    uint8_t frame;          // 动画帧 (0-7)
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    BarWidget();
+    
+    // 设置百分比
+    void setValue(uint8_t _percentage);
+    
+    // 启用动画
+    void setAnimated(bool enable);
+    
+    // 设置动画帧，只有显示动画点时才失效
+    void setFrame(uint8_t _frame);
+};
+
+// 温度趋势图: 左侧8列为纵轴，其余TREND_COLUMNS列每列画出一段时间的最低~最高温度
+// 纵坐标和高度按8对齐时直接写帧缓冲；有新列且纵轴范围不变时把绘图区左移并只画新列，
+// 不经过WidgetScreen的清除重绘
+class TrendWidget : public Widget {
+private:
+    TempTrend* source;
+    uint8_t* framebuffer;   // SSD1306帧缓冲 (可选)
+    uint8_t scale;          // 时间尺度
+    uint32_t shownColumns;  // 已绘制到的列计数
+    int16_t rangeLow;       // 纵轴范围 (0.1°C，按TREND_RANGE_STEP取整)
+    int16_t rangeHigh;
+    bool hasData;
+    
+    // 按当前数据计算纵轴范围
+    void computeRange(int16_t* low, int16_t* high, bool* valid);
+    
+    // 温度对应的行 (0为绘图区顶部)
+    int16_t valueToRow(int16_t value);
+    
+    // 直接写帧缓冲画一列 (覆盖该列原有内容)
+    void drawColumn(int16_t column, const TrendColumn& data);
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    TrendWidget();
+    
+    // 设置帧缓冲，之后可以增量滚动
+    void attachFramebuffer(uint8_t* buffer);
+    
+    // 设置数据来源
+    void setSource(TempTrend* _source);
+    
+    // 设置时间尺度，改变时整图重绘
+    void setScale(uint8_t _scale);
+    
+    // 当前时间尺度
+    uint8_t getScale();
+    
+    // 数据来源有尚未绘制的列
+    bool hasNewColumns();
+    
+    // 增量绘制新列，返回是否改写了帧缓冲；纵轴范围变化或无法增量时改为失效整图重绘
+    bool scroll();
+    
+    // 纵轴范围 (0.1°C)，没有数据时返回false
+    bool getRange(int16_t* low, int16_t* high);
+};
+
+// 列表选中行高亮
+class SelectorWidget : public Widget {
+private:
+    int8_t row;             // 选中行 (-1为不显示)
+    uint8_t rowHeight;
+    bool editing;           // 编辑模式只画左侧竖条
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    SelectorWidget();
+    
+    // 设置行高
+    void setRowHeight(uint8_t _rowHeight);
+    
+    // 设置选中行
+    void setRow(int8_t _row);
+    
+    // 设置编辑模式
+    void setEditing(bool enable);
+};
+
+// 列表的一行
+struct ListRow {
+    const char* title;                  // 标题
+    char value[UI_LIST_VALUE_LENGTH];   // 右侧的值 (空字符串为不显示)
+    uint8_t valueX;                     // 值的横坐标
+};
+
+// 读取列表第index行的内容
+typedef void (*ListRowFunction)(void* context, uint8_t index, ListRow& row);
+
+// 可滚动列表，选中行由SelectorWidget高亮
+class ListWidget : public Widget {
+private:
+    ListRowFunction rowFunction;
+    void* context;
+    SelectorWidget* selector;   // 选中行高亮 (可选)
+    uint8_t itemCount;
+    uint8_t selection;
+    uint8_t firstRow;           // 第一行显示的项
+    uint8_t visibleRows;
+    uint8_t rowHeight;
+    
+    // 让选中项保持在可见范围内
+    void scroll();
+
+protected:
+    void paint(Adafruit_GFX* gfx) override;
+
+public:
+    ListWidget();
+    
+    // 设置行数和行高
+    void setLayout(uint8_t _visibleRows, uint8_t _rowHeight);
+    
+    // 设置数据来源
+    void setSource(ListRowFunction _rowFunction, void* _context, uint8_t _itemCount);
+    
+    // 关联高亮控件
+    void attachSelector(SelectorWidget* _selector);
+    
+    // 设置选中项
+    void setSelection(uint8_t _selection);
+};
+
+// 一个页面的全部控件
+class WidgetScreen {
+private:
+    Widget* first;
+    Widget* last;
+
+public:
+    WidgetScreen();
+    
+    // 按绘制顺序添加控件 (后添加的在上层)
+    void add(Widget* widget);
+    
+    // 全部控件失效 (页面切换后帧缓冲已清除)
+    void invalidateAll();
+    
+    // 清除并重绘失效的控件，返回是否有控件被重绘
+    bool render(Adafruit_GFX* gfx);
+};
+
+#endif // UI_WIDGETS_H
@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <AiEsp32RotaryEncoder.h>
 #include "config.h"
+#include "spsc_ring.h"
+#include "trace_recorder.h"
 
 // 编码器事件
 enum EncoderEvent {
@@ -15,15 +17,31 @@ enum EncoderEvent {
     EV_ROTATE_CCW      // 逆时针旋转
 };
 
+// 输入事件
+struct InputEvent {
+    EncoderEvent type;      // 事件类型
+    uint8_t steps;          // 旋转格数 (仅旋转事件，其他事件为0)
+    uint32_t timestamp;     // 事件发生时间 (毫秒，来自中断时间戳)
+};
+
+// 按钮边沿 (中断 -> 任务)
+struct ButtonEdge {
+    uint32_t timestamp;     // 中断时间 (毫秒)
+    uint8_t level;          // 边沿后的引脚电平
+};
+
 class UserInput {
 private:
     AiEsp32RotaryEncoder encoder;
     bool initialized;
+    TraceRecorder* recorder;        // 现场记录 (可选)
+    bool replayMode;                // 回放模式: 忽略硬件输入，只处理注入的记录
     
-    // 按钮状态
+    // 按钮状态 (消抖后)
     bool buttonPressed;
-    unsigned long buttonPressTime;
-    unsigned long lastButtonReleaseTime;
+    uint32_t lastEdgeTime;          // 上次接受的边沿时间
+    uint32_t buttonPressTime;
+    uint32_t lastButtonReleaseTime;
     uint8_t clickCount;
     
     // 长按和双击检测配置
@@ -34,9 +52,23 @@ private:
     int16_t encoderValue;
     uint8_t encoderStep;
     
-    // 处理单击、双击、长按的标志位
-    bool processingLongPress;
-    bool processingDoubleClick;
+    // 识别出的手势事件
+    SpscRing<InputEvent, INPUT_EVENT_QUEUE_SIZE> events;
+    
+    // 处理一个按钮边沿
+    void processEdge(const ButtonEdge& edge);
+    
+    // 单击等待双击超时则输出单击
+    void checkClickTimeout(uint32_t now);
+    
+    // 处理编码器位置变化
+    void processRotation();
+    
+    // 按旋转格数输出旋转事件
+    void applyRotation(int16_t delta, uint32_t timestamp);
+    
+    // 输出一个事件
+    void emit(EncoderEvent type, uint8_t steps, uint32_t timestamp);
     
 public:
     UserInput();
@@ -44,11 +76,23 @@ public:
     // 初始化用户输入
     bool begin();
     
-    // 更新用户输入状态
+    // 处理中断记录的边沿和编码器计数，识别手势
     void update();
     
-    // 获取编码器事件
-    EncoderEvent getEvent();
+    // 记录全部按钮边沿和编码器旋转
+    void attachRecorder(TraceRecorder* _recorder);
+    
+    // 进入/退出回放模式
+    void setReplayMode(bool enable);
+    
+    // 回放时注入一个按钮边沿
+    void injectEdge(const ButtonEdge& edge);
+    
+    // 回放时注入一次编码器旋转
+    void injectRotation(int16_t delta, uint32_t timestamp);
+    
+    // 取出一个输入事件，没有事件时type为EV_NONE
+    InputEvent getEvent();
     
     // 获取编码器当前值
     int16_t getEncoderValue();
@@ -69,4 +113,4 @@ public:
     static void IRAM_ATTR handleEncoderInterrupt();
 };
 
-#endif // USER_INPUT_H 
\ No newline at end of file
+#endif // USER_INPUT_H 
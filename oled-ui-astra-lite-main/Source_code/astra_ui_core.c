@@ -5,7 +5,6 @@
 #include "astra_ui_core.h"
 #include <stdio.h>
 #include "astra_ui_drawer.h"
-#include <tgmath.h>
 
 bool in_astra = false;
 
@@ -61,25 +60,84 @@ void ad_astra()
   /**自行修改**/
 }
 
-void astra_animation(float *_pos, float _posTrg, float _speed)
+//2^(-i/32) Q15 半衰期的1/32为一档 末项为下一个半衰期的起点 供插值使用
+static const uint16_t astra_decay_table[33] = {
+  32768, 32066, 31379, 30706, 30048, 29405, 28774, 28158,
+  27554, 26964, 26386, 25821, 25268, 24726, 24196, 23678,
+  23170, 22674, 22188, 21713, 21247, 20792, 20347, 19911,
+  19484, 19066, 18658, 18258, 17867, 17484, 17109, 16743,
+  16384
+};
+
+static uint32_t astra_animation_elapsed = 0; //本帧推进的时间(ms)
+static bool astra_animation_moving = false; //本帧有补间未到达目标
+
+void astra_animation_advance(uint32_t _elapsed)
+{
+  if (_elapsed > ASTRA_ANIMATION_MAX_STEP) _elapsed = ASTRA_ANIMATION_MAX_STEP;
+  astra_animation_elapsed = _elapsed;
+  astra_animation_moving = false;
+}
+
+bool astra_animation_settled()
 {
-  if (*_pos != _posTrg)
+  return !astra_animation_moving;
+}
+
+void astra_animation(astra_pos_t *_pos, int16_t _posTrg, uint16_t _halfLife)
+{
+  astra_pos_t _trg = ASTRA_POS(_posTrg);
+  if (*_pos == _trg) return;
+
+  //经过的半衰期数 Q16 整数部分移位 小数部分高5位查表 低11位在相邻两档之间线性插值
+  //只取Q5时一帧不足半衰期的1/32就不会移动 且每帧最多少算1/32个半衰期 动画明显变慢
+  uint32_t _exp = (astra_animation_elapsed << 16) / _halfLife;
+  uint32_t _dist = *_pos > _trg ? (uint32_t)(*_pos - _trg) : (uint32_t)(_trg - *_pos);
+  if (_exp >= (24u << 16)) _dist = 0;
+  else
   {
-    if (fabs(*_pos - _posTrg) <= 1.0f) *_pos = _posTrg;
-    else *_pos += (_posTrg - *_pos) / (100.0f - _speed) / 1.0f;
+    uint32_t _index = (_exp >> 11) & 31;
+    uint32_t _frac = _exp & 0x7FF;
+    uint32_t _factor = astra_decay_table[_index] - (((uint32_t)(astra_decay_table[_index] - astra_decay_table[_index + 1]) * _frac) >> 11);
+    //向下取整 只要经过的时间不为0 剩余距离每帧至少减少1/256像素
+    _dist = (uint32_t)(((uint64_t)_dist * _factor) >> 15) >> (_exp >> 16);
   }
+
+  //不足1像素时直接到位
+  if (_dist < ASTRA_POS(1))
+  {
+    *_pos = _trg;
+    return;
+  }
+
+  *_pos = *_pos > _trg ? _trg + (astra_pos_t)_dist : _trg - (astra_pos_t)_dist;
+  astra_animation_moving = true;
+}
+
+bool astra_ui_is_idle()
+{
+  if (astra_animation_moving) return false;
+  if (astra_info_bar.is_running || astra_pop_up.is_running) return false; //到时收回
+  if (!astra_exit_animation_finished) return false;
+  if (!in_astra) return true;
+
+  //用户项的内容由用户函数绘制 滑块调整中数值闪烁
+  if (astra_selector.selected_item->type == user_item && astra_to_user_item(astra_selector.selected_item)->in_user_item) return false;
+  if (astra_selector.selected_item->type == slider_item && astra_to_slider_item(astra_selector.selected_item)->is_confirmed) return false;
+
+  return true;
 }
 
 void astra_refresh_info_bar()
 {
-  astra_animation(&astra_info_bar.y_info_bar, astra_info_bar.y_info_bar_trg, 94);
-  astra_animation(&astra_info_bar.w_info_bar, astra_info_bar.w_info_bar_trg, 95);
+  astra_animation(&astra_info_bar.y_info_bar, astra_info_bar.y_info_bar_trg, ASTRA_HALF_LIFE_INFO_BAR_Y);
+  astra_animation(&astra_info_bar.w_info_bar, astra_info_bar.w_info_bar_trg, ASTRA_HALF_LIFE_INFO_BAR_W);
 }
 
 void astra_refresh_pop_up()
 {
-  astra_animation(&astra_pop_up.y_pop_up, astra_pop_up.y_pop_up_trg, 94);
-  astra_animation(&astra_pop_up.w_pop_up, astra_pop_up.w_pop_up_trg, 96);
+  astra_animation(&astra_pop_up.y_pop_up, astra_pop_up.y_pop_up_trg, ASTRA_HALF_LIFE_POP_UP_Y);
+  astra_animation(&astra_pop_up.w_pop_up, astra_pop_up.w_pop_up_trg, ASTRA_HALF_LIFE_POP_UP_W);
 }
 
 void astra_refresh_camera_position()
@@ -91,8 +149,8 @@ void astra_refresh_camera_position()
   if (astra_camera.selector->y_selector_trg + astra_camera.y_camera_trg < 0)  //向上超出屏幕 需要向上移动
     astra_camera.y_camera_trg = 0 - astra_camera.selector->y_selector_trg + LIST_FONT_TOP_MARGIN;
 
-  astra_animation(&astra_camera.x_camera, astra_camera.x_camera_trg, 96);
-  astra_animation(&astra_camera.y_camera, astra_camera.y_camera_trg, 96);
+  astra_animation(&astra_camera.x_camera, astra_camera.x_camera_trg, ASTRA_HALF_LIFE_CAMERA);
+  astra_animation(&astra_camera.y_camera, astra_camera.y_camera_trg, ASTRA_HALF_LIFE_CAMERA);
 }
 
 void astra_refresh_widget_core_position()
@@ -109,8 +167,8 @@ void astra_init_list()
     astra_get_root_list()->child_list_item[i]->y_list_item = 0;
   astra_selector.selected_index = 0;
   astra_selector.selected_item = astra_get_root_list()->child_list_item[0];
-  astra_selector.y_selector = OLED_HEIGHT;
-  astra_selector.h_selector = OLED_HEIGHT;
+  astra_selector.y_selector = ASTRA_POS(OLED_HEIGHT);
+  astra_selector.h_selector = ASTRA_POS(OLED_HEIGHT);
 }
 
 void astra_init_core()
@@ -123,7 +181,7 @@ void astra_init_core()
 void astra_refresh_list_item_position()
 {
   for (uint8_t i = 0; i < astra_selector.selected_item->parent->child_num; i++)
-    astra_animation(&astra_selector.selected_item->parent->child_list_item[i]->y_list_item, astra_selector.selected_item->parent->child_list_item[i]->y_list_item_trg, 84);
+    astra_animation(&astra_selector.selected_item->parent->child_list_item[i]->y_list_item, astra_selector.selected_item->parent->child_list_item[i]->y_list_item_trg, ASTRA_HALF_LIFE_LIST_ITEM);
 }
 
 void astra_refresh_selector_position()
@@ -134,9 +192,9 @@ void astra_refresh_selector_position()
     astra_selector.w_selector_trg = OLED_WIDTH - 18;
   else astra_selector.w_selector_trg = oled_get_UTF8_width(astra_selector.selected_item->content) + 12;
   astra_selector.h_selector_trg = 15;
-  astra_animation(&astra_selector.y_selector, astra_selector.y_selector_trg, 92);
-  astra_animation(&astra_selector.w_selector, astra_selector.w_selector_trg, 92);
-  astra_animation(&astra_selector.h_selector, astra_selector.h_selector_trg, 93);
+  astra_animation(&astra_selector.y_selector, astra_selector.y_selector_trg, ASTRA_HALF_LIFE_SELECTOR);
+  astra_animation(&astra_selector.w_selector, astra_selector.w_selector_trg, ASTRA_HALF_LIFE_SELECTOR);
+  astra_animation(&astra_selector.h_selector, astra_selector.h_selector_trg, ASTRA_HALF_LIFE_SELECTOR_H);
 }
 
 void astra_refresh_main_core_position()
@@ -5,10 +5,37 @@
 #ifndef ASTRA_UI_CORE_H
 #define ASTRA_UI_CORE_H
 #include <stdbool.h>
+#include <stdint.h>
+#include "astra_ui_item.h"
 
 #define ALLOW_EXIT_ASTRA_UI_BY_USER 1 //允许用户在最浅层级退出astra ui lite
 extern bool in_astra;
 
+/*** 动画 ***/
+//补间的剩余距离按半衰期做指数衰减 d(t+dt) = d(t) * 2^(-dt/半衰期) 与帧率无关
+//每帧绘制前调用astra_animation_advance()传入距上一帧经过的tick
+#define ASTRA_ANIMATION_MAX_STEP 50 //单帧最多推进的时间(ms) 空闲后第一帧不会直接跳到目标
+
+//各元素的半衰期(ms)
+#define ASTRA_HALF_LIFE_INFO_BAR_Y 63
+#define ASTRA_HALF_LIFE_INFO_BAR_W 52
+#define ASTRA_HALF_LIFE_POP_UP_Y 63
+#define ASTRA_HALF_LIFE_POP_UP_W 40
+#define ASTRA_HALF_LIFE_CAMERA 40
+#define ASTRA_HALF_LIFE_LIST_ITEM 179
+#define ASTRA_HALF_LIFE_SELECTOR 87
+#define ASTRA_HALF_LIFE_SELECTOR_H 75
+#define ASTRA_HALF_LIFE_EXIT_MASK 63
+
+extern void astra_animation_advance(uint32_t _elapsed);
+
+extern void astra_animation(astra_pos_t *_pos, int16_t _posTrg, uint16_t _halfLife);
+
+extern bool astra_animation_settled(); //上一帧所有补间都已到达目标
+
+extern bool astra_ui_is_idle(); //画面不会再自行变化 可以停止重绘 直到有新的输入
+/*** 动画 ***/
+
 extern void ad_astra();
 
 extern void astra_refresh_info_bar();
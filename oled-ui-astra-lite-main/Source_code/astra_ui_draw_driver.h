@@ -6,47 +6,82 @@
 #define FUCKCLION_CORE_SRC_ASTRA_UI_LITE_DRAW_DRIVER_H_
 
 /* 此处自行添加头文件 */
-// #include "../u8g2/u8g2.h"
-// #include "main.h"
-// #include "spi.h"
-// #include "../astra-launcher/launcher_delay.h"
+#include <stdint.h>
+#include <stdbool.h>
 /* 此处自行添加头文件 */
 
 /* 此处修改oled绘制函数 */
-// extern u8g2_t u8g2;
+// 绘制函数由 src/astra_driver.cpp 实现，绑定到Adafruit_SSD1306帧缓冲和OledFlusher
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t astra_gfx_get_ticks(void);
+extern void astra_gfx_delay(uint32_t ms);
+extern void astra_gfx_set_font(const void *font);
+extern void astra_gfx_draw_str(int16_t x, int16_t y, const char *str);    // y为基线
+extern uint16_t astra_gfx_get_str_width(const char *str);
+extern uint8_t astra_gfx_get_str_height(void);
+extern void astra_gfx_draw_pixel(int16_t x, int16_t y);
+extern void astra_gfx_draw_circle(int16_t x, int16_t y, int16_t r);
+extern void astra_gfx_draw_box(int16_t x, int16_t y, int16_t w, int16_t h);
+extern void astra_gfx_draw_frame(int16_t x, int16_t y, int16_t w, int16_t h);
+extern void astra_gfx_draw_R_box(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r);
+extern void astra_gfx_draw_R_frame(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r);
+extern void astra_gfx_draw_H_line(int16_t x, int16_t y, int16_t l);
+extern void astra_gfx_draw_V_line(int16_t x, int16_t y, int16_t h);
+extern void astra_gfx_draw_line(int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+extern void astra_gfx_draw_H_dotted_line(int16_t x, int16_t y, int16_t l);
+extern void astra_gfx_draw_V_dotted_line(int16_t x, int16_t y, int16_t h);
+extern void astra_gfx_draw_bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *bitmap);
+extern void astra_gfx_set_draw_color(uint8_t color);    // 0 清除, 1 点亮, 2 异或
+extern void astra_gfx_clear_buffer(void);
+extern bool astra_gfx_send_buffer(void);
+extern bool astra_gfx_send_area_buffer(int16_t x, int16_t y, int16_t w, int16_t h);
+
+extern void astra_ui_driver_init(void);
+
+#ifdef __cplusplus
+}
+#endif
 
 #define OLED_HEIGHT 64
 #define OLED_WIDTH 128
 
-#define get_ticks() ____
-#define delay(ms) ____
-#define oled_set_font(font) ____
-#define oled_draw_str(x, y, str) ____
-#define oled_draw_UTF8(x, y, str) ____
-#define oled_get_str_width(str) ____
-#define oled_get_UTF8_width(str) ____
-#define oled_get_str_height() ____
-#define oled_draw_pixel(x, y) ____
-#define oled_draw_circle(x, y, r) ____
-#define oled_draw_R_box(x, y, w, h, r) ____
-#define oled_draw_box(x, y, w, h) ____
-#define oled_draw_frame(x, y, w, h) ____
-#define oled_draw_R_frame(x, y, w, h, r) ____
-#define oled_draw_H_line(x, y, l) ____
-#define oled_draw_V_line(x, y, h) ____
-#define oled_draw_line(x1, y1, x2, y2) ____
-#define oled_draw_H_dotted_line(x, y, l) ____
-#define oled_draw_V_dotted_line(x, y, h) ____
-#define oled_draw_bMP(x, y, w, h, bitMap) ____
-#define oled_set_draw_color(color) ____
-#define oled_set_font_mode(mode) ____
-#define oled_set_font_direction(dir) ____
-#define oled_draw_pixel(x, y) ____
-#define oled_clear_buffer() ____
-#define oled_send_buffer() ____
-#define oled_send_area_buffer(x, y, w, h) ____
-/* 此处修改oled绘制函数 */
+// 只有GFX内置的6x8 ASCII字体，非ASCII字符显示为'?'
+#define u8g2_font_my_chinese ((void *)0)
+
+// C++文件中不覆盖Arduino的delay()
+#ifndef __cplusplus
+#define get_ticks() astra_gfx_get_ticks()
+#define launcher_get_tick_ms() astra_gfx_get_ticks()
+#define delay(ms) astra_gfx_delay(ms)
+#endif
 
-extern void astra_ui_driver_init();
+#define oled_set_font(font) astra_gfx_set_font(font)
+#define oled_draw_str(x, y, str) astra_gfx_draw_str((x), (y), (str))
+#define oled_draw_UTF8(x, y, str) astra_gfx_draw_str((x), (y), (str))
+#define oled_get_str_width(str) astra_gfx_get_str_width(str)
+#define oled_get_UTF8_width(str) astra_gfx_get_str_width(str)
+#define oled_get_str_height() astra_gfx_get_str_height()
+#define oled_draw_pixel(x, y) astra_gfx_draw_pixel((x), (y))
+#define oled_draw_circle(x, y, r) astra_gfx_draw_circle((x), (y), (r))
+#define oled_draw_R_box(x, y, w, h, r) astra_gfx_draw_R_box((x), (y), (w), (h), (r))
+#define oled_draw_box(x, y, w, h) astra_gfx_draw_box((x), (y), (w), (h))
+#define oled_draw_frame(x, y, w, h) astra_gfx_draw_frame((x), (y), (w), (h))
+#define oled_draw_R_frame(x, y, w, h, r) astra_gfx_draw_R_frame((x), (y), (w), (h), (r))
+#define oled_draw_H_line(x, y, l) astra_gfx_draw_H_line((x), (y), (l))
+#define oled_draw_V_line(x, y, h) astra_gfx_draw_V_line((x), (y), (h))
+#define oled_draw_line(x1, y1, x2, y2) astra_gfx_draw_line((x1), (y1), (x2), (y2))
+#define oled_draw_H_dotted_line(x, y, l) astra_gfx_draw_H_dotted_line((x), (y), (l))
+#define oled_draw_V_dotted_line(x, y, h) astra_gfx_draw_V_dotted_line((x), (y), (h))
+#define oled_draw_bMP(x, y, w, h, bitMap) astra_gfx_draw_bitmap((x), (y), (w), (h), (bitMap))
+#define oled_set_draw_color(color) astra_gfx_set_draw_color(color)
+#define oled_set_font_mode(mode) ((void)(mode))         // GFX单参数setTextColor即为透明背景
+#define oled_set_font_direction(dir) ((void)(dir))      // 只支持水平方向
+#define oled_clear_buffer() astra_gfx_clear_buffer()
+#define oled_send_buffer() astra_gfx_send_buffer()
+#define oled_send_area_buffer(x, y, w, h) astra_gfx_send_area_buffer((x), (y), (w), (h))
+/* 此处修改oled绘制函数 */
 
 #endif //FUCKCLION_CORE_SRC_ASTRA_UI_LITE_DRAW_DRIVER_H_
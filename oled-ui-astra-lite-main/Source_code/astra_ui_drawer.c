@@ -9,15 +9,6 @@
 
 #include "astra_ui_core.h"
 
-void astra_exit_animation(float *_pos, float _posTrg, float _speed)
-{
-  if (*_pos != _posTrg)
-  {
-    if (fabs(*_pos - _posTrg) <= 1.0f) *_pos = _posTrg;
-    else *_pos += (_posTrg - *_pos) / (100.0f - _speed) / 1.0f;
-  }
-}
-
 uint8_t astra_exit_animation_status = 0;
 
 void astra_draw_exit_animation()
@@ -27,8 +18,9 @@ void astra_draw_exit_animation()
   //1 遮罩落下完成 此时屏幕被遮罩填满 开始变更背景内容
   //2 遮罩开始抬升
   //0 遮罩抬升完成 退场动画完成
-  static float _temp_h = -8;
-  static float _temp_h_trg = OLED_HEIGHT + 8;
+  static astra_pos_t _temp_h_pos = ASTRA_POS(-8);
+  static int16_t _temp_h_trg = OLED_HEIGHT + 8;
+  int16_t _temp_h = ASTRA_PX(_temp_h_pos);
 
   oled_set_draw_color(0);
   oled_draw_box(0, 0, OLED_WIDTH, _temp_h); //遮罩
@@ -101,10 +93,10 @@ void astra_draw_exit_animation()
         oled_draw_pixel(i, j);
     }
 
-  astra_exit_animation(&_temp_h, _temp_h_trg, 94);
+  astra_animation(&_temp_h_pos, _temp_h_trg, ASTRA_HALF_LIFE_EXIT_MASK);
 
   //下落过程
-  if (astra_exit_animation_status == 0 && _temp_h == _temp_h_trg && _temp_h == OLED_HEIGHT + 8)
+  if (astra_exit_animation_status == 0 && _temp_h_pos == ASTRA_POS(OLED_HEIGHT + 8))
   {
     astra_exit_animation_status = 1; //落下来了
     return;
@@ -119,11 +111,11 @@ void astra_draw_exit_animation()
     return;
   }
 
-  if (astra_exit_animation_status == 2 && _temp_h == _temp_h_trg && _temp_h == -8)
+  if (astra_exit_animation_status == 2 && _temp_h_pos == ASTRA_POS(-8))
   {
     astra_exit_animation_finished = true;
     astra_exit_animation_status = 0; //退场动画完成
-    _temp_h = -8;
+    _temp_h_pos = ASTRA_POS(-8);
     _temp_h_trg = OLED_HEIGHT + 8;
     return;
   }
@@ -134,40 +126,41 @@ void astra_draw_info_bar()
   if (!astra_info_bar.is_running) return;
 
   //弹窗到位后才开始计算时间
-  if (astra_info_bar.y_info_bar == astra_info_bar.y_info_bar_trg) astra_info_bar.time = launcher_get_tick_ms();
+  if (astra_info_bar.y_info_bar == ASTRA_POS(astra_info_bar.y_info_bar_trg)) astra_info_bar.time = launcher_get_tick_ms();
 
   //时间到了就收回
   if (astra_info_bar.time - astra_info_bar.time_start >= astra_info_bar.span)
   {
     astra_info_bar.y_info_bar_trg = 0 - 2 * INFO_BAR_HEIGHT; //收回
-    if (astra_info_bar.y_info_bar == astra_info_bar.y_info_bar_trg) astra_info_bar.is_running = false; //等归位后结束生命周期
+    if (astra_info_bar.y_info_bar == ASTRA_POS(astra_info_bar.y_info_bar_trg)) astra_info_bar.is_running = false; //等归位后结束生命周期
   }
 
-  int16_t _x_info_bar = OLED_WIDTH/2 - astra_info_bar.w_info_bar/2;
-  int16_t _y_info_bar_1 = astra_info_bar.y_info_bar - 4;
-  int16_t _y_info_bar_2 = astra_info_bar.y_info_bar + INFO_BAR_HEIGHT;
+  int16_t _w_info_bar = ASTRA_PX(astra_info_bar.w_info_bar);
+  int16_t _x_info_bar = OLED_WIDTH/2 - _w_info_bar/2;
+  int16_t _y_info_bar_1 = ASTRA_PX(astra_info_bar.y_info_bar) - 4;
+  int16_t _y_info_bar_2 = ASTRA_PX(astra_info_bar.y_info_bar) + INFO_BAR_HEIGHT;
 
   astra_set_font(u8g2_font_my_chinese);
   oled_set_draw_color(1);
   oled_draw_R_box(_x_info_bar + 3, _y_info_bar_1 + 3,
-                  (int16_t)astra_info_bar.w_info_bar, INFO_BAR_HEIGHT + 4, 4);
+                  _w_info_bar, INFO_BAR_HEIGHT + 4, 4);
 
   oled_set_draw_color(0); //黑遮罩打底
-  oled_draw_R_box((int16_t)(OLED_WIDTH/2 - (astra_info_bar.w_info_bar + 4)/2), _y_info_bar_1,
-                  (int16_t)(astra_info_bar.w_info_bar + 4), INFO_BAR_HEIGHT + 6, 4);
+  oled_draw_R_box((int16_t)(OLED_WIDTH/2 - (_w_info_bar + 4)/2), _y_info_bar_1,
+                  (int16_t)(_w_info_bar + 4), INFO_BAR_HEIGHT + 6, 4);
 
   oled_set_draw_color(1);
   oled_draw_R_box(_x_info_bar, _y_info_bar_1,
-                  (int16_t)astra_info_bar.w_info_bar, INFO_BAR_HEIGHT + 4, 3);
+                  _w_info_bar, INFO_BAR_HEIGHT + 4, 3);
   //向上移动四个像素 同时向下多画四个像素 只用下半部分圆角
 
   oled_set_draw_color(2);
-  oled_draw_H_line(_x_info_bar + 2, _y_info_bar_2 - 2, (int16_t)(astra_info_bar.w_info_bar - 4));
+  oled_draw_H_line(_x_info_bar + 2, _y_info_bar_2 - 2, (int16_t)(_w_info_bar - 4));
   oled_draw_pixel(_x_info_bar + 1, _y_info_bar_2 - 3);
   oled_draw_pixel(_x_info_bar - 2, _y_info_bar_2 - 3);
 
   oled_draw_UTF8(_x_info_bar + 6,
-                 (int16_t)(astra_info_bar.y_info_bar + oled_get_str_height() - 2),
+                 (int16_t)(ASTRA_PX(astra_info_bar.y_info_bar) + oled_get_str_height() - 2),
                  astra_info_bar.content);
 }
 
@@ -176,40 +169,42 @@ void astra_draw_pop_up()
   if (!astra_pop_up.is_running) return;
 
   //弹窗到位后才开始计算时间
-  if (astra_pop_up.y_pop_up == astra_pop_up.y_pop_up_trg) astra_pop_up.time = launcher_get_tick_ms();
+  if (astra_pop_up.y_pop_up == ASTRA_POS(astra_pop_up.y_pop_up_trg)) astra_pop_up.time = launcher_get_tick_ms();
 
   //时间到了就收回
   if (astra_pop_up.time - astra_pop_up.time_start >= astra_pop_up.span)
   {
     astra_pop_up.y_pop_up_trg = 0 - 2 * INFO_BAR_HEIGHT; //收回
-    if (astra_pop_up.y_pop_up == astra_pop_up.y_pop_up_trg) astra_pop_up.is_running = false; //等归位后结束生命周期
+    if (astra_pop_up.y_pop_up == ASTRA_POS(astra_pop_up.y_pop_up_trg)) astra_pop_up.is_running = false; //等归位后结束生命周期
   }
 
-  int16_t _x_pop_up = OLED_WIDTH/2 - astra_pop_up.w_pop_up/2;
-  int16_t _y_pop_up = astra_pop_up.y_pop_up + POP_UP_HEIGHT;
+  int16_t _w_pop_up = ASTRA_PX(astra_pop_up.w_pop_up);
+  int16_t _y_pop_up_top = ASTRA_PX(astra_pop_up.y_pop_up);
+  int16_t _x_pop_up = OLED_WIDTH/2 - _w_pop_up/2;
+  int16_t _y_pop_up = _y_pop_up_top + POP_UP_HEIGHT;
 
   astra_set_font(u8g2_font_my_chinese);
   oled_set_draw_color(1); //阴影打底
-  oled_draw_R_box(_x_pop_up + 1, (int16_t)astra_pop_up.y_pop_up + 3,
-                  (int16_t)(astra_pop_up.w_pop_up + 4),
+  oled_draw_R_box(_x_pop_up + 1, _y_pop_up_top + 3,
+                  (int16_t)(_w_pop_up + 4),
                   POP_UP_HEIGHT, 4);
 
   oled_set_draw_color(0); //黑遮罩
-  oled_draw_R_box((int16_t)(OLED_WIDTH/2 - (astra_pop_up.w_pop_up + 4)/2 - 2), (int16_t)(astra_pop_up.y_pop_up - 2),
-                  (int16_t)(astra_pop_up.w_pop_up + 8), POP_UP_HEIGHT + 4, 5);
+  oled_draw_R_box((int16_t)(OLED_WIDTH/2 - (_w_pop_up + 4)/2 - 2), (int16_t)(_y_pop_up_top - 2),
+                  (int16_t)(_w_pop_up + 8), POP_UP_HEIGHT + 4, 5);
 
   oled_set_draw_color(1);
-  oled_draw_R_box(_x_pop_up - 2, (int16_t)astra_pop_up.y_pop_up,
-                  (int16_t)(astra_pop_up.w_pop_up + 4),
+  oled_draw_R_box(_x_pop_up - 2, _y_pop_up_top,
+                  (int16_t)(_w_pop_up + 4),
                   POP_UP_HEIGHT, 3);
 
   oled_set_draw_color(2);
-  oled_draw_H_line(_x_pop_up, _y_pop_up - 2, (int16_t)astra_pop_up.w_pop_up);
+  oled_draw_H_line(_x_pop_up, _y_pop_up - 2, _w_pop_up);
   oled_draw_pixel(_x_pop_up - 1, _y_pop_up - 3);
-  oled_draw_pixel((int16_t)(OLED_WIDTH/2 + astra_pop_up.w_pop_up/2), _y_pop_up - 3);
+  oled_draw_pixel((int16_t)(OLED_WIDTH/2 + _w_pop_up/2), _y_pop_up - 3);
 
   oled_draw_UTF8(_x_pop_up + 3,
-                 (int16_t)(astra_pop_up.y_pop_up + oled_get_str_height() + 1),
+                 (int16_t)(_y_pop_up_top + oled_get_str_height() + 1),
                  astra_pop_up.content);
 }
 
@@ -278,8 +273,8 @@ void astra_draw_list_item()
   //selector内包含的item的parent即是当前正在被绘制的页面
   for (unsigned char i = 0; i < astra_selector.selected_item->parent->child_num; i++)
   {
-    int16_t _x_list_item = astra_camera.x_camera + LIST_ITEM_LEFT_MARGIN;
-    int16_t _y_list_item = astra_selector.selected_item->parent->child_list_item[i]->y_list_item + astra_camera.y_camera - oled_get_str_height()/2;
+    int16_t _x_list_item = ASTRA_PX(astra_camera.x_camera) + LIST_ITEM_LEFT_MARGIN;
+    int16_t _y_list_item = ASTRA_PX(astra_selector.selected_item->parent->child_list_item[i]->y_list_item) + ASTRA_PX(astra_camera.y_camera) - oled_get_str_height()/2;
 
     oled_set_draw_color(1);
     //绘制开头的指示器
@@ -365,20 +360,21 @@ void astra_draw_list_item()
 
 void astra_draw_selector()
 {
-  int16_t _x_selector = astra_camera.x_camera + LIST_ITEM_LEFT_MARGIN;
-  int16_t _y_selector = astra_selector.y_selector + astra_camera.y_camera;
+  int16_t _x_selector = ASTRA_PX(astra_camera.x_camera) + LIST_ITEM_LEFT_MARGIN;
+  int16_t _y_selector = ASTRA_PX(astra_selector.y_selector) + ASTRA_PX(astra_camera.y_camera);
+  int16_t _w_selector = ASTRA_PX(astra_selector.w_selector);
+  int16_t _h_selector = ASTRA_PX(astra_selector.h_selector);
 
   oled_set_draw_color(2);
-  oled_draw_box(_x_selector, _y_selector,
-                astra_selector.w_selector, astra_selector.h_selector);
+  oled_draw_box(_x_selector, _y_selector, _w_selector, _h_selector);
 
   //棋盘格过渡
   oled_set_draw_color(1);
-  for (int16_t i = astra_selector.w_selector + _x_selector;
-       i <= astra_selector.w_selector + _x_selector + 7; i += 2)
+  for (int16_t i = _w_selector + _x_selector;
+       i <= _w_selector + _x_selector + 7; i += 2)
   {
     for (int16_t j = _y_selector;
-         j <= _y_selector + astra_selector.h_selector - 1; j++)
+         j <= _y_selector + _h_selector - 1; j++)
     {
       if (j % 2 == 0)
         oled_draw_pixel(i + 1, j);
@@ -4,9 +4,7 @@
 
 #include "astra_ui_item.h"
 
-#include <stdlib.h>
 #include <string.h>
-#include <sys/types.h>
 
 #include "astra_ui_core.h"
 
@@ -15,7 +13,7 @@ void astra_set_font(void *_font)
   if (_font != astra_font) oled_set_font(_font);
 }
 
-astra_info_bar_t astra_info_bar = {0, 1, 0 - 2 * INFO_BAR_HEIGHT, 0 - 2 * INFO_BAR_HEIGHT, 80, 80, false, 0, 1};
+astra_info_bar_t astra_info_bar = {0, 1, ASTRA_POS(0 - 2 * INFO_BAR_HEIGHT), 0 - 2 * INFO_BAR_HEIGHT, ASTRA_POS(80), 80, false, 0, 1};
 
 void astra_push_info_bar(char *_content, const uint16_t _span)
 {
@@ -39,7 +37,7 @@ void astra_push_info_bar(char *_content, const uint16_t _span)
   astra_info_bar.w_info_bar_trg = oled_get_UTF8_width(astra_info_bar.content) + INFO_BAR_OFFSET;
 }
 
-astra_pop_up_t astra_pop_up = {0, 1, 0 - 2 * POP_UP_HEIGHT, 0 - 2 * POP_UP_HEIGHT, 80, 80, false, 0, 1};
+astra_pop_up_t astra_pop_up = {0, 1, ASTRA_POS(0 - 2 * POP_UP_HEIGHT), 0 - 2 * POP_UP_HEIGHT, ASTRA_POS(80), 80, false, 0, 1};
 
 void astra_push_pop_up(char *_content, const uint16_t _span)
 {
@@ -60,8 +58,6 @@ void astra_push_pop_up(char *_content, const uint16_t _span)
   astra_pop_up.w_pop_up_trg = oled_get_UTF8_width(astra_pop_up.content) + POP_UP_OFFSET;
 }
 
-// astra_list_item_t astra_list_item_root = {};
-
 astra_switch_item_t *astra_to_switch_item(astra_list_item_t *_astra_list_item)
 {
   if (_astra_list_item != NULL && _astra_list_item->type == switch_item)
@@ -86,62 +82,93 @@ astra_user_item_t *astra_to_user_item(astra_list_item_t *_astra_list_item)
   return (astra_user_item_t*)astra_get_root_list();
 }
 
-//tips: 不会重复创建root节点
+//root节点静态分配 astra_to_xxx_item()类型不符时返回root 所以按最大的派生类分配
+static astra_item_slot_t astra_list_root_slot = {.list = {.type = list_item, .content = "root"}};
+
 astra_list_item_t *astra_get_root_list()
 {
-  static astra_list_item_t* _astra_list_root_item = NULL;
-  if (_astra_list_root_item == NULL)
-  {
-    _astra_list_root_item = malloc(sizeof(astra_list_item_t));
-    memset(_astra_list_root_item, 0, sizeof(astra_list_item_t));
-    _astra_list_root_item->type = list_item;
-    _astra_list_root_item->content = "root";
-  }
-  return _astra_list_root_item;
+  return &astra_list_root_slot.list;
+}
+
+/*** 菜单项内存池 ***/
+//所有类型的item共用一块编译期确定大小的静态数组 按顺序分配 不使用堆 不回收
+static astra_item_slot_t astra_item_pool[ASTRA_ITEM_POOL_SIZE];
+static uint8_t astra_item_pool_used = 0;
+
+static void *astra_item_pool_alloc()
+{
+  if (astra_item_pool_used >= ASTRA_ITEM_POOL_SIZE) return NULL; //池满 push时会被拒绝
+  return &astra_item_pool[astra_item_pool_used++];
+}
+
+uint8_t astra_get_item_pool_used()
+{
+  return astra_item_pool_used;
+}
+/*** 菜单项内存池 ***/
+
+astra_list_item_t *astra_init_list_item(astra_list_item_t *_item, char *_content)
+{
+  if (_item == NULL) return NULL;
+  memset(_item, 0, sizeof(astra_list_item_t));
+  _item->type = list_item;
+  _item->content = _content;
+  return _item;
+}
+
+astra_list_item_t *astra_init_switch_item(astra_switch_item_t *_item, char *_content, bool *_value)
+{
+  if (_item == NULL) return NULL;
+  memset(_item, 0, sizeof(astra_switch_item_t));
+  _item->base_item.type = switch_item;
+  _item->base_item.content = _content;
+  _item->value = _value;
+  return (astra_list_item_t*)_item;
+}
+
+astra_list_item_t *astra_init_slider_item(astra_slider_item_t *_item, char *_content, int16_t *_value, uint8_t _step, int16_t _min, int16_t _max)
+{
+  if (_item == NULL) return NULL;
+  memset(_item, 0, sizeof(astra_slider_item_t));
+  _item->base_item.type = slider_item;
+  _item->base_item.content = _content;
+  _item->value = _value;
+  _item->value_step = _step;
+  _item->value_min = _min;
+  _item->value_max = _max;
+  return (astra_list_item_t*)_item;
+}
+
+astra_list_item_t *astra_init_user_item(astra_user_item_t *_item, char *_content, void (*_init_function)(), void (*_loop_function)(), void (*_exit_function)())
+{
+  if (_item == NULL) return NULL;
+  memset(_item, 0, sizeof(astra_user_item_t));
+  _item->base_item.type = user_item;
+  _item->base_item.content = _content;
+  _item->init_function = _init_function;
+  _item->loop_function = _loop_function;
+  _item->exit_function = _exit_function;
+  return (astra_list_item_t*)_item;  //转换回基类 但保留专有数据
 }
 
 astra_list_item_t *astra_new_list_item(char *_content)
 {
-  astra_list_item_t *_astra_list_item = malloc(sizeof(astra_list_item_t));
-  memset(_astra_list_item, 0, sizeof(astra_list_item_t));
-  _astra_list_item->type = list_item;
-  _astra_list_item->content = _content;
-  return _astra_list_item;
+  return astra_init_list_item(astra_item_pool_alloc(), _content);
 }
 
 astra_list_item_t *astra_new_switch_item(char *_content, bool *_value)
 {
-  astra_switch_item_t *_astra_switch_item = malloc(sizeof(astra_switch_item_t));
-  memset(_astra_switch_item, 0, sizeof(astra_switch_item_t));
-  _astra_switch_item->base_item.type = switch_item;
-  _astra_switch_item->base_item.content = _content;
-  _astra_switch_item->value = _value;
-  return (astra_list_item_t*)_astra_switch_item;
+  return astra_init_switch_item(astra_item_pool_alloc(), _content, _value);
 }
 
 astra_list_item_t *astra_new_slider_item(char *_content, int16_t *_value, uint8_t _step, int16_t _min, int16_t _max)
 {
-  astra_slider_item_t *_astra_slider_item = malloc(sizeof(astra_slider_item_t));
-  memset(_astra_slider_item, 0, sizeof(astra_slider_item_t));
-  _astra_slider_item->base_item.type = slider_item;
-  _astra_slider_item->base_item.content = _content;
-  _astra_slider_item->value = _value;
-  _astra_slider_item->value_step = _step;
-  _astra_slider_item->value_min = _min;
-  _astra_slider_item->value_max = _max;
-  return (astra_list_item_t*)_astra_slider_item;
+  return astra_init_slider_item(astra_item_pool_alloc(), _content, _value, _step, _min, _max);
 }
 
 astra_list_item_t *astra_new_user_item(char *_content, void (*_init_function)(), void (*_loop_function)(), void (*_exit_function)())
 {
-  astra_user_item_t *_astra_user_item = malloc(sizeof(astra_user_item_t));
-  memset(_astra_user_item, 0, sizeof(astra_user_item_t));
-  _astra_user_item->base_item.type = user_item;
-  _astra_user_item->base_item.content = _content;
-  _astra_user_item->init_function = _init_function;
-  _astra_user_item->loop_function = _loop_function;
-  _astra_user_item->exit_function = _exit_function;
-  return (astra_list_item_t*)_astra_user_item;  //转换回基类 但保留专有数据
+  return astra_init_user_item(astra_item_pool_alloc(), _content, _init_function, _loop_function, _exit_function);
 }
 
 astra_selector_t astra_selector = {};
@@ -169,8 +196,8 @@ bool astra_bind_item_to_selector(astra_list_item_t *_item)
   //坐标在refresh内部更新
   if (astra_selector.selected_item == NULL)
   {
-    astra_selector.y_selector = 2 * SCREEN_HEIGHT;  //给个初始坐标做动画
-    astra_selector.h_selector = 160;
+    astra_selector.y_selector = ASTRA_POS(2 * SCREEN_HEIGHT);  //给个初始坐标做动画
+    astra_selector.h_selector = ASTRA_POS(160);
   }
   astra_selector.selected_index = _temp_index;
   astra_selector.selected_item = _item;
@@ -337,6 +364,7 @@ bool astra_push_item_to_list(astra_list_item_t *_parent, astra_list_item_t *_chi
 
   _child->layer = _parent->layer + 1;
   _child->child_num = 0;
+  _child->parent = _parent; //绑定selector时需要查找父节点
 
   astra_set_font(u8g2_font_my_chinese);
   if (_parent->child_num == 0) _child->y_list_item_trg = oled_get_str_height() + LIST_FONT_TOP_MARGIN - 1;
@@ -349,7 +377,6 @@ bool astra_push_item_to_list(astra_list_item_t *_parent, astra_list_item_t *_chi
   }
 
   _parent->child_list_item[_parent->child_num++] = _child;
-  _child->parent = _parent;
 
   return true;
 }
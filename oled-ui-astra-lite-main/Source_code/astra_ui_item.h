@@ -8,6 +8,14 @@
 #include "astra_ui_draw_driver.h"
 #include <stdbool.h>
 
+/*** 定点坐标 ***/
+//动画中的坐标使用Q8定点数(1/256像素) 目标坐标为整数像素
+typedef int32_t astra_pos_t;
+#define ASTRA_POS_SHIFT 8
+#define ASTRA_POS(_px) ((astra_pos_t)(_px) * (1 << ASTRA_POS_SHIFT)) //像素 -> 定点
+#define ASTRA_PX(_pos) ((int16_t)((_pos) >> ASTRA_POS_SHIFT)) //定点 -> 像素
+/*** 定点坐标 ***/
+
 static void* astra_font;
 extern void astra_set_font(void* _font);
 
@@ -21,7 +29,10 @@ typedef struct astra_info_bar_t
 {
   char *content;
   uint16_t span;
-  float y_info_bar, y_info_bar_trg, w_info_bar, w_info_bar_trg;
+  astra_pos_t y_info_bar;
+  int16_t y_info_bar_trg;
+  astra_pos_t w_info_bar;
+  int16_t w_info_bar_trg;
   bool is_running;
   uint32_t time_start;
   uint32_t time;
@@ -40,7 +51,10 @@ typedef struct astra_pop_up_t
 {
   char *content;
   uint16_t span;
-  float y_pop_up, y_pop_up_trg, w_pop_up, w_pop_up_trg;
+  astra_pos_t y_pop_up;
+  int16_t y_pop_up_trg;
+  astra_pos_t w_pop_up;
+  int16_t w_pop_up_trg;
   bool is_running;
   uint32_t time_start;
   uint32_t time;
@@ -77,7 +91,8 @@ typedef struct astra_list_item_t
   char *content;
 
   uint8_t layer;
-  float y_list_item, y_list_item_trg;
+  astra_pos_t y_list_item;
+  int16_t y_list_item_trg;
   uint8_t child_num;
   struct astra_list_item_t *child_list_item[MAX_LIST_CHILD_NUM];
   struct astra_list_item_t *parent;
@@ -116,11 +131,33 @@ typedef struct astra_user_item_t
   bool user_item_looping;
 } astra_user_item_t;
 
+//各类型item共用的存储单元 按最大的派生类分配
+typedef union astra_item_slot_t
+{
+  astra_list_item_t list;
+  astra_switch_item_t switch_item_data;
+  astra_slider_item_t slider_item_data;
+  astra_user_item_t user_item_data;
+} astra_item_slot_t;
+
+//内存池大小(不含root) 可在编译参数中覆盖
+#ifndef ASTRA_ITEM_POOL_SIZE
+#define ASTRA_ITEM_POOL_SIZE 16
+#endif
+
 extern astra_list_item_t *astra_get_root_list();
+extern uint8_t astra_get_item_pool_used();
+
+//在调用者提供的存储(如全局静态变量)上初始化item 不占用内存池
+extern astra_list_item_t *astra_init_list_item(astra_list_item_t *_item, char *_content);
+extern astra_list_item_t *astra_init_switch_item(astra_switch_item_t *_item, char *_content, bool *_value);
+extern astra_list_item_t *astra_init_slider_item(astra_slider_item_t *_item, char *_content, int16_t *_value, uint8_t _step, int16_t _min, int16_t _max);
+extern astra_list_item_t *astra_init_user_item(astra_user_item_t *_item, char *_content, void (*_init_function)(), void (*_loop_function)(), void (*_exit_function)());
 
 extern astra_switch_item_t *astra_to_switch_item(astra_list_item_t *_astra_list_item);
 extern astra_slider_item_t *astra_to_slider_item(astra_list_item_t *_astra_list_item);
 extern astra_user_item_t *astra_to_user_item(astra_list_item_t *_astra_list_item);
+//从内存池分配 池满时返回NULL(push会失败)
 extern astra_list_item_t *astra_new_list_item(char *_content);
 //正确用法：astra_push_item_to_list(astra_get_root_list(), astra_new_list_item(...));
 extern astra_list_item_t *astra_new_switch_item(char *_content, bool *_value);
@@ -137,7 +174,8 @@ extern bool astra_push_item_to_list(astra_list_item_t *_parent, astra_list_item_
 /*** 选择器 ***/
 typedef struct astra_selector_t
 {
-  float y_selector, y_selector_trg, w_selector, w_selector_trg, h_selector, h_selector_trg;
+  astra_pos_t y_selector, w_selector, h_selector;
+  int16_t y_selector_trg, w_selector_trg, h_selector_trg;
   uint8_t selected_index;
   astra_list_item_t *selected_item;
 } astra_selector_t;
@@ -154,7 +192,10 @@ extern void astra_selector_exit_current_item();
 /*** 相机 ***/
 typedef struct astra_camera_t
 {
-  float x_camera, x_camera_trg, y_camera, y_camera_trg;
+  astra_pos_t x_camera;
+  int16_t x_camera_trg;
+  astra_pos_t y_camera;
+  int16_t y_camera_trg;
   astra_selector_t *selector;
 } astra_camera_t;
 
@@ -0,0 +1,160 @@
+#include "astra_driver.h"
+#include "astra_ui_draw_driver.h"
+
+static Adafruit_SSD1306* g_display = nullptr;
+static OledFlusher* g_flusher = nullptr;
+static uint16_t g_color = SSD1306_WHITE;
+
+void astraDriverAttach(Adafruit_SSD1306* display, OledFlusher* flusher) {
+    g_display = display;
+    g_flusher = flusher;
+}
+
+extern "C" {
+
+void astra_ui_driver_init(void) {
+    // 显示屏由main.cpp初始化，这里只设置文字属性
+    if (g_display == nullptr) {
+        return;
+    }
+    g_display->setTextSize(1);
+    g_display->setTextWrap(false);
+}
+
+uint32_t astra_gfx_get_ticks(void) {
+    return millis();
+}
+
+void astra_gfx_delay(uint32_t ms) {
+    delay(ms);
+}
+
+void astra_gfx_set_font(const void* font) {
+    // 只有GFX内置字体
+}
+
+void astra_gfx_draw_str(int16_t x, int16_t y, const char* str) {
+    if (g_display == nullptr || str == nullptr) {
+        return;
+    }
+    
+    // u8g2坐标为基线，GFX内置字体坐标为字符左上角
+    g_display->setTextColor(g_color);
+    int16_t top = y - ASTRA_FONT_ASCENT;
+    for (const char* p = str; *p != '\0'; p++) {
+        uint8_t c = *p;
+        // UTF-8后续字节不占位置，多字节字符显示为一个'?'
+        if ((c & 0xC0) == 0x80) {
+            continue;
+        }
+        g_display->drawChar(x, top, c < 0x80 ? c : '?', g_color, g_color, 1);
+        x += ASTRA_FONT_WIDTH;
+    }
+}
+
+uint16_t astra_gfx_get_str_width(const char* str) {
+    if (str == nullptr) {
+        return 0;
+    }
+    
+    uint16_t count = 0;
+    for (const char* p = str; *p != '\0'; p++) {
+        if (((uint8_t)*p & 0xC0) != 0x80) {
+            count++;
+        }
+    }
+    return count * ASTRA_FONT_WIDTH;
+}
+
+uint8_t astra_gfx_get_str_height(void) {
+    return ASTRA_FONT_LINE_HEIGHT;
+}
+
+void astra_gfx_draw_pixel(int16_t x, int16_t y) {
+    g_display->drawPixel(x, y, g_color);
+}
+
+void astra_gfx_draw_circle(int16_t x, int16_t y, int16_t r) {
+    g_display->drawCircle(x, y, r, g_color);
+}
+
+void astra_gfx_draw_box(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (w > 0 && h > 0) {
+        g_display->fillRect(x, y, w, h, g_color);
+    }
+}
+
+void astra_gfx_draw_frame(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (w > 0 && h > 0) {
+        g_display->drawRect(x, y, w, h, g_color);
+    }
+}
+
+void astra_gfx_draw_R_box(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r) {
+    if (w > 0 && h > 0) {
+        g_display->fillRoundRect(x, y, w, h, r, g_color);
+    }
+}
+
+void astra_gfx_draw_R_frame(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r) {
+    if (w > 0 && h > 0) {
+        g_display->drawRoundRect(x, y, w, h, r, g_color);
+    }
+}
+
+void astra_gfx_draw_H_line(int16_t x, int16_t y, int16_t l) {
+    g_display->drawFastHLine(x, y, l, g_color);
+}
+
+void astra_gfx_draw_V_line(int16_t x, int16_t y, int16_t h) {
+    g_display->drawFastVLine(x, y, h, g_color);
+}
+
+void astra_gfx_draw_line(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    g_display->drawLine(x1, y1, x2, y2, g_color);
+}
+
+void astra_gfx_draw_H_dotted_line(int16_t x, int16_t y, int16_t l) {
+    for (int16_t i = 0; i < l; i += 2) {
+        g_display->drawPixel(x + i, y, g_color);
+    }
+}
+
+void astra_gfx_draw_V_dotted_line(int16_t x, int16_t y, int16_t h) {
+    for (int16_t i = 0; i < h; i += 2) {
+        g_display->drawPixel(x, y + i, g_color);
+    }
+}
+
+void astra_gfx_draw_bitmap(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t* bitmap) {
+    // u8g2的位图为XBM格式 (每字节低位在左)
+    g_display->drawXBitmap(x, y, bitmap, w, h, g_color);
+}
+
+void astra_gfx_set_draw_color(uint8_t color) {
+    // u8g2的颜色2为异或，对应SSD1306_INVERSE
+    g_color = color == 0 ? SSD1306_BLACK : (color == 1 ? SSD1306_WHITE : SSD1306_INVERSE);
+}
+
+void astra_gfx_clear_buffer(void) {
+    g_display->clearDisplay();
+}
+
+bool astra_gfx_send_buffer(void) {
+    if (g_flusher == nullptr) {
+        g_display->display();
+        return true;
+    }
+    return g_flusher->submit();
+}
+
+bool astra_gfx_send_area_buffer(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // 只发送窗口覆盖的页和列，窗口外的变化留在帧缓冲中
+    if (g_flusher == nullptr) {
+        g_display->display();
+        return true;
+    }
+    return g_flusher->submitArea(x, y, w, h);
+}
+
+}
@@ -0,0 +1,463 @@
+#include "astra_frontend.h"
+#include "astra_driver.h"
+#include "profiler.h"
+
+extern "C" {
+#include "astra_ui_core.h"
+#include "astra_ui_item.h"
+}
+
+// astra以char*保存文本，不能直接使用字符串常量
+static char g_targetTitle[] = "Target Temp";
+static char g_statusTitle[] = "Status";
+static char g_welcome[] = "astra-ui-lite";
+
+// 用户项回调是无参C函数，通过全局指针访问前端
+static AstraFrontend* g_frontend = nullptr;
+
+AstraFrontend::AstraFrontend(Adafruit_SSD1306* _display, OledFlusher* _flusher, UIAdapter* _uiAdapter) {
+    display = _display;
+    flusher = _flusher;
+    uiAdapter = _uiAdapter;
+    initialized = false;
+    active = false;
+    targetSetting = 0;
+    lastFrameTime = 0;
+    inputPending = false;
+    currentTemp = 0.0f;
+    powerPercentage = 0;
+    frameCount = 0;
+    skippedFrames = 0;
+    idleFrames = 0;
+    totalCycles = 0;
+    maxCycles = 0;
+    totalAreaPixels = 0;
+    transferCount = 0;
+    totalTransferTime = 0;
+    maxTransferTime = 0;
+    lastSelector = emptyArea();
+    lastInfoBar = emptyArea();
+    lastPopUp = emptyArea();
+    lastRow = emptyArea();
+    lastSelectedIndex = 0;
+    layoutSettled = false;
+    fullFrame = true;
+    settlePending = false;
+    transferPending = false;
+}
+
+bool AstraFrontend::begin() {
+    g_frontend = this;
+    astraDriverAttach(display, flusher);
+    astra_ui_driver_init();
+    if (!buildMenu()) {
+        Serial.println("astra菜单项内存池不足");
+        return false;
+    }
+    
+    initialized = true;
+    Serial.print("astra前端初始化成功，菜单项 ");
+    Serial.print(astra_get_item_pool_used());
+    Serial.print("/");
+    Serial.println(ASTRA_ITEM_POOL_SIZE);
+    return true;
+}
+
+bool AstraFrontend::buildMenu() {
+    // 菜单项从astra的静态内存池分配，池满时push失败
+    astra_list_item_t* root = astra_get_root_list();
+    bool ok = astra_push_item_to_list(root, astra_new_slider_item(g_targetTitle, &targetSetting, 1, (int16_t)TEMP_MIN, (int16_t)TEMP_MAX));
+    ok = astra_push_item_to_list(root, astra_new_user_item(g_statusTitle, nullptr, statusLoop, nullptr)) && ok;
+    return ok;
+}
+
+void AstraFrontend::statusLoop() {
+    AstraFrontend* self = g_frontend;
+    Adafruit_SSD1306* display = self->display;
+    uint32_t meanCycles = self->frameCount > 0 ? self->totalCycles / self->frameCount : 0;
+    char text[UI_LABEL_LENGTH];
+    
+    // 每帧都重绘，数值在栈上格式化，不经过Print的浮点输出
+    display->setTextSize(1);
+    display->setTextColor(SSD1306_WHITE);
+    display->setCursor(4, 4);
+    TextBuilder(text, sizeof(text)).text("Temp   ").decimal(self->currentTemp, 1).text(" C");
+    display->print(text);
+    display->setCursor(4, 14);
+    TextBuilder(text, sizeof(text)).text("Target ").integer(self->targetSetting).text(" C");
+    display->print(text);
+    display->setCursor(4, 24);
+    TextBuilder(text, sizeof(text)).text("Power  ").integer(self->powerPercentage).text(" %");
+    display->print(text);
+    display->setCursor(4, 40);
+    TextBuilder(text, sizeof(text)).text("Frame avg ").unsignedInteger(profiler.cyclesToMicros(meanCycles)).text("us");
+    display->print(text);
+    display->setCursor(4, 50);
+    TextBuilder(text, sizeof(text)).text("Frame max ").unsignedInteger(profiler.cyclesToMicros(self->maxCycles)).text("us");
+    display->print(text);
+}
+
+void AstraFrontend::enter() {
+    if (!initialized || active) {
+        return;
+    }
+    
+    // 从UIAdapter取当前目标温度
+    targetSetting = lroundf(uiAdapter->getTargetTemp());
+    
+    astra_init_list();
+    in_astra = true;
+    active = true;
+    inputPending = true;
+    lastFrameTime = millis();
+    astra_push_info_bar(g_welcome, 1500);
+    
+    // 屏幕上是UIAdapter的内容，第一帧整屏发送
+    fullFrame = true;
+    settlePending = false;
+    layoutSettled = false;
+    lastSelector = emptyArea();
+    lastInfoBar = emptyArea();
+    lastPopUp = emptyArea();
+    lastRow = emptyArea();
+}
+
+void AstraFrontend::leave() {
+    if (!active) {
+        return;
+    }
+    
+    // 长按可能在用户项或滑块调整中退出，清除选中项的状态，下次进入从列表开始
+    astra_list_item_t* selected = astra_selector.selected_item;
+    if (selected != nullptr && selected->type == user_item) {
+        astra_to_user_item(selected)->in_user_item = false;
+        astra_to_user_item(selected)->entering_user_item = false;
+    } else if (selected != nullptr && selected->type == slider_item) {
+        astra_to_slider_item(selected)->is_confirmed = false;
+    }
+    
+    in_astra = false;
+    active = false;
+    
+    // 帧缓冲内容已被astra改写，UIAdapter整页重绘
+    uiAdapter->redraw();
+}
+
+bool AstraFrontend::isActive() {
+    return active;
+}
+
+void AstraFrontend::setStatus(float current, uint8_t power) {
+    currentTemp = current;
+    powerPercentage = power;
+}
+
+AstraFrontend::Area AstraFrontend::emptyArea() {
+    Area area = {SCREEN_WIDTH, SCREEN_HEIGHT, -1, -1};
+    return area;
+}
+
+void AstraFrontend::unite(Area& area, const Area& other) {
+    if (other.x0 > other.x1 || other.y0 > other.y1) {
+        return;
+    }
+    area.x0 = min(area.x0, other.x0);
+    area.y0 = min(area.y0, other.y0);
+    area.x1 = max(area.x1, other.x1);
+    area.y1 = max(area.y1, other.y1);
+}
+
+AstraFrontend::Area AstraFrontend::selectorArea() {
+    // 与astra_draw_selector()相同，右侧8列为棋盘格过渡
+    int16_t x = ASTRA_PX(astra_camera.x_camera) + LIST_ITEM_LEFT_MARGIN;
+    int16_t y = ASTRA_PX(astra_selector.y_selector) + ASTRA_PX(astra_camera.y_camera);
+    Area area = {x, y, (int16_t)(x + ASTRA_PX(astra_selector.w_selector) + 8),
+                 (int16_t)(y + ASTRA_PX(astra_selector.h_selector) - 1)};
+    return area;
+}
+
+AstraFrontend::Area AstraFrontend::infoBarArea() {
+    if (!astra_info_bar.is_running) {
+        return emptyArea();
+    }
+    
+    // 与astra_draw_info_bar()相同: 黑色底框比信息栏宽4列，阴影向右下偏移3像素
+    int16_t w = ASTRA_PX(astra_info_bar.w_info_bar);
+    int16_t y = ASTRA_PX(astra_info_bar.y_info_bar);
+    int16_t x = OLED_WIDTH / 2 - w / 2;
+    Area area = {(int16_t)(min(OLED_WIDTH / 2 - (w + 4) / 2, x - 2)), (int16_t)(y - 4),
+                 (int16_t)(x + w + 3), (int16_t)(y + INFO_BAR_HEIGHT + 3)};
+    return area;
+}
+
+AstraFrontend::Area AstraFrontend::popUpArea() {
+    if (!astra_pop_up.is_running) {
+        return emptyArea();
+    }
+    
+    // 与astra_draw_pop_up()相同: 黑色底框每边比弹窗宽2像素，阴影向下偏移3像素
+    int16_t w = ASTRA_PX(astra_pop_up.w_pop_up);
+    int16_t y = ASTRA_PX(astra_pop_up.y_pop_up);
+    int16_t x = OLED_WIDTH / 2 - w / 2;
+    Area area = {(int16_t)(OLED_WIDTH / 2 - (w + 4) / 2 - 2), (int16_t)(y - 2),
+                 (int16_t)(x + w + 5), (int16_t)(y + POP_UP_HEIGHT + 3)};
+    return area;
+}
+
+AstraFrontend::Area AstraFrontend::selectedRowArea() {
+    // 选中项整行: 开关状态、滑块数值和调整中的闪烁都画在这一行右侧
+    astra_list_item_t* item = astra_selector.selected_item;
+    int16_t y = ASTRA_PX(item->y_list_item) + ASTRA_PX(astra_camera.y_camera) - oled_get_str_height() / 2;
+    Area area = {0, (int16_t)(y - 4), SCREEN_WIDTH - 1, (int16_t)(y + oled_get_str_height() / 2 + 2)};
+    return area;
+}
+
+bool AstraFrontend::isLayoutSettled() {
+    if (astra_camera.x_camera != ASTRA_POS(astra_camera.x_camera_trg) ||
+        astra_camera.y_camera != ASTRA_POS(astra_camera.y_camera_trg)) {
+        return false;
+    }
+    
+    astra_list_item_t* parent = astra_selector.selected_item->parent;
+    for (uint8_t i = 0; i < parent->child_num; i++) {
+        astra_list_item_t* item = parent->child_list_item[i];
+        if (item->y_list_item != ASTRA_POS(item->y_list_item_trg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AstraFrontend::computeDamage(Area& damage) {
+    Area selector = selectorArea();
+    Area infoBar = infoBarArea();
+    Area popUp = popUpArea();
+    Area row = selectedRowArea();
+    uint8_t selectedIndex = astra_selector.selected_index;
+    
+    // 列表整体移动、退场遮罩或用户项页面 (内容由用户函数整屏绘制) 时整屏发送；
+    // 列表项本帧刚到位时上一帧的位置仍不同，同样整屏
+    astra_list_item_t* selected = astra_selector.selected_item;
+    bool userItem = selected->type == user_item &&
+        (astra_to_user_item(selected)->in_user_item ||
+         astra_to_user_item(selected)->entering_user_item ||
+         astra_to_user_item(selected)->exiting_user_item);
+    bool settled = isLayoutSettled();
+    bool full = fullFrame || !layoutSettled || !settled || !astra_exit_animation_finished || userItem;
+    
+    if (!full) {
+        // 新旧位置的并集
+        damage = emptyArea();
+        unite(damage, lastSelector);
+        unite(damage, selector);
+        unite(damage, lastInfoBar);
+        unite(damage, infoBar);
+        unite(damage, lastPopUp);
+        unite(damage, popUp);
+        unite(damage, lastRow);
+        unite(damage, row);
+        
+        // 右侧进度条随选中序号移动
+        if (selectedIndex != lastSelectedIndex) {
+            Area scrollBar = {OLED_WIDTH - 5, 0, OLED_WIDTH - 1, OLED_HEIGHT - 1};
+            unite(damage, scrollBar);
+        }
+        
+        // 裁剪到屏幕
+        damage.x0 = max(damage.x0, (int16_t)0);
+        damage.y0 = max(damage.y0, (int16_t)0);
+        damage.x1 = min(damage.x1, (int16_t)(SCREEN_WIDTH - 1));
+        damage.y1 = min(damage.y1, (int16_t)(SCREEN_HEIGHT - 1));
+    }
+    
+    lastSelector = selector;
+    lastInfoBar = infoBar;
+    lastPopUp = popUp;
+    lastRow = row;
+    lastSelectedIndex = selectedIndex;
+    layoutSettled = settled;
+    fullFrame = false;
+    return !full;
+}
+
+void AstraFrontend::send(const Area* area) {
+    unsigned long start = micros();
+    if (area == nullptr) {
+        totalAreaPixels += SCREEN_WIDTH * SCREEN_HEIGHT;
+        oled_send_buffer();
+    } else {
+        int16_t w = area->x1 + 1 - area->x0;
+        int16_t h = area->y1 + 1 - area->y0;
+        totalAreaPixels += w * h;
+        oled_send_area_buffer(area->x0, area->y0, w, h);
+    }
+    
+    // 同步发送时直接计时，后台发送在刷新器空闲后读取刷新任务记录的耗时
+    if (flusher == nullptr) {
+        uint32_t elapsed = micros() - start;
+        transferCount++;
+        totalTransferTime += elapsed;
+        if (elapsed > maxTransferTime) {
+            maxTransferTime = elapsed;
+        }
+    } else {
+        transferPending = true;
+    }
+}
+
+void AstraFrontend::collectTransfer() {
+    if (!transferPending || flusher == nullptr || flusher->isBusy()) {
+        return;
+    }
+    
+    uint32_t elapsed = flusher->getLastTransferTime();
+    transferPending = false;
+    transferCount++;
+    totalTransferTime += elapsed;
+    if (elapsed > maxTransferTime) {
+        maxTransferTime = elapsed;
+    }
+}
+
+void AstraFrontend::update() {
+    if (!active) {
+        return;
+    }
+    
+    // 在根菜单退出
+    if (!in_astra) {
+        leave();
+        return;
+    }
+    
+    collectTransfer();
+    
+    // 补间全部到位、没有计时元素且没有新输入时画面不变，不绘制
+    if (!inputPending && astra_ui_is_idle()) {
+        idleFrames++;
+        lastFrameTime = millis();   // 恢复绘制时从一帧的间隔开始推进
+        
+        // 局部发送期间窗口外若有遗漏的变化，在这里整屏提交一次补上
+        if (settlePending && flusher != nullptr && !flusher->isBusy()) {
+            settlePending = false;
+            oled_send_buffer();
+            transferPending = true;
+        }
+        return;
+    }
+    
+    // 上一帧仍在后台传输，本周期不绘制 (动画按经过的时间推进，下一帧追上)
+    if (flusher != nullptr && flusher->isBusy()) {
+        skippedFrames++;
+        return;
+    }
+    
+    uint32_t now = millis();
+    astra_animation_advance(now - lastFrameTime);
+    lastFrameTime = now;
+    inputPending = false;
+    
+    // 每帧清屏后重绘全部内容
+    uint32_t start = ESP.getCycleCount();
+    {
+        PROFILE_ZONE(PROF_ZONE_DRAW);
+        oled_clear_buffer();
+        astra_ui_main_core();
+        astra_ui_widget_core();
+    }
+    uint32_t cycles = ESP.getCycleCount() - start;
+    
+    frameCount++;
+    totalCycles += cycles;
+    if (cycles > maxCycles) {
+        maxCycles = cycles;
+    }
+    
+    // 只发送本帧变化的区域，没有可见变化时不发送
+    Area damage;
+    if (!computeDamage(damage)) {
+        settlePending = false;
+        send(nullptr);
+    } else if (damage.x0 <= damage.x1 && damage.y0 <= damage.y1) {
+        settlePending = true;
+        send(&damage);
+    }
+}
+
+void AstraFrontend::handleInput(const InputEvent& event) {
+    if (!active) {
+        return;
+    }
+    
+    PROFILE_ZONE(PROF_ZONE_HANDLE_INPUT);
+    inputPending = true;
+    
+    switch (event.type) {
+        case EV_ROTATE_CW:
+            for (uint8_t i = 0; i < event.steps; i++) {
+                astra_selector_go_next_item();
+            }
+            break;
+            
+        case EV_ROTATE_CCW:
+            for (uint8_t i = 0; i < event.steps; i++) {
+                astra_selector_go_prev_item();
+            }
+            break;
+            
+        case EV_SINGLE_CLICK:
+            // 进入子菜单/切换开关/开始或确认滑块调整
+            astra_selector_jump_to_selected_item();
+            break;
+            
+        case EV_DOUBLE_CLICK:
+            // 返回上一级，滑块调整中则取消并恢复原值
+            astra_selector_exit_current_item();
+            break;
+            
+        case EV_LONG_PRESS:
+            leave();
+            return;
+            
+        default:
+            break;
+    }
+    
+    // 滑块的修改实时生效
+    if (targetSetting != lroundf(uiAdapter->getTargetTemp())) {
+        uiAdapter->setTargetTemp(targetSetting);
+    }
+}
+
+void AstraFrontend::printStats() {
+    uint32_t meanCycles = frameCount > 0 ? totalCycles / frameCount : 0;
+    
+    Serial.print("ASTRA,");
+    Serial.print(frameCount);
+    Serial.print(",");
+    Serial.print(skippedFrames);
+    Serial.print(",");
+    Serial.print(idleFrames);
+    Serial.print(",");
+    Serial.print(profiler.cyclesToMicros(meanCycles));
+    Serial.print(",");
+    Serial.print(profiler.cyclesToMicros(maxCycles));
+    Serial.print(",");
+    Serial.print(frameCount > 0 ? (uint32_t)(totalAreaPixels * 100 / ((uint64_t)frameCount * SCREEN_WIDTH * SCREEN_HEIGHT)) : 0);
+    Serial.print(",");
+    Serial.print(transferCount > 0 ? (uint32_t)(totalTransferTime / transferCount) : 0);
+    Serial.print(",");
+    Serial.println(maxTransferTime);
+}
+
+void AstraFrontend::resetStats() {
+    frameCount = 0;
+    skippedFrames = 0;
+    idleFrames = 0;
+    totalCycles = 0;
+    maxCycles = 0;
+    totalAreaPixels = 0;
+    transferCount = 0;
+    totalTransferTime = 0;
+    maxTransferTime = 0;
+}
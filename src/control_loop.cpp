@@ -0,0 +1,304 @@
+#include "control_loop.h"
+
+// 记录为命令的位 (其余命令的参数作为TRACE_SETTING记录)
+#define TRACE_COMMAND_MASK (CMD_START | CMD_STOP | CMD_RESET)
+
+ControlLoop::ControlLoop(TempSensor* _sensor, PIDController* _pid, PWMController* _pwm,
+                         HeaterMonitor* _monitor, OutputMap* _outputMap, ControlChannel* _channel) {
+    sensor = _sensor;
+    pid = _pid;
+    pwm = _pwm;
+    monitor = _monitor;
+    outputMap = _outputMap;
+    channel = _channel;
+    recorder = nullptr;
+
+    state = STATE_IDLE;
+    errorCode = ERROR_NONE;
+    errorMessage = "";
+    errorSequence = 0;
+
+    recordingSynced = false;
+    recordedTarget = 0.0f;
+
+    replaying = false;
+    replayTarget = TEMP_DEFAULT;
+    pendingSetting = -1;
+    pendingLow = 0;
+}
+
+void ControlLoop::attachRecorder(TraceRecorder* _recorder) {
+    recorder = _recorder;
+}
+
+void ControlLoop::raiseError(ErrorCode code, const char* message) {
+    state = STATE_ERROR;
+    errorCode = code;
+    pwm->emergencyStop();
+    errorMessage = message;
+    errorSequence++;
+}
+
+void ControlLoop::sampleTemperature(unsigned long now) {
+    // 回放时按原始时间送入记录的ADC码 (两个通道)，代替实际转换
+    if (recorder != nullptr && recorder->isReplaying()) {
+        TraceRecord record;
+        while (recorder->nextReplay(TRACE_SOURCE_SENSOR, now, record)) {
+            if (record.channel == NTC_CHANNEL) {
+                sensor->processRawCode(record.value);
+            } else if (record.channel == SUPPLY_CHANNEL) {
+                sensor->processSupplyCode(record.value);
+            }
+        }
+        return;
+    }
+
+    sensor->sample();
+}
+
+void ControlLoop::sampleSupply() {
+    if (recorder != nullptr && recorder->isReplaying()) {
+        return;
+    }
+
+    sensor->sampleSupplyVoltage();
+}
+
+void ControlLoop::recordSnapshot(float targetTemp, unsigned long now) {
+    double kp, ki, kd;
+    pid->getTunings(&kp, &ki, &kd);
+
+    recorder->recordSetting(TRACE_SETTING_TARGET, targetTemp, now);
+    recorder->recordSetting(TRACE_SETTING_KP, kp, now);
+    recorder->recordSetting(TRACE_SETTING_KI, ki, now);
+    recorder->recordSetting(TRACE_SETTING_KD, kd, now);
+    recorder->recordSetting(TRACE_SETTING_OUTPUT_MODE, pwm->getOutputMode() == PWM_MODE_BURST ? 1.0f : 0.0f, now);
+    recorder->recordSetting(TRACE_SETTING_CALIBRATION, sensor->getCalibration(), now);
+
+    // 记录开始时正在加热，回放从待机开始，补一个开始命令
+    if (state == STATE_WORKING) {
+        recorder->record(TRACE_COMMAND, 0, CMD_START, now);
+    }
+    recordedTarget = targetTemp;
+}
+
+void ControlLoop::recordCommands(uint32_t commands, float targetTemp, unsigned long now) {
+    if (!recordingSynced) {
+        recordSnapshot(targetTemp, now);
+        recordingSynced = true;
+    }
+
+    if (targetTemp != recordedTarget) {
+        recorder->recordSetting(TRACE_SETTING_TARGET, targetTemp, now);
+        recordedTarget = targetTemp;
+    }
+    if (commands & CMD_SET_TUNINGS) {
+        recorder->recordSetting(TRACE_SETTING_KP, channel->kp.load(), now);
+        recorder->recordSetting(TRACE_SETTING_KI, channel->ki.load(), now);
+        recorder->recordSetting(TRACE_SETTING_KD, channel->kd.load(), now);
+    }
+    if (commands & CMD_SET_OUTPUT_MODE) {
+        recorder->recordSetting(TRACE_SETTING_OUTPUT_MODE, channel->burstMode.load() ? 1.0f : 0.0f, now);
+    }
+    if (commands & CMD_SET_CALIBRATION) {
+        recorder->recordSetting(TRACE_SETTING_CALIBRATION, channel->tempOffset.load(), now);
+    }
+    if (commands & TRACE_COMMAND_MASK) {
+        recorder->record(TRACE_COMMAND, 0, commands & TRACE_COMMAND_MASK, now);
+    }
+}
+
+uint32_t ControlLoop::takeReplayCommands(unsigned long now) {
+    uint32_t commands = 0;
+    TraceRecord record;
+    while (recorder->nextReplay(TRACE_SOURCE_CONTROL, now, record)) {
+        if (record.type == TRACE_COMMAND) {
+            commands |= (uint16_t)record.value & TRACE_COMMAND_MASK;
+            continue;
+        }
+
+        // 参数为相邻的两条记录，高16位到达时生效；缓冲区覆盖掉低16位时丢弃高16位
+        if ((record.channel & 1) == 0) {
+            pendingSetting = record.channel;
+            pendingLow = (uint16_t)record.value;
+        } else if (pendingSetting == record.channel - 1) {
+            uint32_t bits = ((uint32_t)(uint16_t)record.value << 16) | pendingLow;
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            applySetting(record.channel / 2, value);
+            pendingSetting = -1;
+        }
+    }
+    return commands;
+}
+
+void ControlLoop::applySetting(uint8_t setting, float value) {
+    double kp, ki, kd;
+    pid->getTunings(&kp, &ki, &kd);
+
+    switch (setting) {
+        case TRACE_SETTING_TARGET:
+            replayTarget = value;
+            break;
+        case TRACE_SETTING_KP:
+            pid->setTunings(value, ki, kd);
+            break;
+        case TRACE_SETTING_KI:
+            pid->setTunings(kp, value, kd);
+            break;
+        case TRACE_SETTING_KD:
+            pid->setTunings(kp, ki, value);
+            break;
+        case TRACE_SETTING_OUTPUT_MODE:
+            pwm->setOutputMode(value != 0.0f ? PWM_MODE_BURST : PWM_MODE_CONTINUOUS);
+            break;
+        case TRACE_SETTING_CALIBRATION:
+            sensor->setCalibration(value);
+            break;
+        default:
+            break;
+    }
+}
+
+void ControlLoop::beginReplay() {
+    replaying = true;
+    replayTarget = channel->targetTemp.load();
+    pendingSetting = -1;
+}
+
+void ControlLoop::endReplay() {
+    replaying = false;
+
+    // 停止回放中开始的加热，参数恢复为UI设定的值
+    if (state == STATE_WORKING) {
+        state = STATE_IDLE;
+    }
+    pwm->disable();
+    pid->setTunings(channel->kp.load(), channel->ki.load(), channel->kd.load());
+    pwm->setOutputMode(channel->burstMode.load() ? PWM_MODE_BURST : PWM_MODE_CONTINUOUS);
+    sensor->setCalibration(channel->tempOffset.load());
+}
+
+void ControlLoop::step(unsigned long now) {
+    // 回放期间控制逻辑照常运行但抑制实际输出；回放结束时先停止加热再解除抑制。
+    // 必须在处理命令之前设置，否则回放开始后第一个START命令会在抑制生效前驱动加热器
+    bool replayActive = recorder != nullptr && recorder->isReplaying();
+    if (replayActive && !replaying) {
+        beginReplay();
+    } else if (!replayActive && replaying) {
+        endReplay();
+    }
+    pwm->setOutputInhibit(replaying);
+
+    // UI发来的命令和目标温度；回放期间由记录代替 (UI的命令照常取出但不生效)
+    uint32_t commands = channel->takeCommands();
+    float targetTemp = channel->targetTemp.load();
+    if (replaying) {
+        commands = takeReplayCommands(now);
+        targetTemp = replayTarget;
+    } else if (recorder != nullptr && recorder->isRecording()) {
+        recordCommands(commands, targetTemp, now);
+    } else {
+        recordingSynced = false;
+    }
+
+    if ((commands & CMD_START) && state == STATE_IDLE) {
+        state = STATE_WORKING;
+        pwm->enable();
+        Serial.println("开始加热");
+    }
+    if ((commands & CMD_STOP) && state == STATE_WORKING) {
+        state = STATE_IDLE;
+        pwm->disable();
+        Serial.println("停止加热");
+    }
+    if ((commands & CMD_RESET) && state == STATE_ERROR) {
+        state = STATE_IDLE;
+        errorCode = ERROR_NONE;
+        monitor->reset();
+        Serial.println("错误重置");
+    }
+    if (commands & CMD_SET_TUNINGS) {
+        pid->setTunings(channel->kp.load(), channel->ki.load(), channel->kd.load());
+    }
+    if (commands & CMD_SET_OUTPUT_MODE) {
+        pwm->setOutputMode(channel->burstMode.load() ? PWM_MODE_BURST : PWM_MODE_CONTINUOUS);
+    }
+    if (commands & CMD_SET_CALIBRATION) {
+        sensor->setCalibration(channel->tempOffset.load());
+    }
+
+    // 读取最近一次采样的温度
+    float currentTemp = sensor->readTemperature();
+
+    // 设置PID控制器的目标温度
+    pid->setTargetTemp(targetTemp);
+
+    // 更新加热器电源电压，用于恒功率补偿
+    pwm->setSupplyVoltage(sensor->readSupplyVoltage());
+
+    // 安全检查
+    if (currentTemp > TEMP_PROTECTION_MAX && state != STATE_ERROR) {
+        // 过温保护
+        raiseError(ERROR_OVERTEMP, "Over temperature");
+    }
+
+    // 加热器故障检测 (开路/MOS常通/传感器脱落)
+    float appliedDuty = pwm->isEnabled() ?
+        (float)pwm->getOutputDutyCycle() / ((1 << PWM_RESOLUTION) - 1) : 0.0f;
+    if (state != STATE_ERROR && monitor->update(currentTemp, appliedDuty, sensor->readSupplyVoltage(), now)) {
+        raiseError(ERROR_HEATER, monitor->getFaultMessage());
+    }
+
+    // 根据系统状态进行处理
+    switch (state) {
+        case STATE_IDLE:
+            // 待机状态
+            if (pwm->isEnabled()) {
+                pwm->disable();
+            }
+            break;
+
+        case STATE_WORKING:
+            // 工作状态
+            // 设置PID输入
+            pid->setCurrentTemp(currentTemp);
+            // 热态PTC满占空比也达不到冷态功率，输出和积分上限随温度下调
+            pid->setOutputLimit(outputMap->maxPower(currentTemp));
+
+            // 计算PID输出
+            if (pid->compute()) {
+                // 更新PWM输出 (PID输出为功率指令，经PTC线性化表转换为占空比)
+                pwm->setDutyCycle(outputMap->powerToDuty(pid->getOutput(), currentTemp));
+            }
+            break;
+
+        case STATE_ERROR:
+            // 错误状态
+            pwm->emergencyStop();
+            break;
+
+        default:
+            break;
+    }
+
+    // 发布本周期遥测帧供UI任务读取 (队列满时丢弃，不阻塞控制周期)
+    TelemetryFrame frame;
+    frame.timestamp = now;
+    frame.currentTemp = currentTemp;
+    frame.targetTemp = targetTemp;
+    frame.supplyVoltage = pwm->getSupplyVoltage();
+    frame.sessionEnergy = pwm->getSessionEnergy();
+    frame.lifetimeEnergy = pwm->getLifetimeEnergy();
+    frame.errorMessage = errorMessage;
+    frame.errorSequence = errorSequence;
+    frame.dutyCycle = pwm->getOutputDutyCycle();
+    frame.powerPercentage = state == STATE_WORKING ? pwm->getPowerPercentage() : 0;
+    frame.systemState = state;
+    frame.errorCode = errorCode;
+    channel->telemetry.push(frame);
+}
+
+SystemState ControlLoop::getState() {
+    return state;
+}
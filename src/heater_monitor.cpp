@@ -0,0 +1,150 @@
+#include "heater_monitor.h"
+#include <math.h>
+
+HeaterMonitor::HeaterMonitor() {
+    reset();
+}
+
+void HeaterMonitor::reset() {
+    initialized = false;
+    lastTemp = 0.0f;
+    lastUpdateTime = 0;
+    
+    ambientTemp = TEMP_DEFAULT;
+    observedRate = 0.0f;
+    expectedRate = 0.0f;
+    
+    idleSupply = 0.0f;
+    loadSupply = 0.0f;
+    idleSupplyValid = false;
+    loadSupplyValid = false;
+    
+    lastDuty = 0.0f;
+    dutyChangeTime = 0;
+    
+    suspectFault = HEATER_FAULT_NONE;
+    suspectTime = 0;
+    fault = HEATER_FAULT_NONE;
+}
+
+bool HeaterMonitor::update(float temp, float duty, float supplyVoltage, unsigned long now) {
+    // 故障已确认，保持直到重置
+    if (fault != HEATER_FAULT_NONE) {
+        return true;
+    }
+    
+    // 首次调用，以当前温度作为环境温度初值
+    if (!initialized) {
+        lastTemp = temp;
+        ambientTemp = temp;
+        lastUpdateTime = now;
+        lastDuty = duty;
+        dutyChangeTime = now;
+        initialized = true;
+        return false;
+    }
+    
+    // 检查检测间隔
+    unsigned long elapsed = now - lastUpdateTime;
+    if (elapsed < HEATER_MONITOR_INTERVAL) {
+        return false;
+    }
+    lastUpdateTime = now;
+    float dt = elapsed / 1000.0f;
+    
+    // 输出在关断/高占空比区间之间切换时，重新开始热滞后宽限期
+    bool isOff = duty <= 0.0f;
+    bool isHigh = duty >= HEATER_FAULT_HIGH_DUTY;
+    bool enteredHigh = isHigh && lastDuty < HEATER_FAULT_HIGH_DUTY;
+    if (isOff != (lastDuty <= 0.0f) || isHigh != (lastDuty >= HEATER_FAULT_HIGH_DUTY)) {
+        dutyChangeTime = now;
+    }
+    lastDuty = duty;
+    
+    // 一阶热模型的预期温升速率
+    float modelRate = (HEATER_MODEL_GAIN * duty - (temp - ambientTemp)) / HEATER_MODEL_TAU;
+    float rawRate = (temp - lastTemp) / dt;
+    lastTemp = temp;
+    
+    // 实测与预期使用相同的指数滤波，保证两者滞后一致
+    float alpha = dt / (HEATER_RATE_FILTER_TIME + dt);
+    observedRate += alpha * (rawRate - observedRate);
+    expectedRate += alpha * (modelRate - expectedRate);
+    
+    // 输出关断且温度平稳时，缓慢跟踪环境温度
+    if (isOff && fabsf(observedRate) < HEATER_AMBIENT_STABLE_RATE) {
+        ambientTemp += alpha * (temp - ambientTemp);
+    }
+    
+    // 关断时和高占空比时的电源电压，每次进入高占空比后从第一个有效采样开始滤波
+    bool supplyValid = supplyVoltage >= SUPPLY_VOLTAGE_MIN;
+    if (enteredHigh) {
+        loadSupplyValid = false;
+    }
+    if (supplyValid && isOff) {
+        idleSupply = idleSupplyValid ? idleSupply + alpha * (supplyVoltage - idleSupply) : supplyVoltage;
+        idleSupplyValid = true;
+    } else if (supplyValid && isHigh) {
+        loadSupply = loadSupplyValid ? loadSupply + alpha * (supplyVoltage - loadSupply) : supplyVoltage;
+        loadSupplyValid = true;
+    }
+    
+    // 判定疑似故障
+    HeaterFault candidate = HEATER_FAULT_NONE;
+    if (now - dutyChangeTime >= HEATER_FAULT_SETTLE_TIME) {
+        if (isOff) {
+            // 零输出仍持续升温: MOS管常通
+            if (observedRate > HEATER_FAULT_STUCK_RATE) {
+                candidate = HEATER_FAULT_STUCK_ON;
+            }
+        } else if (isHigh && expectedRate > HEATER_FAULT_MIN_EXPECTED_RATE) {
+            // 高占空比下温升远低于预期: 加热器开路或传感器脱离加热器
+            float ratio = observedRate / expectedRate;
+            if (ratio < HEATER_FAULT_DETACHED_RATIO) {
+                candidate = classifyNoResponse(ratio, supplyValid);
+            }
+        }
+    }
+    
+    // 疑似故障需持续一段时间才确认
+    if (candidate != suspectFault) {
+        suspectFault = candidate;
+        suspectTime = now;
+        return false;
+    }
+    
+    if (candidate != HEATER_FAULT_NONE && now - suspectTime >= HEATER_FAULT_CONFIRM_TIME) {
+        fault = candidate;
+        return true;
+    }
+    
+    return false;
+}
+
+HeaterFault HeaterMonitor::classifyNoResponse(float ratio, bool supplyValid) {
+    // 有电源电压时按压降判断加热器是否有电流
+    if (HEATER_LOAD_DROOP_MIN > 0.0f && supplyValid && idleSupplyValid && loadSupplyValid) {
+        float droop = idleSupply - loadSupply;
+        return droop >= HEATER_LOAD_DROOP_MIN ? HEATER_FAULT_SENSOR_DETACHED : HEATER_FAULT_OPEN;
+    }
+    
+    // 否则按温升比例: 完全无响应为开路，响应微弱为传感器脱落
+    return ratio < HEATER_FAULT_OPEN_RATIO ? HEATER_FAULT_OPEN : HEATER_FAULT_SENSOR_DETACHED;
+}
+
+HeaterFault HeaterMonitor::getFault() {
+    return fault;
+}
+
+const char* HeaterMonitor::getFaultMessage() {
+    switch (fault) {
+        case HEATER_FAULT_OPEN:
+            return "Heater open";
+        case HEATER_FAULT_STUCK_ON:
+            return "Heater stuck on";
+        case HEATER_FAULT_SENSOR_DETACHED:
+            return "Sensor detached";
+        default:
+            return "Heater fault";
+    }
+}
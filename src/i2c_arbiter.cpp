@@ -0,0 +1,132 @@
+#include "i2c_arbiter.h"
+
+I2CArbiter::I2CArbiter() : highPriorityWaiting(0) {
+    mutex = nullptr;
+    sensorDone = nullptr;
+    statsStartTime = 0;
+    
+    for (int i = 0; i < I2C_CLIENT_COUNT; i++) {
+        stats[i] = {0, 0, 0, 0};
+        holdStartTime[i] = 0;
+    }
+}
+
+bool I2CArbiter::begin() {
+    mutex = xSemaphoreCreateMutex();
+    sensorDone = xSemaphoreCreateBinary();
+    if (mutex == nullptr || sensorDone == nullptr) {
+        Serial.println("I2C总线互斥锁创建失败");
+        mutex = nullptr;
+        return false;
+    }
+    
+    statsStartTime = millis();
+    Serial.println("I2C总线仲裁器初始化成功");
+    return true;
+}
+
+void I2CArbiter::acquire(I2CClient client) {
+    // 未初始化时只有单个执行流访问总线，无需仲裁
+    if (mutex == nullptr) {
+        return;
+    }
+    
+    unsigned long start = micros();
+    
+    if (client == I2C_CLIENT_SENSOR) {
+        highPriorityWaiting.fetch_add(1);
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        highPriorityWaiting.fetch_sub(1);
+    } else {
+        for (;;) {
+            // 传感器在等待时阻塞到其事务结束 (等待时间不超过一个传输块)，期间其他任务照常运行；
+            // 每次传感器释放都会给出信号，醒来后重新检查，先前遗留的信号只会多循环一次
+            while (highPriorityWaiting.load() > 0) {
+                xSemaphoreTake(sensorDone, portMAX_DELAY);
+            }
+            
+            xSemaphoreTake(mutex, portMAX_DELAY);
+            if (highPriorityWaiting.load() == 0) {
+                break;
+            }
+            
+            // 取锁期间传感器开始等待，立即归还
+            xSemaphoreGive(mutex);
+        }
+    }
+    
+    // 以下统计在持有总线时更新，无需额外保护
+    unsigned long now = micros();
+    uint32_t wait = now - start;
+    stats[client].waitTime += wait;
+    if (wait > stats[client].maxWait) {
+        stats[client].maxWait = wait;
+    }
+    holdStartTime[client] = now;
+}
+
+void I2CArbiter::release(I2CClient client) {
+    if (mutex == nullptr) {
+        return;
+    }
+    
+    stats[client].busyTime += micros() - holdStartTime[client];
+    stats[client].transactions++;
+    
+    xSemaphoreGive(mutex);
+    
+    // 唤醒等待传感器事务结束的显示客户端
+    if (client == I2C_CLIENT_SENSOR) {
+        xSemaphoreGive(sensorDone);
+    }
+}
+
+float I2CArbiter::getUtilization() {
+    float total = 0.0f;
+    for (int i = 0; i < I2C_CLIENT_COUNT; i++) {
+        total += getClientUtilization((I2CClient)i);
+    }
+    return total;
+}
+
+float I2CArbiter::getClientUtilization(I2CClient client) {
+    unsigned long window = millis() - statsStartTime;
+    if (window == 0) {
+        return 0.0f;
+    }
+    
+    return (float)stats[client].busyTime / (window * 10.0f);
+}
+
+uint32_t I2CArbiter::getWorstWait(I2CClient client) {
+    return stats[client].maxWait;
+}
+
+void I2CArbiter::resetStats() {
+    // 持有总线时清零，避免与正在进行的统计更新交错
+    if (mutex != nullptr) {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+    }
+    
+    for (int i = 0; i < I2C_CLIENT_COUNT; i++) {
+        stats[i] = {0, 0, 0, 0};
+    }
+    statsStartTime = millis();
+    
+    if (mutex != nullptr) {
+        xSemaphoreGive(mutex);
+    }
+}
+
+void I2CArbiter::printStats() {
+    Serial.print("I2C,");
+    Serial.print(getUtilization(), 1);
+    Serial.print(",");
+    Serial.print(getClientUtilization(I2C_CLIENT_SENSOR), 1);
+    Serial.print(",");
+    Serial.print(getWorstWait(I2C_CLIENT_SENSOR));
+    Serial.print(",");
+    Serial.print(getClientUtilization(I2C_CLIENT_DISPLAY), 1);
+    Serial.print(",");
+    Serial.println(getWorstWait(I2C_CLIENT_DISPLAY));
+}
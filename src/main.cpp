@@ -1,26 +1,368 @@
 #include <Arduino.h>
 #include <Wire.h>
+#include <EEPROM.h>
 #include "config.h"
 #include "temp_sensor.h"
 #include "pid_controller.h"
 #include "pwm_controller.h"
+#include "heater_monitor.h"
+#include "output_map.h"
+#include "control_loop.h"
 #include "user_input.h"
 #include "ui_adapter.h"
+#include "astra_frontend.h"
+#include "control_channel.h"
+#include "i2c_arbiter.h"
+#include "oled_flusher.h"
+#include "scheduler.h"
+#include "power_manager.h"
+#include "profiler.h"
+#include "serial_console.h"
+#include "trace_recorder.h"
+#include "temp_trend.h"
 
 // 模块实例
+I2CArbiter i2cArbiter;
+PowerManager powerManager;
 TempSensor tempSensor;
 PIDController pidController;
 PWMController pwmController;
+HeaterMonitor heaterMonitor;
+OutputMap outputMap;
 UserInput userInput;
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
-UIAdapter uiAdapter(&display, &tempSensor, &pidController, &pwmController, &userInput);
+OledFlusher oledFlusher(&display, &Wire, &i2cArbiter, OLED_ADDR);
+UIAdapter uiAdapter(&display, &userInput);
+AstraFrontend astraFrontend(&display, &oledFlusher, &uiAdapter);
 
-// 系统状态
-SystemState systemState = STATE_IDLE;
-ErrorCode errorCode = ERROR_NONE;
+// 控制任务与UI任务之间的数据通道
+ControlChannel controlChannel;
 
-// 系统运行时间标记
-unsigned long lastSystemStatusUpdateTime = 0;
+// 控制回路 (控制任务，系统状态只由它修改)
+ControlLoop controlLoop(&tempSensor, &pidController, &pwmController, &heaterMonitor, &outputMap, &controlChannel);
+
+// 每个任务一个调度器
+Scheduler controlScheduler("control");
+Scheduler uiScheduler("ui");
+int8_t renderJobIndex = -1;     // 显示刷新任务编号 (astra激活时缩短周期)
+
+// 串口命令行 (UI任务)
+SerialConsole serialConsole;
+
+// 现场记录/回放
+TraceRecorder traceRecorder;
+
+// 温度趋势记录 (UI任务)
+TempTrend tempTrend;
+
+// UI任务数据: 最近一帧遥测
+TelemetryFrame telemetry = {};
+uint32_t lastErrorSequence = 0;
+
+// 从EEPROM恢复累计能耗
+void loadEnergyCounter() {
+  double lifetimeEnergy;
+  EEPROM.get(EEPROM_ENERGY_LIFETIME_ADDR, lifetimeEnergy);
+  
+  // 未写入过的EEPROM为0xFF，检查是否有效
+  if (isnan(lifetimeEnergy) || lifetimeEnergy < 0.0 || lifetimeEnergy > 1e9) {
+    lifetimeEnergy = 0.0;
+  }
+  
+  pwmController.setLifetimeEnergy(lifetimeEnergy);
+  telemetry.lifetimeEnergy = lifetimeEnergy;
+}
+
+// 保存累计能耗到EEPROM (UI任务，同时作为定期保存任务)
+void saveEnergyCounter(void* context = nullptr) {
+  EEPROM.put(EEPROM_ENERGY_LIFETIME_ADDR, telemetry.lifetimeEnergy);
+  EEPROM.commit();
+}
+
+// 输出串口遥测数据 (UI任务)
+void printTelemetry(void* context) {
+  Serial.print("TEL,");
+  Serial.print(telemetry.timestamp);
+  Serial.print(",");
+  Serial.print(telemetry.currentTemp, 2);
+  Serial.print(",");
+  Serial.print(telemetry.targetTemp, 1);
+  Serial.print(",");
+  Serial.print(telemetry.powerPercentage);
+  Serial.print(",");
+  Serial.print(telemetry.supplyVoltage, 2);
+  Serial.print(",");
+  Serial.print(telemetry.sessionEnergy, 3);
+  Serial.print(",");
+  Serial.println(telemetry.lifetimeEnergy, 3);
+}
+
+// 温度采样任务
+void sampleJob(void* context) {
+  controlLoop.sampleTemperature(millis());
+}
+
+// 电源电压采样任务
+void supplyJob(void* context) {
+  controlLoop.sampleSupply();
+}
+
+// 控制任务: 处理命令、安全检查、PID计算和PWM输出 (与主机端回放测试共用ControlLoop)
+void controlJob(void* context) {
+  controlLoop.step(millis());
+  
+  // 加热器工作期间禁止降频和light sleep (LEDC输出依赖APB时钟)
+  powerManager.setHeaterActive(pwmController.isEnabled());
+}
+
+// 输入任务: 同步控制状态、处理输入
+void inputJob(void* context) {
+  // 取出控制任务发布的全部遥测帧，保留最新一帧
+  while (controlChannel.telemetry.pop(telemetry)) {
+    // 每个控制周期一帧，全部记入趋势
+    tempTrend.addSample(telemetry.currentTemp);
+    
+    // 控制任务产生了新错误，切换到错误页面
+    if (telemetry.errorSequence != lastErrorSequence) {
+      lastErrorSequence = telemetry.errorSequence;
+      astraFrontend.leave();
+      uiAdapter.showError((ErrorCode)telemetry.errorCode, telemetry.errorMessage);
+    }
+  }
+  
+  // 同步控制任务状态到UI，并把UI设定的目标温度交给控制任务
+  SystemState state = (SystemState)telemetry.systemState;
+  float targetTemp = uiAdapter.getTargetTemp();
+  controlChannel.targetTemp.store(targetTemp);
+  uiAdapter.setTemperature(telemetry.currentTemp, targetTemp);
+  uiAdapter.setPowerPercentage(telemetry.powerPercentage);
+  uiAdapter.setEnergy(telemetry.sessionEnergy, telemetry.lifetimeEnergy);
+  uiAdapter.setSystemState(state);
+  astraFrontend.setStatus(telemetry.currentTemp, telemetry.powerPercentage);
+  
+  // 回放: 按原始时间注入记录的按钮边沿和旋转，全部送完后退出回放
+  if (traceRecorder.isReplaying()) {
+    TraceRecord record;
+    while (traceRecorder.nextReplay(TRACE_SOURCE_INPUT, millis(), record)) {
+      if (record.type == TRACE_BUTTON) {
+        ButtonEdge edge;
+        edge.timestamp = record.timestamp;
+        edge.level = record.value;
+        userInput.injectEdge(edge);
+      } else {
+        userInput.injectRotation(record.value, record.timestamp);
+      }
+    }
+    if (traceRecorder.replayFinished()) {
+      traceRecorder.stop();
+      userInput.setReplayMode(false);
+    }
+  }
+  
+  // 处理用户输入，依次分发全部事件
+  userInput.update();
+  InputEvent event;
+  while ((event = userInput.getEvent()).type != EV_NONE) {
+    // astra前端激活时全部输入交给astra
+    if (astraFrontend.isActive()) {
+      astraFrontend.handleInput(event);
+      continue;
+    }
+    
+    // 加热命令 (单击开始/双击停止/错误时长按复位)，已处理的事件不再交给UI
+    if (uiAdapter.handleControlInput(event)) {
+      // 停止加热时保存累计能耗
+      if (event.type == EV_DOUBLE_CLICK) {
+        saveEnergyCounter();
+      }
+      continue;
+    }
+    
+    // 主界面长按切换到astra前端
+    if (event.type == EV_LONG_PRESS && state != STATE_ERROR && uiAdapter.getPage() == UI_PAGE_MAIN) {
+      astraFrontend.enter();
+      continue;
+    }
+    
+    // 处理UI相关输入
+    uiAdapter.handleInput(event);
+  }
+}
+
+// 显示刷新任务
+void renderJob(void* context) {
+  if (astraFrontend.isActive()) {
+    astraFrontend.update();
+  } else {
+    uiAdapter.update();
+  }
+  
+  // astra按帧插值动画，激活期间提高刷新频率；UIAdapter变化驱动，保持原周期，
+  // 有帧因刷新器忙未提交时按UI任务轮询周期重试，传输一结束就提交
+  uint32_t period;
+  if (astraFrontend.isActive()) {
+    period = ASTRA_FRAME_INTERVAL;
+  } else if (uiAdapter.hasPendingFrame()) {
+    period = UI_TASK_PERIOD_MS;
+  } else {
+    period = UI_REFRESH_INTERVAL;
+  }
+  uiScheduler.setPeriod(renderJobIndex, period, period);
+}
+
+// 统计输出任务: I2C总线、OLED刷新、UI绘制 (每个窗口重新计数) 和调度器
+void statsJob(void* context) {
+  i2cArbiter.printStats();
+  i2cArbiter.resetStats();
+  oledFlusher.printStats();
+  oledFlusher.resetStats();
+  uiAdapter.printStats();
+  uiAdapter.resetStats();
+  astraFrontend.printStats();
+  astraFrontend.resetStats();
+  controlScheduler.printStats();
+  uiScheduler.printStats();
+  powerManager.printStats(&controlScheduler, &uiScheduler);
+}
+
+// 串口命令任务
+void consoleJob(void* context) {
+  serialConsole.poll();
+}
+
+// 串口命令: prof [reset]
+void profCommand(const char* args) {
+  if (strcmp(args, "reset") == 0) {
+    profiler.reset();
+    Serial.println("性能统计已清零");
+  } else {
+    profiler.printStats();
+  }
+}
+
+// 串口命令: trace rec|stop|dump|clear|play|put <记录>
+void traceCommand(const char* args) {
+  if (strcmp(args, "rec") == 0) {
+    if (traceRecorder.isReplaying()) {
+      Serial.println("回放中，无法记录");
+      return;
+    }
+    traceRecorder.startRecording();
+  } else if (strcmp(args, "stop") == 0) {
+    if (traceRecorder.isReplaying()) {
+      userInput.setReplayMode(false);
+    }
+    traceRecorder.stop();
+  } else if (strcmp(args, "dump") == 0) {
+    traceRecorder.dump();
+  } else if (strcmp(args, "clear") == 0) {
+    if (traceRecorder.isRecording() || traceRecorder.isReplaying()) {
+      Serial.println("请先 trace stop");
+      return;
+    }
+    traceRecorder.clear();
+    Serial.println("记录已清空");
+  } else if (strcmp(args, "play") == 0) {
+    // 只从待机状态开始回放，保证与记录时的起始条件一致
+    if ((SystemState)telemetry.systemState != STATE_IDLE) {
+      Serial.println("仅在待机状态下回放");
+      return;
+    }
+    if (traceRecorder.startReplay(millis())) {
+      userInput.setReplayMode(true);
+    } else {
+      Serial.println("没有可回放的记录");
+    }
+  } else if (strncmp(args, "put ", 4) == 0) {
+    // 上传 trace dump 输出的记录 (去掉 "TRC," 前缀)
+    TraceRecord record;
+    if (!TraceRecorder::parseRecord(args + 4, record) || !traceRecorder.append(record)) {
+      Serial.println("TRC,ERR");
+    }
+  } else {
+    Serial.print("记录条数: ");
+    Serial.println(traceRecorder.getCount());
+    Serial.println(traceRecorder.isRecording() ? "记录中" : (traceRecorder.isReplaying() ? "回放中" : "空闲"));
+  }
+}
+
+// 串口命令: ui astra|classic
+void uiCommand(const char* args) {
+  if (strcmp(args, "astra") == 0) {
+    if ((SystemState)telemetry.systemState == STATE_ERROR) {
+      Serial.println("错误状态下不能切换");
+      return;
+    }
+    uiAdapter.setPage(UI_PAGE_MAIN);
+    astraFrontend.enter();
+  } else if (strcmp(args, "classic") == 0) {
+    astraFrontend.leave();
+  } else {
+    Serial.println(astraFrontend.isActive() ? "astra" : "classic");
+  }
+}
+
+// 串口命令: page bench [次数] | page snap [页面]
+void pageCommand(const char* args) {
+  // 离屏绘制会改写帧缓冲，astra前端激活时不与其争用
+  if (astraFrontend.isActive()) {
+    Serial.println("请先 ui classic");
+    return;
+  }
+  
+  if (strncmp(args, "bench", 5) == 0) {
+    long iterations = args[5] == ' ' ? atol(args + 6) : UI_BENCH_ITERATIONS;
+    if (iterations <= 0 || iterations > UI_BENCH_MAX_ITERATIONS) {
+      Serial.print("次数范围 1-");
+      Serial.println(UI_BENCH_MAX_ITERATIONS);
+      return;
+    }
+    uiAdapter.benchmark(iterations);
+  } else if (strncmp(args, "snap", 4) == 0) {
+    UIPage page = uiAdapter.getPage();
+    if (args[4] == ' ' && !UIAdapter::findPage(args + 5, &page)) {
+      Serial.println("页面: main|menu|pid|cal|info|prof|trend|error");
+      return;
+    }
+    uiAdapter.snapshot(page);
+  } else {
+    Serial.println(UIAdapter::getPageName(uiAdapter.getPage()));
+  }
+}
+
+// 注册串口命令
+void setupConsole() {
+  serialConsole.addCommand("prof", "性能统计 (prof reset 清零)", profCommand);
+  serialConsole.addCommand("trace", "记录/回放 (rec|stop|dump|clear|play|put)", traceCommand);
+  serialConsole.addCommand("ui", "切换前端 (astra|classic)", uiCommand);
+  serialConsole.addCommand("page", "页面绘制测试 (bench [次数]|snap [页面])", pageCommand);
+}
+
+// 注册周期任务 (周期, 相位, 优先级, 截止期限)
+void setupSchedulers() {
+  // 控制任务: 采样后再计算，电压采样错开温度采样
+  controlScheduler.addJob("control", controlJob, nullptr, PID_COMPUTE_INTERVAL, CONTROL_PHASE_MS, 3, PID_COMPUTE_INTERVAL / 2);
+  controlScheduler.addJob("sample", sampleJob, nullptr, TEMP_SAMPLE_INTERVAL, 0, 2, TEMP_SAMPLE_INTERVAL / 2);
+  controlScheduler.addJob("supply", supplyJob, nullptr, SUPPLY_SAMPLE_INTERVAL, SUPPLY_PHASE_MS, 1, SUPPLY_SAMPLE_INTERVAL / 2);
+  
+  // UI任务: 输入响应优先于显示刷新，日志和保存优先级最低
+  uiScheduler.addJob("input", inputJob, nullptr, UI_TASK_PERIOD_MS, 0, 4, UI_TASK_PERIOD_MS * 2);
+  renderJobIndex = uiScheduler.addJob("render", renderJob, nullptr, UI_REFRESH_INTERVAL, UI_TASK_PERIOD_MS / 2, 3, UI_REFRESH_INTERVAL);
+  uiScheduler.addJob("telemetry", printTelemetry, nullptr, TELEMETRY_INTERVAL, 0, 2, TELEMETRY_INTERVAL);
+  uiScheduler.addJob("energy", saveEnergyCounter, nullptr, ENERGY_SAVE_INTERVAL, ENERGY_SAVE_INTERVAL, 1, ENERGY_SAVE_INTERVAL);
+  uiScheduler.addJob("stats", statsJob, nullptr, STATS_INTERVAL, STATS_INTERVAL, 1, STATS_INTERVAL);
+  uiScheduler.addJob("console", consoleJob, nullptr, CONSOLE_POLL_INTERVAL, 0, 1, CONSOLE_POLL_INTERVAL);
+}
+
+// 控制任务: 高优先级，固定周期运行，不受UI刷新耗时影响
+void controlTask(void* param) {
+  controlScheduler.run();
+}
+
+// UI任务: 输入、显示和日志
+void uiTask(void* param) {
+  uiScheduler.run();
+}
 
 void setup() {
   // 初始化串口
@@ -28,10 +370,24 @@ void setup() {
   Serial.println("\n\n" SYSTEM_NAME " v" SYSTEM_VERSION);
   Serial.println("系统启动中...");
   
+  // 初始化EEPROM
+  EEPROM.begin(EEPROM_SIZE);
+  
   // 初始化I2C
   Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
   Wire.setClock(400000); // 设置为400kHz
   
+  // 初始化I2C总线仲裁 (ADS1115与OLED共用总线)
+  i2cArbiter.begin();
+  tempSensor.attachBus(&i2cArbiter);
+  tempSensor.attachReadyPin(ADS_READY_PIN);
+  tempSensor.attachRecorder(&traceRecorder);
+  controlLoop.attachRecorder(&traceRecorder);
+  userInput.attachRecorder(&traceRecorder);
+  uiAdapter.attachFlusher(&oledFlusher);
+  uiAdapter.attachTrend(&tempTrend);
+  uiAdapter.attachControl(&controlChannel);
+  
   // 初始化模块
   Serial.println("初始化硬件模块...");
   
@@ -53,11 +409,14 @@ void setup() {
   display.setCursor(0, 32);
   display.println("Initializing...");
   display.display();
+  oledFlusher.invalidate();  // 启动画面绕过了刷新器，第一帧整屏发送
+  oledFlusher.begin();
   
   // 初始化温度传感器
+  ErrorCode startupError = ERROR_NONE;
   if (!tempSensor.begin()) {
     Serial.println("温度传感器初始化失败!");
-    errorCode = ERROR_TEMP_SENSOR;
+    startupError = ERROR_TEMP_SENSOR;
   }
   
   // 初始化PID控制器
@@ -70,6 +429,16 @@ void setup() {
     Serial.println("PWM控制器初始化失败!");
   }
   
+  // 菜单编辑参数时以控制通道中的值为起点 (任务启动前，此后UI只经控制通道读写)
+  double kp, ki, kd;
+  pidController.getTunings(&kp, &ki, &kd);
+  controlChannel.kp.store(kp);
+  controlChannel.ki.store(ki);
+  controlChannel.kd.store(kd);
+  controlChannel.burstMode.store(pwmController.getOutputMode() == PWM_MODE_BURST);
+  controlChannel.tempOffset.store(tempSensor.getCalibration());
+  loadEnergyCounter();
+  
   // 初始化用户输入
   if (!userInput.begin()) {
     Serial.println("用户输入初始化失败!");
@@ -79,131 +448,40 @@ void setup() {
   if (!uiAdapter.begin()) {
     Serial.println("UI适配器初始化失败!");
   }
+  if (!astraFrontend.begin()) {
+    Serial.println("astra前端初始化失败!");
+  }
   
   // 如果有错误，更新UI显示
-  if (errorCode != ERROR_NONE) {
-    systemState = STATE_ERROR;
-    if (errorCode == ERROR_TEMP_SENSOR) {
-      uiAdapter.showError(errorCode, "Temp sensor error");
-    }
+  if (startupError == ERROR_TEMP_SENSOR) {
+    uiAdapter.showError(startupError, "Temp sensor error");
   }
   
   // 初始状态设置
-  systemState = STATE_IDLE;
-  uiAdapter.setSystemState(systemState);
+  uiAdapter.setSystemState(controlLoop.getState());
+  controlChannel.targetTemp.store(uiAdapter.getTargetTemp());
   
   Serial.println("系统初始化完成!");
   Serial.println("单击启动, 双击停止, 长按进入菜单");
   
   // 等待2秒，让用户看到启动画面
   delay(2000);
-}
-
-void loop() {
-  // 获取当前时间
-  unsigned long currentTime = millis();
-  
-  // 读取温度
-  float currentTemp = tempSensor.readTemperature();
-  float targetTemp = uiAdapter.getTargetTemp(); // 从UI获取目标温度
-  
-  // 设置PID控制器的目标温度
-  pidController.setTargetTemp(targetTemp);
   
-  // 更新UI显示的温度信息
-  uiAdapter.setTemperature(currentTemp, targetTemp);
-  
-  // 每200ms更新一次系统状态
-  if (currentTime - lastSystemStatusUpdateTime >= 200) {
-    lastSystemStatusUpdateTime = currentTime;
-    
-    // 安全检查
-    if (currentTemp > TEMP_PROTECTION_MAX) {
-      // 过温保护
-      systemState = STATE_ERROR;
-      errorCode = ERROR_OVERTEMP;
-      pwmController.emergencyStop();
-      uiAdapter.showError(errorCode, "Over temperature");
-    }
-    
-    // 根据系统状态进行处理
-    switch (systemState) {
-      case STATE_IDLE:
-        // 待机状态
-        pwmController.disable();
-        uiAdapter.setPowerPercentage(0);
-        break;
-        
-      case STATE_WORKING:
-        // 工作状态
-        // 设置PID输入
-        pidController.setCurrentTemp(currentTemp);
-        
-        // 计算PID输出
-        if (pidController.compute()) {
-          // 更新PWM输出
-          pwmController.setDutyCycle(pidController.getOutput());
-          
-          // 更新UI显示的功率百分比
-          uiAdapter.setPowerPercentage(pwmController.getPowerPercentage());
-        }
-        break;
-        
-      case STATE_ERROR:
-        // 错误状态
-        pwmController.emergencyStop();
-        uiAdapter.setPowerPercentage(0);
-        break;
-        
-      default:
-        break;
-    }
-    
-    // 更新UI显示的系统状态
-    uiAdapter.setSystemState(systemState);
-  }
-  
-  // 处理用户输入
-  userInput.update();
-  EncoderEvent event = userInput.getEvent();
-  
-  // 全局事件处理
-  switch (event) {
-    case EV_SINGLE_CLICK:
-      // 单击启动加热（在主界面）
-      if (systemState == STATE_IDLE && uiAdapter.getPage() == UI_PAGE_MAIN) {
-        systemState = STATE_WORKING;
-        pwmController.enable();
-        Serial.println("开始加热");
-      }
-      break;
-      
-    case EV_DOUBLE_CLICK:
-      // 双击停止加热（在任何状态）
-      if (systemState == STATE_WORKING) {
-        systemState = STATE_IDLE;
-        pwmController.disable();
-        Serial.println("停止加热");
-      }
-      break;
-      
-    case EV_LONG_PRESS:
-      // 长按在错误状态下重置
-      if (systemState == STATE_ERROR) {
-        systemState = STATE_IDLE;
-        errorCode = ERROR_NONE;
-        Serial.println("错误重置");
-      }
-      break;
-      
-    default:
-      break;
+  // 初始化电源管理: 任务空闲时自动降频和light sleep
+  if (!powerManager.begin()) {
+    Serial.println("电源管理初始化失败!");
   }
   
-  // 更新UI适配器并处理UI相关输入
-  uiAdapter.handleInput();
-  uiAdapter.update();
-  
-  // 短暂延时，避免CPU占用过高
-  delay(1);
-}
\ No newline at end of file
+  // 启动任务: 采集+控制与UI分别运行在两个核心上
+  setupConsole();
+  setupSchedulers();
+  xTaskCreatePinnedToCore(controlTask, "control", CONTROL_TASK_STACK, nullptr,
+                          CONTROL_TASK_PRIORITY, nullptr, CONTROL_TASK_CORE);
+  xTaskCreatePinnedToCore(uiTask, "ui", UI_TASK_STACK, nullptr,
+                          UI_TASK_PRIORITY, nullptr, UI_TASK_CORE);
+}
+
+void loop() {
+  // 所有工作都在控制任务和UI任务中完成，删除Arduino的loop任务
+  vTaskDelete(NULL);
+}
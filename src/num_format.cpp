@@ -0,0 +1,157 @@
+#include "num_format.h"
+
+// 按小数位数放大的倍数
+static const float POW10[NUM_FORMAT_MAX_DECIMALS + 1] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f};
+
+// 量化结果限制在int32范围内
+#define FIXED_LIMIT 2147483000.0f
+
+// 把幅值逐位写成文本 (从个位开始，小数位满时插入小数点)，再按符号和宽度反向复制到out
+static uint8_t formatMagnitude(char* out, uint32_t magnitude, bool negative, uint8_t decimals, uint8_t width) {
+    char digits[NUM_FORMAT_LENGTH];
+    uint8_t count = 0;
+    uint8_t position = 0;
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+        if (++position == decimals) {
+            digits[count++] = '.';
+        }
+    } while (magnitude > 0 || position <= decimals);
+
+    // 符号和左侧补齐的空格
+    uint8_t length = count + (negative ? 1 : 0);
+    if (width > NUM_FORMAT_LENGTH - 1) {
+        width = NUM_FORMAT_LENGTH - 1;
+    }
+    uint8_t index = 0;
+    while (length + index < width) {
+        out[index++] = ' ';
+    }
+    if (negative) {
+        out[index++] = '-';
+    }
+    while (count > 0) {
+        out[index++] = digits[--count];
+    }
+    out[index] = '\0';
+    return index;
+}
+
+uint8_t formatFixed(char* out, int32_t value, uint8_t decimals, uint8_t width) {
+    if (decimals > NUM_FORMAT_MAX_DECIMALS) {
+        decimals = NUM_FORMAT_MAX_DECIMALS;
+    }
+    // 取幅值时先转为无符号，INT32_MIN不溢出
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    return formatMagnitude(out, magnitude, value < 0, decimals, width);
+}
+
+uint8_t formatInt(char* out, int32_t value, uint8_t width) {
+    return formatFixed(out, value, 0, width);
+}
+
+uint8_t formatUnsigned(char* out, uint32_t value, uint8_t width) {
+    return formatMagnitude(out, value, false, 0, width);
+}
+
+uint8_t formatFloat(char* out, float value, uint8_t decimals, uint8_t width) {
+    if (decimals > NUM_FORMAT_MAX_DECIMALS) {
+        decimals = NUM_FORMAT_MAX_DECIMALS;
+    }
+    return formatFixed(out, toFixed(value, decimals), decimals, width);
+}
+
+int32_t toFixed(float value, uint8_t decimals) {
+    if (decimals > NUM_FORMAT_MAX_DECIMALS) {
+        decimals = NUM_FORMAT_MAX_DECIMALS;
+    }
+    float scaled = value * POW10[decimals];
+    if (scaled > FIXED_LIMIT) scaled = FIXED_LIMIT;
+    if (scaled < -FIXED_LIMIT) scaled = -FIXED_LIMIT;
+    if (isnan(scaled)) scaled = 0.0f;
+    int32_t fixed = lroundf(scaled);
+    
+    // 乘法的舍入可能把略小于.5的值进成恰好.5 (77.849998 * 10 = 778.5)，
+    // 此时用fmaf求出乘法的舍入误差，按实际值所在的一侧取整
+    if (fabsf(scaled - truncf(scaled)) == 0.5f) {
+        float error = fmaf(value, POW10[decimals], -scaled);
+        if (scaled > 0.0f && error < 0.0f) {
+            fixed--;
+        } else if (scaled < 0.0f && error > 0.0f) {
+            fixed++;
+        }
+    }
+    return fixed;
+}
+
+// ---------------- TextBuilder ----------------
+
+TextBuilder::TextBuilder(char* _buffer, uint8_t _capacity) {
+    buffer = _buffer;
+    capacity = _capacity;
+    length = 0;
+    if (capacity > 0) {
+        buffer[0] = '\0';
+    }
+}
+
+void TextBuilder::append(const char* text, uint8_t count) {
+    if (capacity == 0) {
+        return;
+    }
+    if (count > capacity - 1 - length) {
+        count = capacity - 1 - length;
+    }
+    memcpy(buffer + length, text, count);
+    length += count;
+    buffer[length] = '\0';
+}
+
+TextBuilder& TextBuilder::text(const char* str) {
+    size_t count = strlen(str);
+    append(str, count > 255 ? 255 : count);
+    return *this;
+}
+
+TextBuilder& TextBuilder::fixed(int32_t value, uint8_t decimals, uint8_t width) {
+    char number[NUM_FORMAT_LENGTH];
+    append(number, formatFixed(number, value, decimals, width));
+    return *this;
+}
+
+TextBuilder& TextBuilder::decimal(float value, uint8_t decimals, uint8_t width) {
+    char number[NUM_FORMAT_LENGTH];
+    append(number, formatFloat(number, value, decimals, width));
+    return *this;
+}
+
+TextBuilder& TextBuilder::integer(int32_t value, uint8_t width) {
+    char number[NUM_FORMAT_LENGTH];
+    append(number, formatInt(number, value, width));
+    return *this;
+}
+
+TextBuilder& TextBuilder::unsignedInteger(uint32_t value, uint8_t width) {
+    char number[NUM_FORMAT_LENGTH];
+    append(number, formatUnsigned(number, value, width));
+    return *this;
+}
+
+TextBuilder& TextBuilder::pad(uint8_t column) {
+    while (length < column && length + 1 < capacity) {
+        buffer[length++] = ' ';
+    }
+    if (capacity > 0) {
+        buffer[length] = '\0';
+    }
+    return *this;
+}
+
+const char* TextBuilder::c_str() {
+    return buffer;
+}
+
+uint8_t TextBuilder::size() {
+    return length;
+}
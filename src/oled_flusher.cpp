@@ -0,0 +1,211 @@
+#include "oled_flusher.h"
+#include "profiler.h"
+
+OledFlusher::OledFlusher(Adafruit_SSD1306* _display, TwoWire* _wire, I2CArbiter* _arbiter, uint8_t _address) {
+    display = _display;
+    wire = _wire;
+    arbiter = _arbiter;
+    address = _address;
+    task = nullptr;
+    busy = false;
+    firstPage = 0;
+    lastPage = OLED_PAGE_COUNT - 1;
+    firstColumn = 0;
+    lastColumn = SCREEN_WIDTH - 1;
+    shadowValid = false;
+    frameCount = 0;
+    pageCount = 0;
+    byteCount = 0;
+    busyCount = 0;
+    errorCount = 0;
+    lastTransferTime = 0;
+}
+
+bool OledFlusher::begin() {
+    if (xTaskCreatePinnedToCore(flushTask, "flush", FLUSH_TASK_STACK, this,
+                                FLUSH_TASK_PRIORITY, &task, FLUSH_TASK_CORE) != pdPASS) {
+        task = nullptr;
+        Serial.println("OLED刷新任务创建失败，使用同步刷新");
+        return false;
+    }
+    
+    Serial.println("OLED刷新任务启动");
+    return true;
+}
+
+void OledFlusher::flushTask(void* param) {
+    OledFlusher* self = (OledFlusher*)param;
+    
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->transfer(self->front);
+        self->busy.store(false);
+    }
+}
+
+bool OledFlusher::sendWindow(const uint8_t* buffer, uint8_t page, uint8_t firstColumn, uint8_t lastColumn) {
+    const uint8_t* data = buffer + page * SCREEN_WIDTH;
+    
+    // 设置写入窗口为该页的变化列区间 (水平寻址模式)
+    wire->beginTransmission(address);
+    wire->write((uint8_t)0x00);     // 控制字节: 命令流
+    wire->write((uint8_t)SSD1306_PAGEADDR);
+    wire->write(page);
+    wire->write(page);
+    wire->write((uint8_t)SSD1306_COLUMNADDR);
+    wire->write(firstColumn);
+    wire->write(lastColumn);
+    if (wire->endTransmission() != 0) {
+        return false;
+    }
+    
+    // 分块发送显示数据，每块不超过Wire缓冲区
+    for (uint16_t offset = firstColumn; offset <= lastColumn; offset += OLED_CHUNK_SIZE) {
+        uint16_t length = lastColumn + 1 - offset;
+        if (length > OLED_CHUNK_SIZE) {
+            length = OLED_CHUNK_SIZE;
+        }
+        wire->beginTransmission(address);
+        wire->write((uint8_t)0x40); // 控制字节: 数据流
+        wire->write(data + offset, length);
+        if (wire->endTransmission() != 0) {
+            return false;
+        }
+    }
+    
+    pageCount++;
+    byteCount += lastColumn + 1 - firstColumn;
+    return true;
+}
+
+void OledFlusher::transfer(const uint8_t* buffer) {
+    PROFILE_ZONE(PROF_ZONE_FLUSH);
+    frameCount++;
+    unsigned long start = micros();
+    
+    // 屏幕内容未知时窗口外的部分也必须发送，先扩大为整屏
+    if (!shadowValid) {
+        setWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    }
+    bool complete = true;
+    
+    for (uint8_t page = firstPage; page <= lastPage; page++) {
+        const uint8_t* current = buffer + page * SCREEN_WIDTH;
+        uint8_t* previous = shadow + page * SCREEN_WIDTH;
+        
+        // 在窗口内找出该页第一列和最后一列变化的位置
+        int16_t first = firstColumn;
+        int16_t last = lastColumn;
+        if (shadowValid) {
+            while (first <= lastColumn && current[first] == previous[first]) {
+                first++;
+            }
+            if (first > lastColumn) {
+                continue;
+            }
+            while (current[last] == previous[last]) {
+                last--;
+            }
+        }
+        
+        arbiter->acquire(I2C_CLIENT_DISPLAY);
+        bool sent = sendWindow(buffer, page, first, last);
+        arbiter->release(I2C_CLIENT_DISPLAY);
+        
+        // 发送失败时该页只写入了一部分 (或窗口命令未生效写到了别处)，
+        // 不更新shadow，并在本帧结束后标记屏幕内容未知，下一帧整屏重发
+        if (!sent) {
+            errorCount++;
+            complete = false;
+            continue;
+        }
+        memcpy(previous + first, current + first, last + 1 - first);
+    }
+    
+    shadowValid = complete;
+    lastTransferTime = micros() - start;
+}
+
+bool OledFlusher::setWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // 裁剪到屏幕范围
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t y0 = y < 0 ? 0 : y;
+    int16_t x1 = x + w - 1 >= SCREEN_WIDTH ? SCREEN_WIDTH - 1 : x + w - 1;
+    int16_t y1 = y + h - 1 >= SCREEN_HEIGHT ? SCREEN_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+    
+    // 行扩展到整页 (SSD1306按页写入)
+    firstPage = y0 / 8;
+    lastPage = y1 / 8;
+    firstColumn = x0;
+    lastColumn = x1;
+    return true;
+}
+
+bool OledFlusher::submit() {
+    return submitArea(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+}
+
+bool OledFlusher::submitArea(int16_t x, int16_t y, int16_t w, int16_t h) {
+    // 上一帧还在传输，不覆盖前台缓冲和窗口
+    if (busy.load()) {
+        busyCount++;
+        return false;
+    }
+    
+    if (!setWindow(x, y, w, h)) {
+        return true;
+    }
+    
+    if (task == nullptr) {
+        transfer(display->getBuffer());
+        return true;
+    }
+    
+    memcpy(front, display->getBuffer(), sizeof(front));
+    busy.store(true);
+    xTaskNotifyGive(task);
+    return true;
+}
+
+bool OledFlusher::isBusy() {
+    return busy.load();
+}
+
+uint32_t OledFlusher::getLastTransferTime() {
+    return lastTransferTime;
+}
+
+void OledFlusher::flush() {
+    setWindow(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    transfer(display->getBuffer());
+}
+
+void OledFlusher::invalidate() {
+    shadowValid = false;
+}
+
+void OledFlusher::printStats() {
+    Serial.print("OLED,");
+    Serial.print(frameCount);
+    Serial.print(",");
+    Serial.print(pageCount);
+    Serial.print(",");
+    Serial.print(byteCount);
+    Serial.print(",");
+    Serial.print(frameCount > 0 ? byteCount / frameCount : 0);
+    Serial.print(",");
+    Serial.print(busyCount);
+    Serial.print(",");
+    Serial.println(errorCount);
+}
+
+void OledFlusher::resetStats() {
+    frameCount = 0;
+    pageCount = 0;
+    byteCount = 0;
+    busyCount = 0;
+    errorCount = 0;
+}
@@ -0,0 +1,93 @@
+#include "output_map.h"
+
+// 占空比节点间隔
+static const float DUTY_STEP = (float)((1 << PWM_RESOLUTION) - 1) / (OUTPUT_MAP_DUTY_POINTS - 1);
+
+// 温度节点间隔
+static const float TEMP_STEP = (TEMP_MAX - TEMP_MIN) / (OUTPUT_MAP_TEMP_POINTS - 1);
+
+// 默认表: 典型12V PTC加热片，温度节点 0/20/40/60/80/100℃
+static const uint16_t DEFAULT_POWER_TABLE[OUTPUT_MAP_TEMP_POINTS][OUTPUT_MAP_DUTY_POINTS] = {
+    {0, 256, 512, 768, 1023},
+    {0, 245, 485, 720, 950},
+    {0, 225, 440, 650, 850},
+    {0, 195, 380, 555, 720},
+    {0, 155, 300, 435, 560},
+    {0, 110, 210, 300, 380}
+};
+
+OutputMap::OutputMap() {
+    enabled = OUTPUT_MAP_ENABLED;
+    loadDefaults();
+}
+
+void OutputMap::loadDefaults() {
+    memcpy(powerTable, DEFAULT_POWER_TABLE, sizeof(powerTable));
+}
+
+void OutputMap::locateTemp(float temp, uint8_t* row, float* frac) {
+    float t = (temp - TEMP_MIN) / TEMP_STEP;
+    if (t < 0.0f) {
+        t = 0.0f;
+    } else if (t > OUTPUT_MAP_TEMP_POINTS - 1) {
+        t = OUTPUT_MAP_TEMP_POINTS - 1;
+    }
+    
+    *row = (uint8_t)t;
+    if (*row >= OUTPUT_MAP_TEMP_POINTS - 1) {
+        *row = OUTPUT_MAP_TEMP_POINTS - 2;
+    }
+    *frac = t - *row;
+}
+
+float OutputMap::maxPower(float temp) {
+    if (!enabled) {
+        return (1 << PWM_RESOLUTION) - 1;
+    }
+    
+    uint8_t row;
+    float frac;
+    locateTemp(temp, &row, &frac);
+    
+    const uint8_t last = OUTPUT_MAP_DUTY_POINTS - 1;
+    return powerTable[row][last] + frac * (powerTable[row + 1][last] - powerTable[row][last]);
+}
+
+uint16_t OutputMap::powerToDuty(double power, float temp) {
+    const uint16_t maxDuty = (1 << PWM_RESOLUTION) - 1;
+    
+    if (power <= 0.0) {
+        return 0;
+    }
+    
+    if (!enabled) {
+        return power >= maxDuty ? maxDuty : (uint16_t)power;
+    }
+    
+    // 定位温度区间
+    uint8_t row;
+    float frac;
+    locateTemp(temp, &row, &frac);
+    
+    // 在两行之间插值得到当前温度下的功率曲线，同时查找功率所在的占空比区间
+    float lower = 0.0f;
+    for (uint8_t i = 1; i < OUTPUT_MAP_DUTY_POINTS; i++) {
+        float upper = powerTable[row][i] + frac * (powerTable[row + 1][i] - powerTable[row][i]);
+        if (power < upper) {
+            float duty = (i - 1 + (power - lower) / (upper - lower)) * DUTY_STEP;
+            return (uint16_t)(duty + 0.5f);
+        }
+        lower = upper;
+    }
+    
+    // 超出当前温度下的最大功率，满占空比输出
+    return maxDuty;
+}
+
+void OutputMap::setEnabled(bool enable) {
+    enabled = enable;
+}
+
+bool OutputMap::isEnabled() {
+    return enabled;
+}
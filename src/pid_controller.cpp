@@ -1,42 +1,26 @@
 #include "pid_controller.h"
+#include "profiler.h"
 
 PIDController::PIDController() {
     input = 0.0;
     output = 0.0;
     setpoint = TEMP_DEFAULT;
+    outputLimit = PID_OUTPUT_MAX;
     
     kp = PID_KP_DEFAULT;
     ki = PID_KI_DEFAULT;
     kd = PID_KD_DEFAULT;
     
-    pid = nullptr;
+    integral = 0.0;
+    lastInput = 0.0;
+    running = false;
     lastCompute = 0;
 }
 
-PIDController::~PIDController() {
-    if (pid != nullptr) {
-        delete pid;
-    }
-}
-
 bool PIDController::begin() {
-    // 创建PID控制器
-    // 参数: &输入, &输出, &设定点, Kp, Ki, Kd, 控制方向
-    pid = new PID(&input, &output, &setpoint, kp, ki, kd, DIRECT);
-    
-    if (pid == nullptr) {
-        Serial.println("PID控制器初始化失败");
-        return false;
-    }
-    
-    // 设置输出范围 (0-1023: 10位PWM分辨率)
-    pid->SetOutputLimits(0, 1023);
-    
-    // 启用PID控制器
-    pid->SetMode(AUTOMATIC);
-    
-    // 设置采样时间
-    pid->SetSampleTime(PID_COMPUTE_INTERVAL);
+    integral = 0.0;
+    output = 0.0;
+    running = false;
     
     Serial.println("PID控制器初始化成功");
     return true;
@@ -65,27 +49,68 @@ double PIDController::getOutput() {
     return output;
 }
 
+void PIDController::setOutputLimit(double limit) {
+    if (limit > PID_OUTPUT_MAX) {
+        limit = PID_OUTPUT_MAX;
+    } else if (limit < PID_OUTPUT_MIN) {
+        limit = PID_OUTPUT_MIN;
+    }
+    
+    outputLimit = limit;
+}
+
 bool PIDController::compute() {
-    // 检查计算间隔
+    PROFILE_ZONE(PROF_ZONE_PID_COMPUTE);
+    
+    // 按两次计算之间的实际间隔积分和求导
     unsigned long now = millis();
-    if (now - lastCompute < PID_COMPUTE_INTERVAL && lastCompute > 0) {
-        return false;
+    unsigned long elapsed = now - lastCompute;
+    
+    // 首次计算或长时间未计算 (如待机后重新启动) 时按标称周期处理，
+    // 并从当前输入开始求导，避免积分和微分项突变
+    if (!running || elapsed > 2 * PID_COMPUTE_INTERVAL) {
+        elapsed = PID_COMPUTE_INTERVAL;
+        lastInput = input;
+        running = true;
+    } else if (elapsed == 0) {
+        elapsed = 1;
     }
-    
     lastCompute = now;
+    double dt = elapsed / 1000.0;
+    
+    // 积分项限制在当前输出上限内，输出饱和时不继续累积
+    double error = setpoint - input;
+    integral += ki * error * dt;
+    if (integral > outputLimit) {
+        integral = outputLimit;
+    } else if (integral < PID_OUTPUT_MIN) {
+        integral = PID_OUTPUT_MIN;
+    }
+    
+    // 微分项按测量值计算，修改目标温度时不产生冲击
+    double derivative = (input - lastInput) / dt;
+    lastInput = input;
+    
+    double result = kp * error + integral - kd * derivative;
+    if (result > outputLimit) {
+        result = outputLimit;
+    } else if (result < PID_OUTPUT_MIN) {
+        result = PID_OUTPUT_MIN;
+    }
+    output = result;
     
-    // 调用PID库的计算功能
-    return pid->Compute();
+    return true;
 }
 
 void PIDController::setTunings(double _kp, double _ki, double _kd) {
+    // 负参数无意义，忽略
+    if (_kp < 0.0 || _ki < 0.0 || _kd < 0.0) {
+        return;
+    }
+    
     kp = _kp;
     ki = _ki;
     kd = _kd;
-    
-    if (pid != nullptr) {
-        pid->SetTunings(kp, ki, kd);
-    }
 }
 
 void PIDController::getTunings(double *_kp, double *_ki, double *_kd) {
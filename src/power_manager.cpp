@@ -0,0 +1,99 @@
+#include "power_manager.h"
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <hal/gpio_ll.h>
+
+// 输入引脚是否已改为反相电平触发 (中断中读取)
+static volatile bool g_inputWakeArmed = false;
+
+PowerManager::PowerManager() {
+    initialized = false;
+    lightSleepEnabled = false;
+    heaterLock = nullptr;
+    heaterLockHeld = false;
+}
+
+bool PowerManager::begin() {
+#if POWER_MANAGEMENT_ENABLED
+    // 加热器电源锁: 保持APB最高频率，同时阻止light sleep
+    if (esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "heater", &heaterLock) != ESP_OK) {
+        Serial.println("电源锁创建失败");
+        return false;
+    }
+    
+    esp_pm_config_esp32s3_t pmConfig;
+    pmConfig.max_freq_mhz = PM_MAX_FREQ_MHZ;
+    pmConfig.min_freq_mhz = PM_MIN_FREQ_MHZ;
+    pmConfig.light_sleep_enable = LIGHT_SLEEP_ENABLED;
+    
+    esp_err_t err = esp_pm_configure(&pmConfig);
+    if (err != ESP_OK && pmConfig.light_sleep_enable) {
+        // 固件未启用无节拍空闲时不支持light sleep，退回只使用动态调频
+        Serial.println("不支持light sleep，仅启用动态调频");
+        pmConfig.light_sleep_enable = false;
+        err = esp_pm_configure(&pmConfig);
+    }
+    
+    if (err != ESP_OK) {
+        Serial.print("电源管理配置失败: ");
+        Serial.println(esp_err_to_name(err));
+        return false;
+    }
+    lightSleepEnabled = pmConfig.light_sleep_enable;
+    
+    // GPIO唤醒源: 按钮、编码器A/B的任意跳变 (ADS1115 RDY由TempSensor在转换期间启用)
+    // 必须在UserInput::begin()挂接中断之后调用，此后中断处理程序自行维护触发电平
+    if (lightSleepEnabled) {
+        esp_sleep_enable_gpio_wakeup();
+        g_inputWakeArmed = true;
+        armInputWake(ENCODER_BTN_PIN);
+        armInputWake(ENCODER_PIN_A);
+        armInputWake(ENCODER_PIN_B);
+    }
+    initialized = true;
+    
+    Serial.println(lightSleepEnabled ? "电源管理初始化成功 (light sleep)" : "电源管理初始化成功");
+    return true;
+#else
+    return true;
+#endif
+}
+
+void IRAM_ATTR PowerManager::armInputWake(uint8_t pin) {
+    if (!g_inputWakeArmed) {
+        return;
+    }
+    
+    // 在当前电平的反相触发，电平保持期间不会再次进入中断；读取电平后引脚若已跳变，
+    // 新的触发电平立即成立，中断马上再次进入，跳变不会丢失。
+    // 中断中只能使用内联的gpio_ll函数 (gpio_wakeup_enable不在IRAM中)
+    gpio_dev_t* hw = GPIO_LL_GET_HW(GPIO_PORT_0);
+    gpio_int_type_t type = gpio_ll_get_level(hw, (gpio_num_t)pin) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL;
+    gpio_ll_wakeup_enable(hw, (gpio_num_t)pin, type);
+}
+
+void PowerManager::setHeaterActive(bool active) {
+    if (!initialized || active == heaterLockHeld) {
+        return;
+    }
+    
+    if (active) {
+        esp_pm_lock_acquire(heaterLock);
+    } else {
+        esp_pm_lock_release(heaterLock);
+    }
+    heaterLockHeld = active;
+}
+
+bool PowerManager::isLightSleepEnabled() {
+    return lightSleepEnabled;
+}
+
+void PowerManager::printStats(Scheduler* controlScheduler, Scheduler* uiScheduler) {
+    Serial.print("PWR,");
+    Serial.print(lightSleepEnabled ? 1 : 0);
+    Serial.print(",");
+    Serial.print(controlScheduler->getLoad(), 1);
+    Serial.print(",");
+    Serial.println(uiScheduler->getLoad(), 1);
+}
@@ -0,0 +1,101 @@
+#include "profiler.h"
+
+Profiler profiler;
+
+// 区段名称 (用于串口和OLED，不超过5个字符)
+static const char* const ZONE_NAMES[PROF_ZONE_COUNT] = {
+    "adc", "v2t", "pid", "input", "draw", "flush"
+};
+
+Profiler::Profiler() {
+    reset();
+}
+
+void Profiler::reset() {
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        memset(&zones[i], 0, sizeof(ProfileZoneStats));
+        zones[i].min = UINT32_MAX;
+    }
+}
+
+uint32_t Profiler::binLowerBound(uint8_t bin) {
+    if (bin < 4) {
+        return bin;
+    }
+    uint8_t msb = bin / 4 + 1;
+    return (uint32_t)(4 + bin % 4) << (msb - 2);
+}
+
+const char* Profiler::getZoneName(ProfileZone zone) {
+    return ZONE_NAMES[zone];
+}
+
+uint32_t Profiler::getCount(ProfileZone zone) {
+    return zones[zone].count;
+}
+
+uint32_t Profiler::getMin(ProfileZone zone) {
+    return zones[zone].count > 0 ? zones[zone].min : 0;
+}
+
+uint32_t Profiler::getMax(ProfileZone zone) {
+    return zones[zone].max;
+}
+
+uint32_t Profiler::getMean(ProfileZone zone) {
+    const ProfileZoneStats& stats = zones[zone];
+    return stats.count > 0 ? stats.total / stats.count : 0;
+}
+
+uint32_t Profiler::getPercentile(ProfileZone zone, uint16_t permille) {
+    const ProfileZoneStats& stats = zones[zone];
+    if (stats.count == 0) {
+        return 0;
+    }
+    
+    // 累加直方图直到达到目标样本数
+    uint32_t target = ((uint64_t)stats.count * permille + 999) / 1000;
+    uint32_t cumulative = 0;
+    for (uint8_t bin = 0; bin < PROFILER_HISTOGRAM_BINS; bin++) {
+        cumulative += stats.histogram[bin];
+        if (cumulative >= target) {
+            // 区间上界，不超过实测最大值
+            uint32_t upper = bin + 1 < PROFILER_HISTOGRAM_BINS ? binLowerBound(bin + 1) - 1 : UINT32_MAX;
+            return upper < stats.max ? upper : stats.max;
+        }
+    }
+    
+    return stats.max;
+}
+
+uint32_t Profiler::cyclesToMicros(uint32_t cycles) {
+    return cycles / ESP.getCpuFreqMHz();
+}
+
+void Profiler::printStats() {
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        ProfileZone zone = (ProfileZone)i;
+        uint32_t mean = getMean(zone);
+        uint32_t p99 = getPercentile(zone, 990);
+        uint32_t max = getMax(zone);
+        
+        Serial.print("PROF,");
+        Serial.print(getZoneName(zone));
+        Serial.print(",");
+        Serial.print(getCount(zone));
+        Serial.print(",");
+        Serial.print(getMin(zone));
+        Serial.print(",");
+        Serial.print(mean);
+        Serial.print(",");
+        Serial.print(p99);
+        Serial.print(",");
+        Serial.print(max);
+        Serial.print(",");
+        Serial.print(cyclesToMicros(mean));
+        Serial.print(",");
+        Serial.print(cyclesToMicros(p99));
+        Serial.print(",");
+        Serial.println(cyclesToMicros(max));
+    }
+}
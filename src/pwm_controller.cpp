@@ -1,9 +1,37 @@
 #include "pwm_controller.h"
+#include <hal/ledc_ll.h>
+
+static_assert(BURST_WINDOW_MS >= BURST_WINDOW_MIN_MS && BURST_WINDOW_MS <= BURST_WINDOW_MAX_MS,
+              "BURST_WINDOW_MS超出范围");
+
+// ESP32-S3的LEDC只有低速组，Arduino通道号即组内通道号
+static_assert(PWM_CHANNEL < 8, "PWM_CHANNEL必须为0-7");
+#define PWM_LEDC_MODE LEDC_LOW_SPEED_MODE
+#define PWM_LEDC_CHANNEL ((ledc_channel_t)PWM_CHANNEL)
+
+// 全局指针用于定时器中断
+static PWMController* g_pwmController = nullptr;
 
 PWMController::PWMController() {
     initialized = false;
     dutyCycle = 0;
+    outputDuty = 0;
     enabled = false;
+    inhibited = false;
+    
+    mode = PWM_MODE_CONTINUOUS;
+    burstTimer = nullptr;
+    burstWindowMs = BURST_WINDOW_MS;
+    burstAccumulator = 0;
+    burstMux = portMUX_INITIALIZER_UNLOCKED;
+    
+    compensationEnabled = SUPPLY_COMPENSATION_ENABLED;
+    supplyVoltage = SUPPLY_VOLTAGE_NOMINAL;
+    
+    sessionEnergy = 0;
+    lifetimeEnergy = 0;
+    sessionDutyTime = 0;
+    lastAccountTime = 0;
 }
 
 bool PWMController::begin() {
@@ -17,6 +45,12 @@ bool PWMController::begin() {
     // 初始化PWM输出为0 (关闭)
     setDutyCycle(0);
     
+    // 配置整周期模式定时器 (1MHz计数，自动重载)，仅在整周期模式下启用
+    g_pwmController = this;
+    burstTimer = timerBegin(BURST_TIMER_ID, 80, true);
+    timerAttachInterrupt(burstTimer, &burstTimerInterrupt, true);
+    timerAlarmWrite(burstTimer, (uint64_t)burstWindowMs * 1000, true);
+    
     initialized = true;
     enabled = false;
     
@@ -30,30 +64,205 @@ void PWMController::setDutyCycle(uint16_t duty) {
         duty = (1 << PWM_RESOLUTION) - 1;
     }
     
+    accumulateEnergy();
     dutyCycle = duty;
+    applyOutput();
+}
+
+void PWMController::applyOutput() {
+    const uint16_t maxDuty = (1 << PWM_RESOLUTION) - 1;
+    
+    // 加热功率与电压平方成正比: 按 (Vnom/V)² 缩放占空比以保持功率恒定
+    // 电压过低时 (未接分压电阻或电源异常) 不做补偿
+    uint32_t duty = dutyCycle;
+    if (compensationEnabled && supplyVoltage >= SUPPLY_VOLTAGE_MIN) {
+        float ratio = SUPPLY_VOLTAGE_NOMINAL / supplyVoltage;
+        float scaled = dutyCycle * ratio * ratio + 0.5f;
+        duty = scaled > maxDuty ? maxDuty : (uint32_t)scaled;
+    }
+    
+    // 仅在启用状态下更新实际输出，整周期模式由定时器在下一个窗口边界输出
+    portENTER_CRITICAL(&burstMux);
+    outputDuty = duty;
+    if (enabled && initialized && mode == PWM_MODE_CONTINUOUS) {
+        writeDuty(inhibited ? 0 : outputDuty);
+    }
+    portEXIT_CRITICAL(&burstMux);
+}
+
+void PWMController::accumulateEnergy() {
+    unsigned long now = micros();
+    unsigned long elapsed = now - lastAccountTime;
+    lastAccountTime = now;
     
-    // 仅在启用状态下更新实际输出
-    if (enabled && initialized) {
-        ledcWrite(PWM_CHANNEL, dutyCycle);
+    // 输出在两次调用之间保持不变，按分段常数积分
+    if (!enabled || !initialized || inhibited || outputDuty == 0) {
+        return;
     }
+    
+    const uint16_t maxDuty = (1 << PWM_RESOLUTION) - 1;
+    uint64_t dutyTime = (uint64_t)outputDuty * elapsed / maxDuty;
+    sessionDutyTime += dutyTime;
+    
+    // P = Pnom × (V/Vnom)²，未测得有效电压时按额定电压计算
+    float power = HEATER_POWER_NOMINAL;
+    if (supplyVoltage >= SUPPLY_VOLTAGE_MIN) {
+        float ratio = supplyVoltage / SUPPLY_VOLTAGE_NOMINAL;
+        power *= ratio * ratio;
+    }
+    
+    uint64_t energy = (uint64_t)(power * dutyTime);
+    sessionEnergy += energy;
+    lifetimeEnergy += energy;
 }
 
 uint16_t PWMController::getDutyCycle() {
     return dutyCycle;
 }
 
+uint16_t PWMController::getOutputDutyCycle() {
+    return outputDuty;
+}
+
 uint8_t PWMController::getPowerPercentage() {
     // 将10位分辨率 (0-1023) 转换为百分比 (0-100)
     return (uint8_t)((dutyCycle * 100) / ((1 << PWM_RESOLUTION) - 1));
 }
 
+void PWMController::setSupplyVoltage(float voltage) {
+    accumulateEnergy();
+    supplyVoltage = voltage;
+    applyOutput();
+}
+
+float PWMController::getSupplyVoltage() {
+    return supplyVoltage;
+}
+
+void PWMController::setVoltageCompensation(bool enable) {
+    accumulateEnergy();
+    compensationEnabled = enable;
+    applyOutput();
+}
+
+bool PWMController::isVoltageCompensationEnabled() {
+    return compensationEnabled;
+}
+
+float PWMController::getSessionEnergy() {
+    accumulateEnergy();
+    return sessionEnergy / 3.6e9f; // μJ -> Wh
+}
+
+float PWMController::getSessionDutySeconds() {
+    accumulateEnergy();
+    return sessionDutyTime / 1e6f;
+}
+
+double PWMController::getLifetimeEnergy() {
+    accumulateEnergy();
+    return lifetimeEnergy / 3.6e9;
+}
+
+void PWMController::setLifetimeEnergy(double wh) {
+    accumulateEnergy();
+    lifetimeEnergy = (uint64_t)(wh * 3.6e9);
+}
+
+void PWMController::setOutputMode(PWMMode newMode) {
+    if (newMode == mode) {
+        return;
+    }
+    
+    if (!initialized) {
+        mode = newMode;
+        return;
+    }
+    
+    // 只切换输出方式，不重新配置LEDC，避免切换时输出中断
+    portENTER_CRITICAL(&burstMux);
+    mode = newMode;
+    burstAccumulator = 0;
+    if (newMode == PWM_MODE_CONTINUOUS && enabled) {
+        writeDuty(inhibited ? 0 : outputDuty);
+    }
+    portEXIT_CRITICAL(&burstMux);
+    
+    if (newMode == PWM_MODE_BURST) {
+        timerWrite(burstTimer, 0);
+        timerAlarmEnable(burstTimer);
+    } else {
+        timerAlarmDisable(burstTimer);
+    }
+    
+    Serial.print("PWM输出模式: ");
+    Serial.println(newMode == PWM_MODE_BURST ? "整周期" : "连续");
+}
+
+PWMMode PWMController::getOutputMode() {
+    return mode;
+}
+
+uint16_t PWMController::getBurstWindow() {
+    return burstWindowMs;
+}
+
+void IRAM_ATTR PWMController::burstStep() {
+    portENTER_CRITICAL_ISR(&burstMux);
+    
+    if (mode == PWM_MODE_BURST && enabled) {
+        // Bresenham: 每个窗口累加占空比，溢出时导通一个窗口，使导通窗口均匀分布
+        const uint32_t maxDuty = (1 << PWM_RESOLUTION) - 1;
+        burstAccumulator += outputDuty;
+        bool on = burstAccumulator >= maxDuty;
+        if (on) {
+            burstAccumulator -= maxDuty;
+        }
+        
+        // 每个窗口都写LEDC，保证从连续模式切换后的第一个窗口即生效，全通时输出100%
+        writeDuty(on && !inhibited ? (1 << PWM_RESOLUTION) : 0);
+    }
+    
+    portEXIT_CRITICAL_ISR(&burstMux);
+}
+
+void IRAM_ATTR PWMController::writeDuty(uint32_t duty) {
+    // 与ledc_set_duty + ledc_update_duty相同的寄存器序列，但只用内联的ledc_ll函数:
+    // ledcWrite不在IRAM中且内部加锁，不能在定时器中断中调用
+    ledc_dev_t* hw = LEDC_LL_GET_HW();
+    ledc_ll_set_duty_int_part(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, duty);
+    ledc_ll_set_duty_direction(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, LEDC_DUTY_DIR_INCREASE);
+    ledc_ll_set_duty_num(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, 1);
+    ledc_ll_set_duty_cycle(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, 1);
+    ledc_ll_set_duty_scale(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, 0);
+    ledc_ll_set_duty_start(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL, true);
+    ledc_ll_ls_channel_update(hw, PWM_LEDC_MODE, PWM_LEDC_CHANNEL);
+}
+
+void IRAM_ATTR PWMController::burstTimerInterrupt() {
+    if (g_pwmController != nullptr) {
+        g_pwmController->burstStep();
+    }
+}
+
 void PWMController::enable() {
     if (!initialized) {
         return;
     }
     
+    // 开始新的加热会话
+    if (!enabled) {
+        sessionEnergy = 0;
+        sessionDutyTime = 0;
+    }
+    
+    accumulateEnergy();
+    portENTER_CRITICAL(&burstMux);
     enabled = true;
-    ledcWrite(PWM_CHANNEL, dutyCycle);
+    if (mode == PWM_MODE_CONTINUOUS) {
+        writeDuty(inhibited ? 0 : outputDuty);
+    }
+    portEXIT_CRITICAL(&burstMux);
     
     Serial.println("PWM输出已启用");
 }
@@ -63,12 +272,35 @@ void PWMController::disable() {
         return;
     }
     
+    accumulateEnergy();
+    portENTER_CRITICAL(&burstMux);
     enabled = false;
-    ledcWrite(PWM_CHANNEL, 0); // 将输出设为0
+    writeDuty(0); // 将输出设为0
+    portEXIT_CRITICAL(&burstMux);
     
     Serial.println("PWM输出已禁用");
 }
 
+void PWMController::setOutputInhibit(bool inhibit) {
+    if (inhibit == inhibited) {
+        return;
+    }
+    
+    accumulateEnergy();
+    portENTER_CRITICAL(&burstMux);
+    inhibited = inhibit;
+    if (initialized && enabled && mode == PWM_MODE_CONTINUOUS) {
+        writeDuty(inhibited ? 0 : outputDuty);
+    }
+    portEXIT_CRITICAL(&burstMux);
+    
+    Serial.println(inhibit ? "PWM输出已抑制" : "PWM输出已恢复");
+}
+
+bool PWMController::isOutputInhibited() {
+    return inhibited;
+}
+
 bool PWMController::isEnabled() {
     return enabled;
 }
@@ -76,10 +308,19 @@ bool PWMController::isEnabled() {
 void PWMController::emergencyStop() {
     // 紧急情况下立即关闭输出
     if (initialized) {
-        ledcWrite(PWM_CHANNEL, 0);
+        // 先按停止前的输出结算能耗 (enabled清零后accumulateEnergy不再计入)
+        accumulateEnergy();
+        bool wasEnabled = enabled;
+        portENTER_CRITICAL(&burstMux);
+        writeDuty(0);
         enabled = false;
+        portEXIT_CRITICAL(&burstMux);
         dutyCycle = 0;
+        outputDuty = 0;
         
-        Serial.println("PWM紧急停止!");
+        // 错误状态下控制任务每个周期都会调用，已停止时只确保输出为0，不重复输出日志
+        if (wasEnabled) {
+            Serial.println("PWM紧急停止!");
+        }
     }
 } 
\ No newline at end of file
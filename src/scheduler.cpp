@@ -0,0 +1,196 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler(const char* _name) {
+    name = _name;
+    jobCount = 0;
+    started = false;
+    startTime = 0;
+    busyTime = 0;
+}
+
+int8_t Scheduler::addJob(const char* jobName, SchedulerJobFunction function, void* context,
+                         uint32_t period, uint32_t phase, uint8_t priority, uint32_t deadline) {
+    if (jobCount >= SCHEDULER_MAX_JOBS || function == nullptr || period == 0) {
+        Serial.println("调度器任务注册失败");
+        return -1;
+    }
+    
+    SchedulerJob& job = jobs[jobCount];
+    memset(&job, 0, sizeof(job));
+    job.name = jobName;
+    job.function = function;
+    job.context = context;
+    job.period = period;
+    job.deadline = deadline;
+    job.priority = priority;
+    job.nextRelease = phase;    // start时加上基准时间
+    
+    return jobCount++;
+}
+
+void Scheduler::setPeriod(int8_t index, uint32_t period, uint32_t deadline) {
+    if (index < 0 || index >= jobCount || period == 0) {
+        return;
+    }
+    
+    jobs[index].period = period;
+    jobs[index].deadline = deadline;
+}
+
+void Scheduler::start() {
+    unsigned long now = millis();
+    
+    for (uint8_t i = 0; i < jobCount; i++) {
+        jobs[i].nextRelease += now;
+    }
+    
+    startTime = now;
+    busyTime = 0;
+    started = true;
+}
+
+SchedulerJob* Scheduler::selectDue(unsigned long now) {
+    SchedulerJob* selected = nullptr;
+    
+    for (uint8_t i = 0; i < jobCount; i++) {
+        SchedulerJob* job = &jobs[i];
+        
+        // 未到释放时间
+        if ((int32_t)(now - job->nextRelease) < 0) {
+            continue;
+        }
+        
+        // 优先级高者优先，同优先级先释放者优先
+        if (selected == nullptr || job->priority > selected->priority ||
+            (job->priority == selected->priority &&
+             (int32_t)(job->nextRelease - selected->nextRelease) < 0)) {
+            selected = job;
+        }
+    }
+    
+    return selected;
+}
+
+void Scheduler::runJob(SchedulerJob* job, unsigned long now) {
+    // 启动延迟统计
+    uint32_t lateness = now - job->nextRelease;
+    if (lateness > job->maxLateness) {
+        job->maxLateness = lateness;
+    }
+    uint8_t bin = lateness == 0 ? 0 : 32 - __builtin_clz(lateness);
+    if (bin >= SCHEDULER_HISTOGRAM_BINS) {
+        bin = SCHEDULER_HISTOGRAM_BINS - 1;
+    }
+    job->latenessHistogram[bin]++;
+    
+    // 执行
+    unsigned long execStart = micros();
+    job->function(job->context);
+    uint32_t execTime = micros() - execStart;
+    
+    busyTime += execTime;
+    job->runs++;
+    if (execTime > job->maxExecTime) {
+        job->maxExecTime = execTime;
+    }
+    
+    // 截止期限检查
+    unsigned long finish = millis();
+    if (finish - job->nextRelease > job->deadline) {
+        job->overruns++;
+    }
+    
+    // 释放时间按周期推进，不随执行时间漂移；
+    // 落后超过一个周期时跳过错过的周期，避免连续补跑
+    job->nextRelease += job->period;
+    while ((int32_t)(finish - job->nextRelease) >= (int32_t)job->period) {
+        job->nextRelease += job->period;
+        job->skipped++;
+    }
+}
+
+uint32_t Scheduler::runDue() {
+    if (!started) {
+        start();
+    }
+    
+    // 依次运行到期任务，每次运行后重新选择，高优先级任务不会被长时间推后
+    SchedulerJob* job;
+    while ((job = selectDue(millis())) != nullptr) {
+        runJob(job, millis());
+    }
+    
+    // 计算距下一次释放的时间
+    unsigned long now = millis();
+    uint32_t wait = UINT32_MAX;
+    for (uint8_t i = 0; i < jobCount; i++) {
+        int32_t remaining = (int32_t)(jobs[i].nextRelease - now);
+        if (remaining <= 0) {
+            return 0;
+        }
+        if ((uint32_t)remaining < wait) {
+            wait = remaining;
+        }
+    }
+    
+    return wait;
+}
+
+void Scheduler::run() {
+    start();
+    
+    for (;;) {
+        uint32_t wait = runDue();
+        if (wait > 0) {
+            vTaskDelay(pdMS_TO_TICKS(wait));
+        }
+    }
+}
+
+uint8_t Scheduler::getJobCount() {
+    return jobCount;
+}
+
+const SchedulerJob* Scheduler::getJob(uint8_t index) {
+    return index < jobCount ? &jobs[index] : nullptr;
+}
+
+float Scheduler::getLoad() {
+    unsigned long elapsed = millis() - startTime;
+    if (!started || elapsed == 0) {
+        return 0.0f;
+    }
+    
+    return (float)busyTime / (elapsed * 10.0f);
+}
+
+void Scheduler::printStats() {
+    for (uint8_t i = 0; i < jobCount; i++) {
+        const SchedulerJob& job = jobs[i];
+        
+        Serial.print("SCH,");
+        Serial.print(name);
+        Serial.print(",");
+        Serial.print(job.name);
+        Serial.print(",");
+        Serial.print(job.runs);
+        Serial.print(",");
+        Serial.print(job.overruns);
+        Serial.print(",");
+        Serial.print(job.skipped);
+        Serial.print(",");
+        Serial.print(job.maxLateness);
+        Serial.print(",");
+        Serial.print(job.maxExecTime);
+        for (uint8_t bin = 0; bin < SCHEDULER_HISTOGRAM_BINS; bin++) {
+            Serial.print(",");
+            Serial.print(job.latenessHistogram[bin]);
+        }
+        Serial.println();
+    }
+    
+    Serial.print("SCH,");
+    Serial.print(name);
+    Serial.print(",load,");
+    Serial.println(getLoad(), 1);
+}
@@ -0,0 +1,68 @@
+#include "serial_console.h"
+
+SerialConsole::SerialConsole() {
+    commandCount = 0;
+    lineLength = 0;
+    line[0] = '\0';
+}
+
+bool SerialConsole::addCommand(const char* name, const char* help, ConsoleHandler handler) {
+    if (commandCount >= CONSOLE_MAX_COMMANDS) {
+        Serial.println("串口命令注册失败");
+        return false;
+    }
+    
+    commands[commandCount].name = name;
+    commands[commandCount].help = help;
+    commands[commandCount].handler = handler;
+    commandCount++;
+    return true;
+}
+
+void SerialConsole::poll() {
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        
+        if (c == '\r' || c == '\n') {
+            if (lineLength > 0) {
+                line[lineLength] = '\0';
+                execute();
+                lineLength = 0;
+            }
+        } else if (lineLength < CONSOLE_LINE_LENGTH - 1) {
+            line[lineLength++] = c;
+        }
+    }
+}
+
+void SerialConsole::execute() {
+    // 拆分命令名和参数
+    char* args = strchr(line, ' ');
+    if (args != nullptr) {
+        *args++ = '\0';
+        while (*args == ' ') {
+            args++;
+        }
+    } else {
+        args = line + lineLength;
+    }
+    
+    if (strcmp(line, "help") == 0) {
+        for (uint8_t i = 0; i < commandCount; i++) {
+            Serial.print(commands[i].name);
+            Serial.print(" - ");
+            Serial.println(commands[i].help);
+        }
+        return;
+    }
+    
+    for (uint8_t i = 0; i < commandCount; i++) {
+        if (strcmp(line, commands[i].name) == 0) {
+            commands[i].handler(args);
+            return;
+        }
+    }
+    
+    Serial.print("未知命令: ");
+    Serial.println(line);
+}
@@ -1,12 +1,44 @@
 #include "temp_sensor.h"
 #include <math.h>
+#include <driver/gpio.h>
+#include <hal/gpio_ll.h>
+#include "profiler.h"
+
+// 转换完成信号 (ALERT/RDY中断 -> 采样任务)
+static SemaphoreHandle_t g_adsReady = nullptr;
+static int8_t g_readyPin = -1;
+
+static void IRAM_ATTR adsReadyInterrupt() {
+    // 转换期间为了唤醒light sleep临时改成了低电平触发，RDY在读取结果前一直为低，
+    // 第一次进入中断就恢复为下降沿，避免反复触发
+    gpio_dev_t* hw = GPIO_LL_GET_HW(GPIO_PORT_0);
+    gpio_ll_wakeup_disable(hw, (gpio_num_t)g_readyPin);
+    gpio_ll_set_intr_type(hw, (gpio_num_t)g_readyPin, GPIO_INTR_NEGEDGE);
+    
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(g_adsReady, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+// ADS1115单端输入通道对应的多路复用配置
+static const uint16_t ADS_MUX_SINGLE[4] = {
+    ADS1X15_REG_CONFIG_MUX_SINGLE_0,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_1,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_2,
+    ADS1X15_REG_CONFIG_MUX_SINGLE_3
+};
 
 TempSensor::TempSensor() {
     initialized = false;
+    arbiter = nullptr;
+    readyPin = -1;
+    recorder = nullptr;
     lastTemp = 0.0f;
     tempOffset = 0.0f;
     bufferIndex = 0;
-    lastSampleTime = 0;
+    lastSupplyVoltage = 0.0f;
     
     // 初始化温度缓冲区
     for (int i = 0; i < 10; i++) {
@@ -15,8 +47,11 @@ TempSensor::TempSensor() {
 }
 
 bool TempSensor::begin() {
+    lockBus();
+    
     // 初始化ADS1115
     if (!ads.begin(ADS1115_ADDR)) {
+        unlockBus();
         Serial.println("无法初始化ADS1115");
         return false;
     }
@@ -28,19 +63,104 @@ bool TempSensor::begin() {
     // 注：直接使用值 0x4 对应128SPS (参考Adafruit_ADS1X15.h文档)
     ads.setDataRate(0x4);
     
+    unlockBus();
+    
     initialized = true;
     Serial.println("ADS1115初始化成功");
     
     // 读取初始温度值并填充缓冲区
-    float initialTemp = readTemperature();
+    sample();
+    float initialTemp = lastTemp;
     for (int i = 0; i < 10; i++) {
         tempBuffer[i] = initialTemp;
     }
     
+    // 读取初始电源电压
+    sampleSupplyVoltage();
+    
     return true;
 }
 
+void TempSensor::attachBus(I2CArbiter* _arbiter) {
+    arbiter = _arbiter;
+}
+
+void TempSensor::attachReadyPin(int8_t pin) {
+    g_adsReady = xSemaphoreCreateBinary();
+    if (g_adsReady == nullptr) {
+        Serial.println("ADS1115 RDY信号量创建失败");
+        return;
+    }
+    
+    // Adafruit库启动单次转换时已将比较器配置为转换完成输出 (低电平有效)
+    readyPin = pin;
+    g_readyPin = pin;
+    pinMode(readyPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(readyPin), adsReadyInterrupt, FALLING);
+}
+
+void TempSensor::lockBus() {
+    if (arbiter != nullptr) {
+        arbiter->acquire(I2C_CLIENT_SENSOR);
+    }
+}
+
+void TempSensor::unlockBus() {
+    if (arbiter != nullptr) {
+        arbiter->release(I2C_CLIENT_SENSOR);
+    }
+}
+
+bool TempSensor::readChannel(uint8_t channel, int16_t& code) {
+    // 启动单次转换后立即释放总线，显示刷新可以利用转换时间
+    lockBus();
+    ads.startADCReading(ADS_MUX_SINGLE[channel], false);
+    unlockBus();
+    
+    // 等待转换完成: 有RDY引脚时由中断唤醒，否则按转换时间延时
+    if (readyPin >= 0) {
+        // 转换开始后RDY为高，此时才改为低电平触发 (GPIO只能由电平唤醒light sleep)；
+        // 上一次转换结束后RDY保持为低，提前设置会立即触发。转换若已完成也会立即触发，不会漏掉
+        xSemaphoreTake(g_adsReady, 0);  // 清除上一次的信号
+        gpio_wakeup_enable((gpio_num_t)readyPin, GPIO_INTR_LOW_LEVEL);
+        xSemaphoreTake(g_adsReady, pdMS_TO_TICKS(ADS_CONVERSION_TIME_MS * 2));
+        
+        // 中断已恢复下降沿触发；超时未进入中断时在这里恢复
+        gpio_wakeup_disable((gpio_num_t)readyPin);
+        gpio_set_intr_type((gpio_num_t)readyPin, GPIO_INTR_NEGEDGE);
+    } else {
+        delay(ADS_CONVERSION_TIME_MS);
+    }
+    
+    // 轮询转换完成并读取结果
+    unsigned long start = millis();
+    for (;;) {
+        bool done;
+        {
+            PROFILE_ZONE(PROF_ZONE_ADC_READ);
+            lockBus();
+            done = ads.conversionComplete();
+            if (done) {
+                code = ads.getLastConversionResults();
+            }
+            unlockBus();
+        }
+        
+        if (done) {
+            return true;
+        }
+        
+        if (millis() - start >= ADS_CONVERSION_TIMEOUT_MS) {
+            return false;
+        }
+        
+        delay(1);
+    }
+}
+
 float TempSensor::voltageToTemp(float voltage) {
+    PROFILE_ZONE(PROF_ZONE_VOLTAGE_TO_TEMP);
+    
     // 计算NTC电阻值
     float ntcR = NTC_SERIES_R * (NTC_VCC / voltage - 1.0f);
     
@@ -72,35 +192,72 @@ float TempSensor::applyFilter(float newTemp) {
     return sum / 10.0f;
 }
 
-float TempSensor::readTemperature() {
+bool TempSensor::sample() {
     if (!initialized) {
-        return -999.0f; // 错误值
+        return false;
     }
     
-    // 检查采样间隔
-    unsigned long now = millis();
-    if (now - lastSampleTime < TEMP_SAMPLE_INTERVAL && lastSampleTime > 0) {
-        return lastTemp;
+    // 读取ADS1115，转换超时则保持上一次读数
+    int16_t adc;
+    if (!readChannel(NTC_CHANNEL, adc)) {
+        return false;
     }
     
-    lastSampleTime = now;
-    
-    // 读取ADS1115
-    int16_t adc = ads.readADC_SingleEnded(NTC_CHANNEL);
+    if (recorder != nullptr) {
+        recorder->record(TRACE_ADC, NTC_CHANNEL, adc, millis());
+    }
+    processRawCode(adc);
     
+    return true;
+}
+
+void TempSensor::processRawCode(int16_t code) {
     // 转换为电压
-    float voltage = ads.computeVolts(adc);
+    float voltage = ads.computeVolts(code);
     
     // 转换为温度
     float rawTemp = voltageToTemp(voltage);
     
-    // 应用滤波
-    float filteredTemp = applyFilter(rawTemp);
+    // 应用滤波并存储为最后一次读数
+    lastTemp = applyFilter(rawTemp);
+}
+
+void TempSensor::processSupplyCode(int16_t code) {
+    lastSupplyVoltage = ads.computeVolts(code) * SUPPLY_DIVIDER_RATIO;
+}
+
+void TempSensor::attachRecorder(TraceRecorder* _recorder) {
+    recorder = _recorder;
+}
+
+bool TempSensor::sampleSupplyVoltage() {
+    if (!initialized) {
+        return false;
+    }
     
-    // 存储为最后一次读数
-    lastTemp = filteredTemp;
+    // 读取分压点电压并换算为电源电压
+    int16_t adc;
+    if (!readChannel(SUPPLY_CHANNEL, adc)) {
+        return false;
+    }
+    if (recorder != nullptr) {
+        recorder->record(TRACE_ADC, SUPPLY_CHANNEL, adc, millis());
+    }
+    processSupplyCode(adc);
+    
+    return true;
+}
+
+float TempSensor::readTemperature() {
+    if (!initialized) {
+        return -999.0f; // 错误值
+    }
     
-    return filteredTemp;
+    return lastTemp;
+}
+
+float TempSensor::readSupplyVoltage() {
+    return lastSupplyVoltage;
 }
 
 void TempSensor::setCalibration(float offset) {
@@ -0,0 +1,115 @@
+#include "temp_trend.h"
+
+// 每一级尺度的一列由多少个下一级单位组成 (第0级为控制周期采样)
+static const uint8_t SCALE_RATIO[TREND_SCALE_COUNT] = {
+    TREND_SAMPLES_PER_COLUMN, TREND_SCALE_RATIO_10MIN, TREND_SCALE_RATIO_1H
+};
+
+static const char* const SCALE_NAMES[TREND_SCALE_COUNT] = {"1min", "10min", "1h"};
+
+TempTrend::TempTrend() {
+    clear();
+}
+
+void TempTrend::clear() {
+    for (uint8_t scale = 0; scale < TREND_SCALE_COUNT; scale++) {
+        for (uint16_t i = 0; i < TREND_COLUMNS; i++) {
+            columns[scale][i].minValue = INT16_MAX;
+            columns[scale][i].maxValue = INT16_MIN;
+        }
+        pending[scale].minValue = INT16_MAX;
+        pending[scale].maxValue = INT16_MIN;
+        pendingCount[scale] = 0;
+        head[scale] = 0;
+        columnCount[scale] = 0;
+    }
+}
+
+void TempTrend::merge(TrendColumn& column, int16_t minValue, int16_t maxValue) {
+    if (minValue < column.minValue) {
+        column.minValue = minValue;
+    }
+    if (maxValue > column.maxValue) {
+        column.maxValue = maxValue;
+    }
+}
+
+void TempTrend::push(uint8_t scale, const TrendColumn& column) {
+    columns[scale][head[scale]] = column;
+    head[scale] = (head[scale] + 1) % TREND_COLUMNS;
+    columnCount[scale]++;
+
+    // 合并到上一级尺度的当前列，够数时该列完成
+    uint8_t upper = scale + 1;
+    if (upper >= TREND_SCALE_COUNT) {
+        return;
+    }
+    merge(pending[upper], column.minValue, column.maxValue);
+    if (++pendingCount[upper] >= SCALE_RATIO[upper]) {
+        TrendColumn done = pending[upper];
+        pending[upper].minValue = INT16_MAX;
+        pending[upper].maxValue = INT16_MIN;
+        pendingCount[upper] = 0;
+        push(upper, done);
+    }
+}
+
+void TempTrend::addSample(float temperature) {
+    // 超出int16范围的读数 (传感器故障) 限幅后记录
+    int32_t value = lroundf(temperature * 10.0f);
+    if (value > INT16_MAX - 1) value = INT16_MAX - 1;
+    if (value < INT16_MIN + 1) value = INT16_MIN + 1;
+
+    merge(pending[0], value, value);
+    if (++pendingCount[0] >= SCALE_RATIO[0]) {
+        TrendColumn done = pending[0];
+        pending[0].minValue = INT16_MAX;
+        pending[0].maxValue = INT16_MIN;
+        pendingCount[0] = 0;
+        push(0, done);
+    }
+}
+
+uint32_t TempTrend::getColumnCount(uint8_t scale) {
+    if (scale >= TREND_SCALE_COUNT) {
+        return 0;
+    }
+    return columnCount[scale];
+}
+
+TrendColumn TempTrend::getColumn(uint8_t scale, uint16_t age) {
+    TrendColumn column;
+    column.minValue = INT16_MAX;
+    column.maxValue = INT16_MIN;
+    if (scale >= TREND_SCALE_COUNT || age >= TREND_COLUMNS || age >= columnCount[scale]) {
+        return column;
+    }
+
+    uint16_t index = (head[scale] + TREND_COLUMNS - 1 - age) % TREND_COLUMNS;
+    return columns[scale][index];
+}
+
+bool TempTrend::getRange(uint8_t scale, int16_t* minValue, int16_t* maxValue) {
+    if (scale >= TREND_SCALE_COUNT || columnCount[scale] == 0) {
+        return false;
+    }
+
+    // 空列的最小值为INT16_MAX、最大值为INT16_MIN，合并时自然被忽略
+    TrendColumn range;
+    range.minValue = INT16_MAX;
+    range.maxValue = INT16_MIN;
+    for (uint16_t i = 0; i < TREND_COLUMNS; i++) {
+        merge(range, columns[scale][i].minValue, columns[scale][i].maxValue);
+    }
+
+    *minValue = range.minValue;
+    *maxValue = range.maxValue;
+    return true;
+}
+
+const char* TempTrend::getScaleName(uint8_t scale) {
+    if (scale >= TREND_SCALE_COUNT) {
+        return "";
+    }
+    return SCALE_NAMES[scale];
+}
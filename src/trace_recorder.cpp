@@ -0,0 +1,214 @@
+#include "trace_recorder.h"
+
+TraceRecorder::TraceRecorder() {
+    head = 0;
+    count = 0;
+    mode = TRACE_MODE_IDLE;
+    replayStartTime = 0;
+    firstTimestamp = 0;
+    mux = portMUX_INITIALIZER_UNLOCKED;
+    
+    for (int i = 0; i < TRACE_SOURCE_COUNT; i++) {
+        replayCursor[i] = 0;
+    }
+}
+
+const TraceRecord& TraceRecorder::at(uint16_t index) {
+    // 缓冲区未写满时最旧记录在0，写满后在head
+    uint16_t oldest = count < TRACE_BUFFER_SIZE ? 0 : head;
+    return buffer[(oldest + index) % TRACE_BUFFER_SIZE];
+}
+
+TraceSource TraceRecorder::sourceOf(uint8_t type) {
+    switch (type) {
+        case TRACE_ADC:
+            return TRACE_SOURCE_SENSOR;
+        case TRACE_COMMAND:
+        case TRACE_SETTING:
+            return TRACE_SOURCE_CONTROL;
+        default:
+            return TRACE_SOURCE_INPUT;
+    }
+}
+
+void TraceRecorder::startRecording() {
+    portENTER_CRITICAL(&mux);
+    head = 0;
+    count = 0;
+    mode = TRACE_MODE_RECORDING;
+    portEXIT_CRITICAL(&mux);
+    
+    Serial.println("开始记录");
+}
+
+void TraceRecorder::stop() {
+    if (mode == TRACE_MODE_RECORDING) {
+        Serial.print("记录结束, 条数: ");
+        Serial.println(count);
+    } else if (mode == TRACE_MODE_REPLAYING) {
+        Serial.println("回放结束");
+    }
+    
+    mode = TRACE_MODE_IDLE;
+}
+
+void TraceRecorder::clear() {
+    portENTER_CRITICAL(&mux);
+    head = 0;
+    count = 0;
+    portEXIT_CRITICAL(&mux);
+}
+
+bool TraceRecorder::startReplay(uint32_t now) {
+    if (mode != TRACE_MODE_IDLE || count == 0) {
+        return false;
+    }
+    
+    for (int i = 0; i < TRACE_SOURCE_COUNT; i++) {
+        replayCursor[i] = 0;
+    }
+    firstTimestamp = at(0).timestamp;
+    replayStartTime = now;
+    mode = TRACE_MODE_REPLAYING;
+    
+    Serial.print("开始回放, 条数: ");
+    Serial.println(count);
+    return true;
+}
+
+void TraceRecorder::record(TraceType type, uint8_t channel, int16_t value, uint32_t timestamp) {
+    if (mode != TRACE_MODE_RECORDING) {
+        return;
+    }
+    
+    portENTER_CRITICAL(&mux);
+    TraceRecord& entry = buffer[head];
+    entry.timestamp = timestamp;
+    entry.type = type;
+    entry.channel = channel;
+    entry.value = value;
+    head = (head + 1) % TRACE_BUFFER_SIZE;
+    if (count < TRACE_BUFFER_SIZE) {
+        count++;
+    }
+    portEXIT_CRITICAL(&mux);
+}
+
+void TraceRecorder::recordSetting(TraceSetting setting, float value, uint32_t timestamp) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    record(TRACE_SETTING, setting * 2, (int16_t)(bits & 0xFFFF), timestamp);
+    record(TRACE_SETTING, setting * 2 + 1, (int16_t)(bits >> 16), timestamp);
+}
+
+bool TraceRecorder::append(const TraceRecord& entry) {
+    if (mode != TRACE_MODE_IDLE || count >= TRACE_BUFFER_SIZE) {
+        return false;
+    }
+    
+    buffer[head] = entry;
+    head = (head + 1) % TRACE_BUFFER_SIZE;
+    count++;
+    return true;
+}
+
+bool TraceRecorder::nextReplay(TraceSource source, uint32_t now, TraceRecord& entry) {
+    if (mode != TRACE_MODE_REPLAYING) {
+        return false;
+    }
+    
+    // 跳过不属于该消费者的记录
+    uint16_t& cursor = replayCursor[source];
+    while (cursor < count && sourceOf(at(cursor).type) != source) {
+        cursor++;
+    }
+    if (cursor >= count) {
+        return false;
+    }
+    
+    // 按记录之间的原始时间间隔回放
+    const TraceRecord& next = at(cursor);
+    uint32_t due = replayStartTime + (next.timestamp - firstTimestamp);
+    if ((int32_t)(now - due) < 0) {
+        return false;
+    }
+    
+    entry = next;
+    entry.timestamp = due;
+    cursor++;
+    return true;
+}
+
+bool TraceRecorder::isRecording() {
+    return mode == TRACE_MODE_RECORDING;
+}
+
+bool TraceRecorder::isReplaying() {
+    return mode == TRACE_MODE_REPLAYING;
+}
+
+bool TraceRecorder::replayFinished() {
+    for (int i = 0; i < TRACE_SOURCE_COUNT; i++) {
+        // 游标可能停在另一个消费者的记录上，检查之后是否还有自己的记录
+        for (uint16_t index = replayCursor[i]; index < count; index++) {
+            if (sourceOf(at(index).type) == i) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint16_t TraceRecorder::getCount() {
+    return count;
+}
+
+void TraceRecorder::dump() {
+    char line[24];
+    
+    Serial.print("TRC,BEGIN,");
+    Serial.println(count);
+    
+    for (uint16_t i = 0; i < count; i++) {
+        const TraceRecord& entry = at(i);
+        snprintf(line, sizeof(line), "TRC,%08lX%02X%02X%04X",
+                 (unsigned long)entry.timestamp, entry.type, entry.channel, (uint16_t)entry.value);
+        Serial.println(line);
+    }
+    
+    Serial.println("TRC,END");
+}
+
+bool TraceRecorder::parseRecord(const char* hex, TraceRecord& entry) {
+    if (strlen(hex) != 16) {
+        return false;
+    }
+    
+    char field[9];
+    char* end;
+    
+    memcpy(field, hex, 8);
+    field[8] = '\0';
+    entry.timestamp = strtoul(field, &end, 16);
+    if (*end != '\0') {
+        return false;
+    }
+    
+    memcpy(field, hex + 8, 2);
+    field[2] = '\0';
+    entry.type = strtoul(field, &end, 16);
+    if (*end != '\0' || entry.type < TRACE_ADC || entry.type > TRACE_SETTING) {
+        return false;
+    }
+    
+    memcpy(field, hex + 10, 2);
+    entry.channel = strtoul(field, &end, 16);
+    if (*end != '\0') {
+        return false;
+    }
+    
+    memcpy(field, hex + 12, 4);
+    field[4] = '\0';
+    entry.value = (int16_t)strtoul(field, &end, 16);
+    return *end == '\0';
+}
@@ -1,13 +1,71 @@
 #include "ui_adapter.h"
 
-UIAdapter::UIAdapter(Adafruit_SSD1306* _display, TempSensor* _tempSensor, 
-                    PIDController* _pidController, PWMController* _pwmController,
-                    UserInput* _userInput) {
+// PAGE_NAMES和PAGE_INPUT按UIPage的数值逐项排列 (表长为UI_PAGE_COUNT，缺少的项会被补零而不报错)，
+// 增删或调整页面时必须同步修改这两张表和下面的检查
+static_assert(UI_PAGE_COUNT == 8, "UIPage增删了页面，需同步更新PAGE_NAMES和PAGE_INPUT");
+static_assert(UI_PAGE_MAIN == 0 && UI_PAGE_MENU == 1 && UI_PAGE_PID_MENU == 2 && UI_PAGE_CALIBRATION == 3 &&
+              UI_PAGE_SYSTEM_INFO == 4 && UI_PAGE_PROFILER == 5 && UI_PAGE_TREND == 6 && UI_PAGE_ERROR == 7,
+              "UIPage顺序改变，需同步调整PAGE_NAMES和PAGE_INPUT");
+
+// 页面名称 (串口命令和测试输出使用)，顺序与UIPage一致
+static const char* const PAGE_NAMES[UI_PAGE_COUNT] = {
+    "main", "menu", "pid", "cal", "info", "prof", "trend", "error"
+};
+
+// 菜单定义: 编译期常量表，标题和参数范围都在Flash中，不占用RAM
+static constexpr MenuItem MAIN_MENU_ITEMS[] = {
+    {"PID Parameters", ITEM_SUBMENU, UI_PAGE_PID_MENU,    PARAM_NONE,       0.0f, 0.0f, 0.0f},
+    {"Calibration",    ITEM_SUBMENU, UI_PAGE_CALIBRATION, PARAM_NONE,       0.0f, 0.0f, 0.0f},
+    {"System Info",    ITEM_SUBMENU, UI_PAGE_SYSTEM_INFO, PARAM_NONE,       0.0f, 0.0f, 0.0f},
+    {"Heating",        ITEM_SWITCH,  UI_PAGE_MAIN,        PARAM_HEATING,    0.0f, 0.0f, 0.0f},
+    {"Burst Mode",     ITEM_SWITCH,  UI_PAGE_MAIN,        PARAM_BURST_MODE, 0.0f, 0.0f, 0.0f},
+    {"Profiler",       ITEM_SUBMENU, UI_PAGE_PROFILER,    PARAM_NONE,       0.0f, 0.0f, 0.0f},
+    {"Trend",          ITEM_SUBMENU, UI_PAGE_TREND,       PARAM_NONE,       0.0f, 0.0f, 0.0f},
+    {"Reset Defaults", ITEM_NORMAL,  UI_PAGE_MAIN,        PARAM_NONE,       0.0f, 0.0f, 0.0f}
+};
+
+static constexpr MenuItem PID_MENU_ITEMS[] = {
+    {"Kp Value",       ITEM_SLIDER,  UI_PAGE_MAIN,        PARAM_PID_KP,     0.1f, 100.0f, 0.5f},
+    {"Ki Value",       ITEM_SLIDER,  UI_PAGE_MAIN,        PARAM_PID_KI,     0.0f, 10.0f,  0.05f},
+    {"Kd Value",       ITEM_SLIDER,  UI_PAGE_MAIN,        PARAM_PID_KD,     0.0f, 50.0f,  0.5f},
+    {"Save & Apply",   ITEM_NORMAL,  UI_PAGE_MAIN,        PARAM_NONE,       0.0f, 0.0f,   0.0f},
+    {"Auto Tune",      ITEM_NORMAL,  UI_PAGE_MAIN,        PARAM_NONE,       0.0f, 0.0f,   0.0f},
+    {"Back",           ITEM_SUBMENU, UI_PAGE_MENU,        PARAM_NONE,       0.0f, 0.0f,   0.0f}
+};
+
+static constexpr MenuItem CALIBRATION_MENU_ITEMS[] = {
+    {"Temp Offset",    ITEM_SLIDER,  UI_PAGE_MAIN,        PARAM_TEMP_OFFSET, -10.0f, 10.0f, 0.1f}
+};
+
+#define MENU_SIZE(items) (sizeof(items) / sizeof(items[0]))
+
+static constexpr MenuDefinition MAIN_MENU = {"MAIN MENU", MAIN_MENU_ITEMS, MENU_SIZE(MAIN_MENU_ITEMS)};
+static constexpr MenuDefinition PID_MENU = {"PID PARAMETERS", PID_MENU_ITEMS, MENU_SIZE(PID_MENU_ITEMS)};
+static constexpr MenuDefinition CALIBRATION_MENU = {"TEMP CALIBRATION", CALIBRATION_MENU_ITEMS, MENU_SIZE(CALIBRATION_MENU_ITEMS)};
+
+// 输入分发表: 旋转、单击、双击、长按，顺序与UIPage一致
+const UIAdapter::PageInput UIAdapter::PAGE_INPUT[UI_PAGE_COUNT] = {
+    // 主页面: 旋转调整目标温度，单击进入菜单
+    {&UIAdapter::adjustTarget, &UIAdapter::openMenu, nullptr, nullptr},
+    // 主菜单/PID菜单
+    {&UIAdapter::rotateMenu, &UIAdapter::selectMenuItem, &UIAdapter::leaveMenu, nullptr},
+    {&UIAdapter::rotateMenu, &UIAdapter::selectMenuItem, &UIAdapter::leaveMenu, nullptr},
+    // 校准页面: 单击完成校准
+    {&UIAdapter::adjustCalibration, &UIAdapter::goBack, nullptr, nullptr},
+    // 系统信息/性能分析页面: 点击返回
+    {nullptr, &UIAdapter::goBack, &UIAdapter::goBack, nullptr},
+    {nullptr, &UIAdapter::goBack, &UIAdapter::goBack, nullptr},
+    // 趋势页面: 旋转切换时间尺度，点击返回
+    {&UIAdapter::rotateTrendScale, &UIAdapter::goBack, &UIAdapter::goBack, nullptr},
+    // 错误页面: 长按清除错误
+    {nullptr, nullptr, nullptr, &UIAdapter::resetError}
+};
+
+UIAdapter::UIAdapter(Adafruit_SSD1306* _display, UserInput* _userInput) {
     display = _display;
-    tempSensor = _tempSensor;
-    pidController = _pidController;
-    pwmController = _pwmController;
     userInput = _userInput;
+    flusher = nullptr;
+    control = nullptr;
     
     // 初始化状态
     currentPage = UI_PAGE_MAIN;
@@ -18,7 +76,16 @@ UIAdapter::UIAdapter(Adafruit_SSD1306* _display, TempSensor* _tempSensor,
     
     // 初始化动画参数
     animationFrame = 0;
-    lastRefreshTime = 0;
+    
+    // 第一次update()绘制整页
+    generation = 1;
+    renderedGeneration = 0;
+    dirtyFlags = UI_DIRTY_ALL;
+    lastClockSecond = 0;
+    renderedFrames = 0;
+    skippedFrames = 0;
+    pageChanged = true;
+    framePending = false;
     
     // 初始化错误信息
     errorCode = ERROR_NONE;
@@ -29,11 +96,10 @@ UIAdapter::UIAdapter(Adafruit_SSD1306* _display, TempSensor* _tempSensor,
     targetTemp = TEMP_DEFAULT;
     powerPercentage = 0;
     systemState = STATE_IDLE;
+    sessionEnergy = 0.0f;
+    lifetimeEnergy = 0.0f;
     
-    // 初始化菜单项计数
-    mainMenuItemCount = 0;
-    pidMenuItemCount = 0;
-    calibrationMenuItemCount = 0;
+    shownMenu = nullptr;
 }
 
 bool UIAdapter::begin() {
@@ -42,606 +108,776 @@ bool UIAdapter::begin() {
         return false;
     }
     
-    // 初始化菜单项
-    initMenuItems();
+    // 创建页面控件
+    buildScreens();
     
     initialized = true;
     Serial.println("UI适配器初始化成功");
     return true;
 }
 
+void UIAdapter::attachFlusher(OledFlusher* _flusher) {
+    flusher = _flusher;
+}
+
+void UIAdapter::attachTrend(TempTrend* trend) {
+    trendPlot.setSource(trend);
+}
+
+void UIAdapter::attachControl(ControlChannel* _control) {
+    control = _control;
+}
+
 void UIAdapter::update() {
     if (!initialized) {
         return;
     }
     
-    // 限制刷新率
-    unsigned long now = millis();
-    if (now - lastRefreshTime < UI_REFRESH_INTERVAL) {
+    // 运行时间每秒变化一次
+    uint32_t second = millis() / 1000;
+    if (second != lastClockSecond) {
+        lastClockSecond = second;
+        markDirty(UI_DIRTY_CLOCK);
+    }
+    
+    // 趋势记录完成新列时滚动趋势图
+    if (currentPage == UI_PAGE_TREND && trendPlot.hasNewColumns()) {
+        markDirty(UI_DIRTY_TREND);
+    }
+    
+    // 当前页面用到的数据没有变化且没有动画时不绘制，不占用总线；
+    // 有帧等待提交时动画不再前进，避免按重试周期加速
+    bool animating = isAnimating();
+    bool changed = renderedGeneration != generation && (dirtyFlags & pageDirtyMask(currentPage)) != 0;
+    if (changed || (animating && !framePending)) {
+        // 上一帧仍在后台传输时也照常绘制: 刷新任务只读前台缓冲，帧缓冲是后台缓冲，
+        // 绘制与传输重叠，传输完成后提交的是最新的一帧
+        if (drawFrame(animating)) {
+            renderedFrames++;
+            framePending = true;
+        } else {
+            skippedFrames++;
+        }
+    } else {
+        skippedFrames++;
+    }
+    
+    if (!framePending) {
         return;
     }
-    lastRefreshTime = now;
     
-    // 清屏
-    display->clearDisplay();
+    // 显示: 交给刷新任务在后台发送，刷新任务忙时保留这一帧到下一次调用再提交
+    if (flusher != nullptr) {
+        framePending = !flusher->submit();
+    } else {
+        PROFILE_ZONE(PROF_ZONE_FLUSH);
+        display->display();
+        framePending = false;
+    }
+}
+
+bool UIAdapter::drawFrame(bool animating) {
+    uint16_t flags = dirtyFlags;
+    renderedGeneration = generation;
+    dirtyFlags = 0;
+    
+    PROFILE_ZONE(PROF_ZONE_DRAW);
+    
+    // 页面切换后清屏并重绘全部控件，否则只重绘内容变化的控件
+    WidgetScreen* screen = getScreen(currentPage);
+    if (pageChanged) {
+        pageChanged = false;
+        display->clearDisplay();
+        screen->invalidateAll();
+    }
     
     // 更新动画帧
-    animationFrame = (animationFrame + 1) % 8;
+    if (animating) {
+        animationFrame = (animationFrame + 1) % 8;
+    }
     
-    // 根据当前页面绘制
-    switch (currentPage) {
-        case UI_PAGE_MAIN:
-            drawMainPage();
+    // 把数据写入当前页面的控件；没有控件变化 (数据变化未达到显示精度) 时返回false，不发送
+    bool scrolled = bindPage(currentPage, flags);
+    return screen->render(display) || scrolled;
+}
+
+bool UIAdapter::hasPendingFrame() {
+    return framePending;
+}
+
+void UIAdapter::benchmark(uint16_t iterations) {
+    if (!initialized || iterations == 0) {
+        return;
+    }
+    
+    // 菜单选择和编辑状态属于当前页面，测试期间从第一项开始
+    uint8_t savedSelection = menuSelection;
+    bool savedEditing = valueEditing;
+    menuSelection = 0;
+    valueEditing = false;
+    
+    for (uint8_t i = 0; i < UI_PAGE_COUNT; i++) {
+        UIPage page = (UIPage)i;
+        uint64_t total = 0;
+        uint32_t longest = 0;
+        for (uint16_t n = 0; n < iterations; n++) {
+            uint32_t start = ESP.getCycleCount();
+            renderPage(page);
+            uint32_t cycles = ESP.getCycleCount() - start;
+            total += cycles;
+            if (cycles > longest) {
+                longest = cycles;
+            }
+        }
+        
+        Serial.print("BENCH,");
+        Serial.print(getPageName(page));
+        Serial.print(",");
+        Serial.print(iterations);
+        Serial.print(",");
+        Serial.print(profiler.cyclesToMicros(total / iterations));
+        Serial.print(",");
+        Serial.println(profiler.cyclesToMicros(longest));
+        
+        // 页面之间让出CPU，空闲任务得以运行，不触发任务看门狗
+        delay(1);
+    }
+    
+    // 帧缓冲已被改写，恢复当前页面
+    menuSelection = savedSelection;
+    valueEditing = savedEditing;
+    redraw();
+}
+
+void UIAdapter::snapshot(UIPage page) {
+    if (!initialized) {
+        return;
+    }
+    
+    uint8_t savedSelection = menuSelection;
+    bool savedEditing = valueEditing;
+    if (page != currentPage) {
+        menuSelection = 0;
+        valueEditing = false;
+    }
+    renderPage(page);
+    
+    // 去掉每行的 "PBM," 前缀即为plain PBM (P1) 文件，1为点亮
+    const uint8_t* buffer = display->getBuffer();
+    char row[SCREEN_WIDTH + 1];
+    Serial.print("PBM,BEGIN,");
+    Serial.println(getPageName(page));
+    Serial.println("PBM,P1");
+    Serial.print("PBM,");
+    Serial.print(SCREEN_WIDTH);
+    Serial.print(" ");
+    Serial.println(SCREEN_HEIGHT);
+    for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+        const uint8_t* bytes = buffer + (y / 8) * SCREEN_WIDTH;
+        for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+            row[x] = (bytes[x] >> (y & 7)) & 1 ? '1' : '0';
+        }
+        row[SCREEN_WIDTH] = '\0';
+        Serial.print("PBM,");
+        Serial.println(row);
+    }
+    Serial.println("PBM,END");
+    
+    menuSelection = savedSelection;
+    valueEditing = savedEditing;
+    redraw();
+}
+
+bool UIAdapter::handleControlInput(const InputEvent& event) {
+    if (control == nullptr) {
+        return false;
+    }
+    
+    switch (event.type) {
+        case EV_SINGLE_CLICK:
+            // 单击启动加热 (在主界面)
+            if (systemState == STATE_IDLE && currentPage == UI_PAGE_MAIN) {
+                control->postCommand(CMD_START);
+                return true;
+            }
             break;
-        case UI_PAGE_MENU:
-            drawMainMenu();
+            
+        case EV_DOUBLE_CLICK:
+            // 双击停止加热 (在任何页面)
+            if (systemState == STATE_WORKING) {
+                control->postCommand(CMD_STOP);
+                return true;
+            }
             break;
-        case UI_PAGE_PID_MENU:
-            drawPIDMenu();
+            
+        case EV_LONG_PRESS:
+            // 长按在错误状态下复位
+            if (systemState == STATE_ERROR) {
+                control->postCommand(CMD_RESET);
+            }
             break;
-        case UI_PAGE_CALIBRATION:
-            drawCalibrationPage();
+            
+        default:
             break;
-        case UI_PAGE_SYSTEM_INFO:
-            drawSystemInfoPage();
+    }
+    return false;
+}
+
+void UIAdapter::handleInput(const InputEvent& event) {
+    PROFILE_ZONE(PROF_ZONE_HANDLE_INPUT);
+    
+    if (event.type == EV_NONE) {
+        return;
+    }
+    
+    // 输入可能改变选择项或编辑中的值 (页面切换由setPage另行标记)
+    markDirty(currentPage == UI_PAGE_MAIN ? UI_DIRTY_TARGET : UI_DIRTY_INPUT);
+    
+    // 按当前页面的分发表找到处理函数
+    const PageInput& input = PAGE_INPUT[currentPage];
+    InputHandler handler = nullptr;
+    int16_t steps = 0;
+    switch (event.type) {
+        case EV_ROTATE_CW:
+            handler = input.rotate;
+            steps = event.steps;
             break;
-        case UI_PAGE_ERROR:
-            drawErrorPage();
+        case EV_ROTATE_CCW:
+            handler = input.rotate;
+            steps = -event.steps;
             break;
+        case EV_SINGLE_CLICK:
+            handler = input.click;
+            break;
+        case EV_DOUBLE_CLICK:
+            handler = input.doubleClick;
+            break;
+        case EV_LONG_PRESS:
+            handler = input.longPress;
+            break;
+        default:
+            break;
+    }
+    
+    if (handler != nullptr) {
+        (this->*handler)(steps);
+    }
+}
+
+void UIAdapter::adjustTarget(int16_t steps) {
+    // 每格1°C
+    targetTemp += 1.0f * steps;
+    if (targetTemp > TEMP_MAX) targetTemp = TEMP_MAX;
+    if (targetTemp < TEMP_MIN) targetTemp = TEMP_MIN;
+}
+
+void UIAdapter::openMenu(int16_t /*steps*/) {
+    setPage(UI_PAGE_MENU);
+}
+
+void UIAdapter::rotateMenu(int16_t steps) {
+    const MenuDefinition* menu = getMenu(currentPage);
+    
+    // 编辑模式调整选中的滑块，否则循环移动选择
+    if (valueEditing) {
+        adjustSlider(menu->items[menuSelection], steps);
+        return;
+    }
+    int16_t count = menu->itemCount;
+    menuSelection = ((menuSelection + steps) % count + count) % count;
+}
+
+void UIAdapter::selectMenuItem(int16_t /*steps*/) {
+    // 单击完成编辑
+    if (valueEditing) {
+        valueEditing = false;
+        return;
     }
     
-    // 显示
-    display->display();
+    const MenuItem& item = getMenu(currentPage)->items[menuSelection];
+    switch (item.type) {
+        case ITEM_SWITCH:
+            toggleSwitch(item.param);
+            break;
+        case ITEM_SLIDER:
+            // 进入值编辑模式
+            valueEditing = true;
+            break;
+        case ITEM_SUBMENU:
+            setPage(item.targetPage);
+            break;
+        default:
+            // 普通菜单项不做任何操作
+            break;
+    }
+}
+
+void UIAdapter::leaveMenu(int16_t /*steps*/) {
+    if (!valueEditing) {
+        setPage(previousPage);
+    }
+}
+
+void UIAdapter::adjustCalibration(int16_t steps) {
+    adjustSlider(CALIBRATION_MENU.items[0], steps);
+}
+
+void UIAdapter::rotateTrendScale(int16_t steps) {
+    int16_t scale = ((trendPlot.getScale() + steps) % TREND_SCALE_COUNT + TREND_SCALE_COUNT) % TREND_SCALE_COUNT;
+    trendPlot.setScale(scale);
+}
+
+void UIAdapter::goBack(int16_t /*steps*/) {
+    setPage(previousPage);
+}
+
+void UIAdapter::resetError(int16_t /*steps*/) {
+    clearError();
+    setPage(UI_PAGE_MAIN);
 }
 
-void UIAdapter::handleInput() {
-    // 获取用户输入事件
-    userInput->update();
-    EncoderEvent event = userInput->getEvent();
+void UIAdapter::buildScreens() {
+    // 主页面: 左侧目标温度和功率，右侧当前温度 (大号数字，0.1°C)，底部状态
+    mainTarget.setBounds(0, 0, 60, 8);
+    mainTarget.setFormat(0, "[", "] SET");
+    mainPower.setBounds(0, 30, 24, 8);
+    mainPower.setFormat(0, "", "%");
+    mainBar.setBounds(20, 30, 40, 10);
+    mainBar.setAnimated(true);
+    mainTemp.setBounds(62, 16, 60, BIG_DIGIT_HEIGHT);
+    mainTemp.attachFramebuffer(display->getBuffer());
+    mainUnit.setBounds(122, 16, 6, 8);
+    mainUnit.setText("C");
+    mainState.setBounds(0, 54, 66, 8);
+    mainHint.setBounds(68, 54, 60, 8);
+    mainHint.setText("Click:MENU");
+    mainScreen.add(&mainTarget);
+    mainScreen.add(&mainPower);
+    mainScreen.add(&mainBar);
+    mainScreen.add(&mainTemp);
+    mainScreen.add(&mainUnit);
+    mainScreen.add(&mainState);
+    mainScreen.add(&mainHint);
+    
+    // 菜单页面: 标题、最多4行列表、操作提示 (提示超出一行，边界延伸到屏幕底部)
+    menuTitle.setBounds(0, 0, SCREEN_WIDTH, 11);
+    menuTitle.setUnderline(true);
+    menuSelector.setBounds(0, 13, 120, 41);
+    menuList.setBounds(0, 13, SCREEN_WIDTH, 41);
+    menuList.setLayout(4, 10);
+    menuList.attachSelector(&menuSelector);
+    menuHint.setBounds(0, 55, SCREEN_WIDTH, 9);
+    menuScreen.add(&menuTitle);
+    menuScreen.add(&menuSelector);
+    menuScreen.add(&menuList);
+    menuScreen.add(&menuHint);
+    
+    // 校准页面
+    calibrationTitle.setBounds(0, 0, SCREEN_WIDTH, 11);
+    calibrationTitle.setUnderline(true);
+    calibrationTitle.setText(CALIBRATION_MENU.title);
+    calibrationCurrent.setBounds(0, 15, SCREEN_WIDTH, 8);
+    calibrationCurrent.setFormat(1, "Current: ", "C");
+    calibrationReal.setBounds(0, 25, SCREEN_WIDTH, 8);
+    calibrationReal.setFormat(1, "Set Real: ", "C");
+    calibrationOffset.setBounds(0, 35, SCREEN_WIDTH, 8);
+    calibrationOffset.setFormat(1, "Offset: ", "C");
+    calibrationHint.setBounds(0, 55, SCREEN_WIDTH, 9);
+    calibrationHint.setText("Rotate:Adj Click:Save");
+    calibrationScreen.add(&calibrationTitle);
+    calibrationScreen.add(&calibrationCurrent);
+    calibrationScreen.add(&calibrationReal);
+    calibrationScreen.add(&calibrationOffset);
+    calibrationScreen.add(&calibrationHint);
+    
+    // 系统信息页面
+    infoTitle.setBounds(0, 0, SCREEN_WIDTH, 11);
+    infoTitle.setUnderline(true);
+    infoTitle.setText("SYSTEM INFORMATION");
+    infoVersion.setBounds(0, 15, SCREEN_WIDTH, 8);
+    infoVersion.setText("Version: " SYSTEM_VERSION);
+    infoUptime.setBounds(0, 25, SCREEN_WIDTH, 8);
+    infoPID.setBounds(0, 35, SCREEN_WIDTH, 8);
+    infoEnergy.setBounds(0, 45, SCREEN_WIDTH, 8);
+    infoHint.setBounds(0, 55, SCREEN_WIDTH, 9);
+    infoHint.setText("Click: Return");
+    infoScreen.add(&infoTitle);
+    infoScreen.add(&infoVersion);
+    infoScreen.add(&infoUptime);
+    infoScreen.add(&infoPID);
+    infoScreen.add(&infoEnergy);
+    infoScreen.add(&infoHint);
+    
+    // 性能分析页面: 每个区段一行，列宽6/5/5个字符 (x = 0/36/66/96)
+    profilerHeader.setBounds(0, 0, SCREEN_WIDTH, 10);
+    profilerHeader.setUnderline(true);
+    profilerHeader.setText("us    avg  p99  max");
+    profilerScreen.add(&profilerHeader);
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        profilerRows[i].setBounds(0, 11 + i * 9, SCREEN_WIDTH, 8);
+        profilerScreen.add(&profilerRows[i]);
+    }
     
-    // 根据当前页面和事件处理
-    switch (currentPage) {
+    // 温度趋势页面: 两行文字，下方6页为趋势图 (按页对齐，新列到来时整字节平移)
+    trendTitle.setBounds(0, 0, SCREEN_WIDTH, 8);
+    trendRange.setBounds(0, 8, SCREEN_WIDTH, 8);
+    trendPlot.setBounds(0, 16, SCREEN_WIDTH, SCREEN_HEIGHT - 16);
+    trendPlot.attachFramebuffer(display->getBuffer());
+    trendScreen.add(&trendTitle);
+    trendScreen.add(&trendRange);
+    trendScreen.add(&trendPlot);
+    
+    // 错误页面 (错误消息可能换行，占两行)
+    errorTitle.setBounds(0, 0, SCREEN_WIDTH, 11);
+    errorTitle.setUnderline(true);
+    errorTitle.setText("ERROR DETECTED!");
+    errorCodeLabel.setBounds(0, 15, SCREEN_WIDTH, 8);
+    errorText.setBounds(0, 25, SCREEN_WIDTH, 16);
+    errorHeater.setBounds(0, 45, SCREEN_WIDTH, 8);
+    errorHeater.setText("Heater: DISABLED");
+    errorHint.setBounds(0, 55, SCREEN_WIDTH, 9);
+    errorHint.setText("Long press to reset");
+    errorScreen.add(&errorTitle);
+    errorScreen.add(&errorCodeLabel);
+    errorScreen.add(&errorText);
+    errorScreen.add(&errorHeater);
+    errorScreen.add(&errorHint);
+}
+
+bool UIAdapter::bindPage(UIPage page, uint16_t flags) {
+    switch (page) {
         case UI_PAGE_MAIN:
-            // 主页面输入处理
-            switch (event) {
-                case EV_SINGLE_CLICK:
-                    // 在主页面单击进入菜单
-                    setPage(UI_PAGE_MENU);
-                    break;
-                    
-                case EV_ROTATE_CW:
-                    // 顺时针旋转增加目标温度
-                    targetTemp += 1.0f;
-                    if (targetTemp > TEMP_MAX) targetTemp = TEMP_MAX;
-                    break;
-                    
-                case EV_ROTATE_CCW:
-                    // 逆时针旋转减少目标温度
-                    targetTemp -= 1.0f;
-                    if (targetTemp < TEMP_MIN) targetTemp = TEMP_MIN;
-                    break;
-                    
-                default:
-                    break;
-            }
+            bindMainPage();
             break;
-            
         case UI_PAGE_MENU:
+            bindMenu(&MAIN_MENU, flags);
+            break;
         case UI_PAGE_PID_MENU:
-            // 菜单页面通用处理
-            MenuItem* currentMenuItems;
-            uint8_t itemCount;
-            
-            if (currentPage == UI_PAGE_MENU) {
-                currentMenuItems = mainMenuItems;
-                itemCount = mainMenuItemCount;
-            } else {
-                currentMenuItems = pidMenuItems;
-                itemCount = pidMenuItemCount;
-            }
-            
-            if (valueEditing) {
-                // 正在编辑值
-                switch (event) {
-                    case EV_SINGLE_CLICK:
-                        // 单击完成编辑
-                        valueEditing = false;
-                        break;
-                        
-                    case EV_ROTATE_CW:
-                        // 增加值
-                        if (currentMenuItems[menuSelection].type == ITEM_SLIDER) {
-                            *currentMenuItems[menuSelection].valuePtr += currentMenuItems[menuSelection].stepValue;
-                            if (*currentMenuItems[menuSelection].valuePtr > currentMenuItems[menuSelection].maxValue) {
-                                *currentMenuItems[menuSelection].valuePtr = currentMenuItems[menuSelection].maxValue;
-                            }
-                        }
-                        break;
-                        
-                    case EV_ROTATE_CCW:
-                        // 减少值
-                        if (currentMenuItems[menuSelection].type == ITEM_SLIDER) {
-                            *currentMenuItems[menuSelection].valuePtr -= currentMenuItems[menuSelection].stepValue;
-                            if (*currentMenuItems[menuSelection].valuePtr < currentMenuItems[menuSelection].minValue) {
-                                *currentMenuItems[menuSelection].valuePtr = currentMenuItems[menuSelection].minValue;
-                            }
-                        }
-                        break;
-                        
-                    default:
-                        break;
-                }
-            } else {
-                // 正常菜单导航
-                switch (event) {
-                    case EV_SINGLE_CLICK:
-                        // 单击选择菜单项
-                        switch (currentMenuItems[menuSelection].type) {
-                            case ITEM_NORMAL:
-                                // 普通菜单项不做任何操作
-                                break;
-                                
-                            case ITEM_SWITCH:
-                                // 切换开关值
-                                if (currentMenuItems[menuSelection].valuePtr != nullptr) {
-                                    *currentMenuItems[menuSelection].valuePtr = !(*currentMenuItems[menuSelection].valuePtr);
-                                }
-                                break;
-                                
-                            case ITEM_SLIDER:
-                                // 进入值编辑模式
-                                valueEditing = true;
-                                break;
-                                
-                            case ITEM_SUBMENU:
-                                // 进入子菜单
-                                setPage(currentMenuItems[menuSelection].targetPage);
-                                menuSelection = 0; // 重置菜单选择
-                                break;
-                        }
-                        break;
-                        
-                    case EV_DOUBLE_CLICK:
-                        // 双击返回上一级
-                        setPage(previousPage);
-                        break;
-                        
-                    case EV_ROTATE_CW:
-                        // 向下移动菜单选择
-                        menuSelection = (menuSelection + 1) % itemCount;
-                        break;
-                        
-                    case EV_ROTATE_CCW:
-                        // 向上移动菜单选择
-                        if (menuSelection == 0)
-                            menuSelection = itemCount - 1;
-                        else
-                            menuSelection--;
-                        break;
-                        
-                    default:
-                        break;
-                }
-            }
+            bindMenu(&PID_MENU, flags);
             break;
-            
         case UI_PAGE_CALIBRATION:
-            // 校准页面输入处理
-            switch (event) {
-                case EV_SINGLE_CLICK:
-                    // 单击完成校准
-                    setPage(previousPage);
-                    break;
-                    
-                case EV_ROTATE_CW:
-                    // 校准页面值处理
-                    if (menuSelection < calibrationMenuItemCount) {
-                        *calibrationMenuItems[menuSelection].valuePtr += calibrationMenuItems[menuSelection].stepValue;
-                        if (*calibrationMenuItems[menuSelection].valuePtr > calibrationMenuItems[menuSelection].maxValue) {
-                            *calibrationMenuItems[menuSelection].valuePtr = calibrationMenuItems[menuSelection].maxValue;
-                        }
-                    }
-                    break;
-                    
-                case EV_ROTATE_CCW:
-                    // 校准页面值处理
-                    if (menuSelection < calibrationMenuItemCount) {
-                        *calibrationMenuItems[menuSelection].valuePtr -= calibrationMenuItems[menuSelection].stepValue;
-                        if (*calibrationMenuItems[menuSelection].valuePtr < calibrationMenuItems[menuSelection].minValue) {
-                            *calibrationMenuItems[menuSelection].valuePtr = calibrationMenuItems[menuSelection].minValue;
-                        }
-                    }
-                    break;
-                    
-                default:
-                    break;
-            }
+            bindCalibrationPage();
             break;
-            
         case UI_PAGE_SYSTEM_INFO:
-            // 系统信息页面输入处理
-            if (event == EV_SINGLE_CLICK || event == EV_DOUBLE_CLICK) {
-                // 点击返回
-                setPage(previousPage);
-            }
+            bindSystemInfoPage();
             break;
-            
+        case UI_PAGE_PROFILER:
+            bindProfilerPage();
+            break;
+        case UI_PAGE_TREND:
+            return bindTrendPage();
         case UI_PAGE_ERROR:
-            // 错误页面输入处理
-            if (event == EV_LONG_PRESS) {
-                // 长按清除错误
-                clearError();
-                setPage(UI_PAGE_MAIN);
-            }
+            bindErrorPage();
+            break;
+        default:
             break;
     }
+    return false;
 }
 
-void UIAdapter::drawMainPage() {
-    // 左侧：目标温度和功率百分比
-    display->setTextSize(1);
-    display->setCursor(0, 0);
-    display->print("[");
-    display->print((int)targetTemp);
-    display->print("] SET");
-    
-    // 功率百分比和动画条
-    display->setCursor(0, 30);
-    display->print(powerPercentage);
-    display->print("% ");
-    drawAnimatedBar(20, 30, 40, 10, powerPercentage);
-    
-    // 右侧：当前温度 (大字号)
-    display->setTextSize(2);
-    display->setCursor(70, 15);
-    display->print((int)currentTemp);
-    display->setTextSize(1);
-    display->print("C");
-    
-    // 系统状态
-    display->setTextSize(1);
-    display->setCursor(0, 54);
+void UIAdapter::renderPage(UIPage page) {
+    WidgetScreen* screen = getScreen(page);
+    display->clearDisplay();
+    screen->invalidateAll();
+    bindPage(page, UI_DIRTY_ALL);
+    screen->render(display);
+}
+
+const char* UIAdapter::getPageName(UIPage page) {
+    if (page >= UI_PAGE_COUNT) {
+        return "";
+    }
+    return PAGE_NAMES[page];
+}
+
+bool UIAdapter::findPage(const char* name, UIPage* page) {
+    for (uint8_t i = 0; i < UI_PAGE_COUNT; i++) {
+        if (strcmp(name, PAGE_NAMES[i]) == 0) {
+            *page = (UIPage)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+WidgetScreen* UIAdapter::getScreen(UIPage page) {
+    switch (page) {
+        case UI_PAGE_MENU:
+        case UI_PAGE_PID_MENU:
+            return &menuScreen;
+        case UI_PAGE_CALIBRATION:
+            return &calibrationScreen;
+        case UI_PAGE_SYSTEM_INFO:
+            return &infoScreen;
+        case UI_PAGE_PROFILER:
+            return &profilerScreen;
+        case UI_PAGE_TREND:
+            return &trendScreen;
+        case UI_PAGE_ERROR:
+            return &errorScreen;
+        default:
+            return &mainScreen;
+    }
+}
+
+void UIAdapter::bindMainPage() {
+    mainTarget.setValue(targetTemp);
+    mainPower.setValue(powerPercentage);
+    mainBar.setValue(powerPercentage);
+    mainBar.setFrame(animationFrame);
+    mainTemp.setValue(currentTemp);
     
     switch (systemState) {
         case STATE_IDLE:
-            display->print("IDLE");
+            mainState.setText("IDLE");
             break;
         case STATE_WORKING:
-            display->print("HEATING");
+            mainState.setText("HEATING");
             break;
         case STATE_CALIBRATION:
-            display->print("CALIBRATING");
+            mainState.setText("CALIBRATING");
             break;
         case STATE_MENU:
-            display->print("MENU");
+            mainState.setText("MENU");
             break;
         case STATE_ERROR:
-            display->print("ERROR!");
+            mainState.setText("ERROR!");
             break;
     }
-    
-    // 操作提示
-    display->setCursor(70, 54);
-    display->print("Click:MENU");
 }
 
-void UIAdapter::drawMainMenu() {
-    drawMenu(mainMenuItems, mainMenuItemCount, "MAIN MENU");
+void UIAdapter::menuRow(void* context, uint8_t index, ListRow& row) {
+    UIAdapter* ui = (UIAdapter*)context;
+    const MenuItem& item = ui->shownMenu->items[index];
+    row.title = item.title;
+    
+    // 根据类型显示右侧内容
+    switch (item.type) {
+        case ITEM_SWITCH:
+            strcpy(row.value, ui->getSwitch(item.param) ? "ON" : "OFF");
+            break;
+            
+        case ITEM_SLIDER:
+            TextBuilder(row.value, sizeof(row.value)).decimal(ui->getSlider(item.param), 1);
+            break;
+            
+        case ITEM_SUBMENU:
+            strcpy(row.value, ">");
+            row.valueX = 110;
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void UIAdapter::bindMenu(const MenuDefinition* menu, uint16_t flags) {
+    shownMenu = menu;
+    menuTitle.setText(menu->title);
+    menuList.setSource(menuRow, this, menu->itemCount);
+    menuList.setSelection(menuSelection);
+    menuSelector.setEditing(valueEditing);
+    menuHint.setText(valueEditing ? "Rotate:Adj Click:Save" : "Rotate:Move Click:OK");
+    
+    // 开关和滑块的值由输入改变，列表不知道值是否变化，输入后重绘
+    if (flags & UI_DIRTY_INPUT) {
+        menuList.invalidate();
+    }
+}
+
+void UIAdapter::bindCalibrationPage() {
+    calibrationCurrent.setValue(currentTemp);
+    calibrationReal.setValue(targetTemp);
+    calibrationOffset.setValue(getSlider(PARAM_TEMP_OFFSET));
+}
+
+void UIAdapter::bindSystemInfoPage() {
+    char text[UI_LABEL_LENGTH];
+    
+    // 系统运行时间
+    uint32_t runTime = millis() / 1000; // 秒
+    TextBuilder(text, sizeof(text)).text("Uptime: ").unsignedInteger(runTime / 3600).text("h ")
+        .unsignedInteger((runTime % 3600) / 60).text("m ").unsignedInteger(runTime % 60).text("s");
+    infoUptime.setText(text);
+    
+    // PID参数 (控制通道中的值，与菜单一致)
+    TextBuilder(text, sizeof(text)).text("PID: ").decimal(getSlider(PARAM_PID_KP), 1).text("/")
+        .decimal(getSlider(PARAM_PID_KI), 1).text("/").decimal(getSlider(PARAM_PID_KD), 1);
+    infoPID.setText(text);
+    
+    // 能耗统计 (本次/累计)
+    TextBuilder(text, sizeof(text)).text("E: ").decimal(sessionEnergy, 2).text("/").decimal(lifetimeEnergy, 1).text("Wh");
+    infoEnergy.setText(text);
 }
 
-void UIAdapter::drawPIDMenu() {
-    drawMenu(pidMenuItems, pidMenuItemCount, "PID PARAMETERS");
+void UIAdapter::bindProfilerPage() {
+    char text[UI_LABEL_LENGTH];
+    
+    // 每个区段一行: 名称 平均/p99/最大 (微秒)，各列从第0/6/11/16个字符开始
+    for (int i = 0; i < PROF_ZONE_COUNT; i++) {
+        ProfileZone zone = (ProfileZone)i;
+        TextBuilder(text, sizeof(text)).text(profiler.getZoneName(zone))
+            .pad(6).unsignedInteger(profiler.cyclesToMicros(profiler.getMean(zone)))
+            .pad(11).unsignedInteger(profiler.cyclesToMicros(profiler.getPercentile(zone, 990)))
+            .pad(16).unsignedInteger(profiler.cyclesToMicros(profiler.getMax(zone)));
+        profilerRows[i].setText(text);
+    }
 }
 
-void UIAdapter::drawCalibrationPage() {
-    display->setTextSize(1);
-    display->setCursor(0, 0);
-    display->println("TEMPERATURE CALIBRATION");
-    display->drawLine(0, 10, SCREEN_WIDTH, 10, SSD1306_WHITE);
+bool UIAdapter::bindTrendPage() {
+    char text[UI_LABEL_LENGTH];
     
-    // 当前读数和校准目标
-    display->setCursor(0, 15);
-    display->print("Current: ");
-    display->print(currentTemp, 1);
-    display->println("C");
+    // 先滚动，纵轴范围随新数据更新后再写入标签
+    bool scrolled = trendPlot.scroll();
     
-    display->setCursor(0, 25);
-    display->print("Set Real: ");
-    display->print(targetTemp, 1);
-    display->println("C");
+    TextBuilder(text, sizeof(text)).text("TREND ").text(TempTrend::getScaleName(trendPlot.getScale())).text(" Rot:Scale");
+    trendTitle.setText(text);
     
-    // 偏差
-    float offset = targetTemp - currentTemp;
-    display->setCursor(0, 35);
-    display->print("Offset: ");
-    display->print(offset, 1);
-    display->println("C");
+    int16_t low, high;
+    if (trendPlot.getRange(&low, &high)) {
+        TextBuilder(text, sizeof(text)).text("Y ").integer(low / 10).text("-").integer(high / 10).text("C Click:Back");
+        trendRange.setText(text);
+    } else {
+        trendRange.setText("Y -- Click:Back");
+    }
     
-    // 操作提示
-    display->setCursor(0, 55);
-    display->println("Rotate:Adjust  Click:Save");
+    return scrolled;
 }
 
-void UIAdapter::drawSystemInfoPage() {
-    display->setTextSize(1);
-    display->setCursor(0, 0);
-    display->println("SYSTEM INFORMATION");
-    display->drawLine(0, 10, SCREEN_WIDTH, 10, SSD1306_WHITE);
+void UIAdapter::bindErrorPage() {
+    char text[UI_LABEL_LENGTH];
     
-    // 版本信息
-    display->setCursor(0, 15);
-    display->print("Version: ");
-    display->println(SYSTEM_VERSION);
-    
-    // 系统运行时间
-    unsigned long runTime = millis() / 1000; // 秒
-    display->setCursor(0, 25);
-    display->print("Uptime: ");
-    display->print(runTime / 3600); // 小时
-    display->print("h ");
-    display->print((runTime % 3600) / 60); // 分钟
-    display->print("m ");
-    display->print(runTime % 60); // 秒
-    display->println("s");
-    
-    // PID参数
-    double kp, ki, kd;
-    pidController->getTunings(&kp, &ki, &kd);
-    display->setCursor(0, 35);
-    display->print("PID: ");
-    display->print(kp, 1);
-    display->print("/");
-    display->print(ki, 1);
-    display->print("/");
-    display->print(kd, 1);
-    
-    // 操作提示
-    display->setCursor(0, 55);
-    display->println("Click: Return");
-}
-
-void UIAdapter::drawErrorPage() {
-    display->setTextSize(1);
-    display->setCursor(0, 0);
-    display->println("ERROR DETECTED!");
-    display->drawLine(0, 10, SCREEN_WIDTH, 10, SSD1306_WHITE);
-    
-    // 错误代码和消息
-    display->setCursor(0, 15);
-    display->print("Code: E");
-    display->println(errorCode);
-    
-    display->setCursor(0, 25);
-    display->println(errorMessage);
-    
-    // 安全状态提示
-    display->setCursor(0, 45);
-    display->println("Heater: DISABLED");
-    
-    // 操作提示
-    display->setCursor(0, 55);
-    display->println("Long press to reset");
-}
-
-void UIAdapter::drawMenu(MenuItem* items, uint8_t itemCount, const char* title) {
-    // 标题
-    display->setTextSize(1);
-    display->setCursor(0, 0);
-    display->println(title);
-    display->drawLine(0, 10, SCREEN_WIDTH, 10, SSD1306_WHITE);
-    
-    // 确定显示的菜单项范围 (最多显示4项)
-    int startIdx = 0;
-    if (menuSelection > 1 && itemCount > 4) {
-        startIdx = menuSelection - 1;
-    }
-    if (startIdx + 4 > itemCount) {
-        startIdx = itemCount - 4;
-    }
-    if (startIdx < 0) {
-        startIdx = 0;
-    }
-    
-    // 绘制菜单项
-    for (int i = 0; i < 4 && i + startIdx < itemCount; i++) {
-        int idx = i + startIdx;
-        int y = 15 + i * 10;
-        
-        // 绘制选择器
-        if (idx == menuSelection) {
-            if (valueEditing) {
-                // 编辑模式下使用不同样式
-                display->fillRect(0, y - 1, 3, 9, SSD1306_WHITE);
-            } else {
-                // 选中项
-                drawSelector(y, 120);
-            }
-        }
-        
-        // 绘制菜单项文本
-        display->setCursor(5, y);
-        display->print(items[idx].title);
-        
-        // 根据类型绘制额外内容
-        switch (items[idx].type) {
-            case ITEM_SWITCH:
-                // 开关项
-                if (items[idx].valuePtr != nullptr) {
-                    display->setCursor(100, y);
-                    display->print(*items[idx].valuePtr > 0 ? "ON" : "OFF");
-                }
-                break;
-                
-            case ITEM_SLIDER:
-                // 滑块项
-                if (items[idx].valuePtr != nullptr) {
-                    display->setCursor(100, y);
-                    display->print(*items[idx].valuePtr, 1);
-                }
-                break;
-                
-            case ITEM_SUBMENU:
-                // 子菜单项
-                display->setCursor(110, y);
-                display->print(">");
-                break;
-                
-            default:
-                break;
-        }
+    TextBuilder(text, sizeof(text)).text("Code: E").integer(errorCode);
+    errorCodeLabel.setText(text);
+    errorText.setText(errorMessage);
+}
+
+const MenuDefinition* UIAdapter::getMenu(UIPage page) {
+    switch (page) {
+        case UI_PAGE_MENU:
+            return &MAIN_MENU;
+        case UI_PAGE_PID_MENU:
+            return &PID_MENU;
+        case UI_PAGE_CALIBRATION:
+            return &CALIBRATION_MENU;
+        default:
+            return nullptr;
     }
-    
-    // 操作提示
-    display->setCursor(0, 55);
-    if (valueEditing) {
-        display->println("Rotate:Adjust Click:Save");
-    } else {
-        display->println("Rotate:Move Click:Select");
+}
+
+bool UIAdapter::getSwitch(MenuParam param) {
+    switch (param) {
+        case PARAM_HEATING:
+            return systemState == STATE_WORKING;
+        case PARAM_BURST_MODE:
+            return control != nullptr && control->burstMode.load();
+        default:
+            return false;
     }
 }
 
-void UIAdapter::drawProgressBar(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t percentage) {
-    // 限制百分比范围
-    if (percentage > 100) {
-        percentage = 100;
+void UIAdapter::toggleSwitch(MenuParam param) {
+    switch (param) {
+        case PARAM_HEATING:
+            // 控制任务按当前状态处理，下一帧遥测同步开关显示
+            if (control != nullptr) {
+                control->postCommand(systemState == STATE_WORKING ? CMD_STOP : CMD_START);
+            }
+            break;
+        case PARAM_BURST_MODE:
+            // 控制任务在下一个周期开始时切换输出模式
+            if (control != nullptr) {
+                control->burstMode.store(!control->burstMode.load());
+                control->postCommand(CMD_SET_OUTPUT_MODE);
+            }
+            break;
+        default:
+            break;
     }
-    
-    // 绘制外框
-    display->drawRect(x, y, width, height, SSD1306_WHITE);
-    
-    // 计算填充宽度
-    uint16_t fillWidth = (percentage * (width - 2)) / 100;
-    
-    // 填充进度条
-    if (fillWidth > 0) {
-        display->fillRect(x + 1, y + 1, fillWidth, height - 2, SSD1306_WHITE);
+}
+
+float UIAdapter::getSlider(MenuParam param) {
+    // 参数以控制通道中的值为准，编辑后尚未被控制任务应用也能连续调整
+    switch (param) {
+        case PARAM_PID_KP:
+            return control != nullptr ? control->kp.load() : 0.0f;
+        case PARAM_PID_KI:
+            return control != nullptr ? control->ki.load() : 0.0f;
+        case PARAM_PID_KD:
+            return control != nullptr ? control->kd.load() : 0.0f;
+        case PARAM_TEMP_OFFSET:
+            return control != nullptr ? control->tempOffset.load() : 0.0f;
+        default:
+            return 0.0f;
+    }
+}
+
+void UIAdapter::setSlider(MenuParam param, float value) {
+    switch (param) {
+        case PARAM_PID_KP:
+        case PARAM_PID_KI:
+        case PARAM_PID_KD:
+            // PID参数由控制任务在周期开始时应用，不与计算并发修改
+            if (control == nullptr) {
+                break;
+            }
+            if (param == PARAM_PID_KP) {
+                control->kp.store(value);
+            } else if (param == PARAM_PID_KI) {
+                control->ki.store(value);
+            } else {
+                control->kd.store(value);
+            }
+            control->postCommand(CMD_SET_TUNINGS);
+            break;
+        case PARAM_TEMP_OFFSET:
+            // 校准值由控制任务应用，不与采样并发修改
+            if (control != nullptr) {
+                control->tempOffset.store(value);
+                control->postCommand(CMD_SET_CALIBRATION);
+            }
+            break;
+        default:
+            break;
     }
 }
 
-void UIAdapter::drawAnimatedBar(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint8_t percentage) {
-    // 先绘制基本进度条
-    drawProgressBar(x, y, width, height, percentage);
+void UIAdapter::adjustSlider(const MenuItem& item, int16_t steps) {
+    if (item.type != ITEM_SLIDER) {
+        return;
+    }
     
-    // 添加动画效果 (如果功率大于0)
-    if (percentage > 0) {
-        // 计算动画位置
-        uint16_t fillWidth = (percentage * (width - 2)) / 100;
-        uint16_t animPos = (animationFrame * fillWidth) / 8;
-        
-        // 绘制动画点
-        if (fillWidth > 2) {
-            display->drawPixel(x + 1 + animPos, y + height/2, !SSD1306_WHITE);
-        }
+    float value = getSlider(item.param) + item.stepValue * steps;
+    if (value > item.maxValue) value = item.maxValue;
+    if (value < item.minValue) value = item.minValue;
+    setSlider(item.param, value);
+}
+
+void UIAdapter::markDirty(uint16_t flags) {
+    dirtyFlags |= flags;
+    generation++;
+}
+
+uint16_t UIAdapter::pageDirtyMask(UIPage page) {
+    switch (page) {
+        case UI_PAGE_MAIN:
+            return UI_DIRTY_PAGE | UI_DIRTY_TEMP | UI_DIRTY_TARGET | UI_DIRTY_POWER | UI_DIRTY_STATE;
+        case UI_PAGE_CALIBRATION:
+            return UI_DIRTY_PAGE | UI_DIRTY_INPUT | UI_DIRTY_TEMP | UI_DIRTY_TARGET;
+        case UI_PAGE_SYSTEM_INFO:
+            return UI_DIRTY_PAGE | UI_DIRTY_INPUT | UI_DIRTY_CLOCK | UI_DIRTY_ENERGY;
+        case UI_PAGE_TREND:
+            return UI_DIRTY_PAGE | UI_DIRTY_INPUT | UI_DIRTY_TREND;
+        case UI_PAGE_ERROR:
+            return UI_DIRTY_PAGE | UI_DIRTY_INPUT | UI_DIRTY_ERROR;
+        default:
+            return UI_DIRTY_PAGE | UI_DIRTY_INPUT;
     }
 }
 
-void UIAdapter::drawSelector(uint16_t y, uint16_t width) {
-    // 绘制选择器框
-    display->drawRect(0, y - 2, width, 11, SSD1306_WHITE);
-    
-    // 左侧填充
-    display->fillRect(0, y - 1, 3, 9, SSD1306_WHITE);
-}
-
-void UIAdapter::initMenuItems() {
-    // 初始化主菜单项
-    mainMenuItemCount = 0;
-    
-    // 添加"PID参数"菜单项
-    strcpy(mainMenuItems[mainMenuItemCount].title, "PID Parameters");
-    mainMenuItems[mainMenuItemCount].type = ITEM_SUBMENU;
-    mainMenuItems[mainMenuItemCount].targetPage = UI_PAGE_PID_MENU;
-    mainMenuItemCount++;
-    
-    // 添加"校准"菜单项
-    strcpy(mainMenuItems[mainMenuItemCount].title, "Calibration");
-    mainMenuItems[mainMenuItemCount].type = ITEM_SUBMENU;
-    mainMenuItems[mainMenuItemCount].targetPage = UI_PAGE_CALIBRATION;
-    mainMenuItemCount++;
-    
-    // 添加"系统信息"菜单项
-    strcpy(mainMenuItems[mainMenuItemCount].title, "System Info");
-    mainMenuItems[mainMenuItemCount].type = ITEM_SUBMENU;
-    mainMenuItems[mainMenuItemCount].targetPage = UI_PAGE_SYSTEM_INFO;
-    mainMenuItemCount++;
-    
-    // 添加"加热控制"菜单项（开关类型）
-    strcpy(mainMenuItems[mainMenuItemCount].title, "Heating");
-    mainMenuItems[mainMenuItemCount].type = ITEM_SWITCH;
-    static float heatingEnabled = 0.0f; // 默认关闭
-    mainMenuItems[mainMenuItemCount].valuePtr = &heatingEnabled;
-    mainMenuItemCount++;
-    
-    // 添加"恢复默认"菜单项
-    strcpy(mainMenuItems[mainMenuItemCount].title, "Reset Defaults");
-    mainMenuItems[mainMenuItemCount].type = ITEM_NORMAL;
-    mainMenuItemCount++;
-    
-    // 初始化PID参数菜单项
-    pidMenuItemCount = 0;
-    
-    // 获取PID参数
-    double kp, ki, kd;
-    pidController->getTunings(&kp, &ki, &kd);
-    static float pidKp = kp;
-    static float pidKi = ki;
-    static float pidKd = kd;
-    
-    // 添加Kp参数项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Kp Value");
-    pidMenuItems[pidMenuItemCount].type = ITEM_SLIDER;
-    pidMenuItems[pidMenuItemCount].valuePtr = &pidKp;
-    pidMenuItems[pidMenuItemCount].minValue = 0.1f;
-    pidMenuItems[pidMenuItemCount].maxValue = 100.0f;
-    pidMenuItems[pidMenuItemCount].stepValue = 0.5f;
-    pidMenuItemCount++;
-    
-    // 添加Ki参数项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Ki Value");
-    pidMenuItems[pidMenuItemCount].type = ITEM_SLIDER;
-    pidMenuItems[pidMenuItemCount].valuePtr = &pidKi;
-    pidMenuItems[pidMenuItemCount].minValue = 0.0f;
-    pidMenuItems[pidMenuItemCount].maxValue = 10.0f;
-    pidMenuItems[pidMenuItemCount].stepValue = 0.05f;
-    pidMenuItemCount++;
-    
-    // 添加Kd参数项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Kd Value");
-    pidMenuItems[pidMenuItemCount].type = ITEM_SLIDER;
-    pidMenuItems[pidMenuItemCount].valuePtr = &pidKd;
-    pidMenuItems[pidMenuItemCount].minValue = 0.0f;
-    pidMenuItems[pidMenuItemCount].maxValue = 50.0f;
-    pidMenuItems[pidMenuItemCount].stepValue = 0.5f;
-    pidMenuItemCount++;
-    
-    // 添加"保存参数"项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Save & Apply");
-    pidMenuItems[pidMenuItemCount].type = ITEM_NORMAL;
-    pidMenuItemCount++;
-    
-    // 添加"自动调整"项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Auto Tune");
-    pidMenuItems[pidMenuItemCount].type = ITEM_NORMAL;
-    pidMenuItemCount++;
-    
-    // 添加"返回"项
-    strcpy(pidMenuItems[pidMenuItemCount].title, "Back");
-    pidMenuItems[pidMenuItemCount].type = ITEM_SUBMENU;
-    pidMenuItems[pidMenuItemCount].targetPage = UI_PAGE_MENU;
-    pidMenuItemCount++;
-    
-    // 初始化校准菜单项
-    calibrationMenuItemCount = 0;
-    
-    // 添加温度偏移项
-    static float tempOffset = tempSensor->getCalibration();
-    strcpy(calibrationMenuItems[calibrationMenuItemCount].title, "Temp Offset");
-    calibrationMenuItems[calibrationMenuItemCount].type = ITEM_SLIDER;
-    calibrationMenuItems[calibrationMenuItemCount].valuePtr = &tempOffset;
-    calibrationMenuItems[calibrationMenuItemCount].minValue = -10.0f;
-    calibrationMenuItems[calibrationMenuItemCount].maxValue = 10.0f;
-    calibrationMenuItems[calibrationMenuItemCount].stepValue = 0.1f;
-    calibrationMenuItemCount++;
+bool UIAdapter::isAnimating() {
+    // 主页面功率条动画、性能分析页面实时统计
+    return (currentPage == UI_PAGE_MAIN && powerPercentage > 0) || currentPage == UI_PAGE_PROFILER;
 }
 
 void UIAdapter::setPage(UIPage page) {
@@ -650,6 +886,8 @@ void UIAdapter::setPage(UIPage page) {
         currentPage = page;
         menuSelection = 0; // 重置菜单选择
         valueEditing = false; // 退出编辑模式
+        pageChanged = true;
+        markDirty(UI_DIRTY_PAGE);
     }
 }
 
@@ -657,23 +895,54 @@ UIPage UIAdapter::getPage() {
     return currentPage;
 }
 
+void UIAdapter::redraw() {
+    pageChanged = true;
+    markDirty(UI_DIRTY_PAGE);
+}
+
 void UIAdapter::setTemperature(float current, float target) {
+    // 按显示精度比较，读数噪声不触发重绘
+    if (lroundf(current * 10.0f) != lroundf(currentTemp * 10.0f)) {
+        markDirty(UI_DIRTY_TEMP);
+    }
+    if (target != targetTemp) {
+        markDirty(UI_DIRTY_TARGET);
+    }
+    
     currentTemp = current;
     targetTemp = target;
 }
 
 void UIAdapter::setPowerPercentage(uint8_t percentage) {
+    if (percentage != powerPercentage) {
+        markDirty(UI_DIRTY_POWER);
+    }
     powerPercentage = percentage;
 }
 
 void UIAdapter::setSystemState(SystemState state) {
+    if (state != systemState) {
+        markDirty(UI_DIRTY_STATE);
+    }
     systemState = state;
 }
 
+void UIAdapter::setEnergy(float session, float lifetime) {
+    // 系统信息页面显示本次2位小数、累计1位小数
+    if (lroundf(session * 100.0f) != lroundf(sessionEnergy * 100.0f) ||
+        lroundf(lifetime * 10.0f) != lroundf(lifetimeEnergy * 10.0f)) {
+        markDirty(UI_DIRTY_ENERGY);
+    }
+    
+    sessionEnergy = session;
+    lifetimeEnergy = lifetime;
+}
+
 void UIAdapter::showError(ErrorCode code, const char* message) {
     errorCode = code;
     strncpy(errorMessage, message, sizeof(errorMessage) - 1);
     errorMessage[sizeof(errorMessage) - 1] = '\0'; // 确保字符串结束
+    markDirty(UI_DIRTY_ERROR);
     
     // 自动切换到错误页面
     setPage(UI_PAGE_ERROR);
@@ -682,8 +951,34 @@ void UIAdapter::showError(ErrorCode code, const char* message) {
 void UIAdapter::clearError() {
     errorCode = ERROR_NONE;
     strcpy(errorMessage, "");
+    markDirty(UI_DIRTY_ERROR);
 }
 
 float UIAdapter::getTargetTemp() {
     return targetTemp;
-} 
\ No newline at end of file
+}
+
+void UIAdapter::setTargetTemp(float target) {
+    if (target > TEMP_MAX) target = TEMP_MAX;
+    if (target < TEMP_MIN) target = TEMP_MIN;
+    if (target != targetTemp) {
+        markDirty(UI_DIRTY_TARGET);
+    }
+    targetTemp = target;
+}
+
+uint32_t UIAdapter::getGeneration() {
+    return generation;
+}
+
+void UIAdapter::printStats() {
+    Serial.print("UI,");
+    Serial.print(renderedFrames);
+    Serial.print(",");
+    Serial.println(skippedFrames);
+}
+
+void UIAdapter::resetStats() {
+    renderedFrames = 0;
+    skippedFrames = 0;
+}
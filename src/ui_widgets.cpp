@@ -0,0 +1,636 @@
+#include "ui_widgets.h"
+
+// ---------------- Widget ----------------
+
+Widget::Widget() {
+    x = 0;
+    y = 0;
+    width = 0;
+    height = 0;
+    visible = true;
+    dirty = true;
+    next = nullptr;
+}
+
+void Widget::setBounds(int16_t _x, int16_t _y, uint8_t _width, uint8_t _height) {
+    x = _x;
+    y = _y;
+    width = _width;
+    height = _height;
+    dirty = true;
+}
+
+void Widget::setVisible(bool show) {
+    if (show != visible) {
+        visible = show;
+        dirty = true;
+    }
+}
+
+void Widget::invalidate() {
+    dirty = true;
+}
+
+bool Widget::isDirty() {
+    return dirty;
+}
+
+bool Widget::overlaps(const Widget* other) const {
+    return x < other->x + other->width && other->x < x + width &&
+           y < other->y + other->height && other->y < y + height;
+}
+
+// ---------------- Label ----------------
+
+Label::Label() {
+    text[0] = '\0';
+    textSize = 1;
+    underline = false;
+}
+
+void Label::setText(const char* _text) {
+    if (strncmp(text, _text, sizeof(text) - 1) == 0) {
+        return;
+    }
+    strncpy(text, _text, sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    dirty = true;
+}
+
+void Label::setTextSize(uint8_t size) {
+    if (size != textSize) {
+        textSize = size;
+        dirty = true;
+    }
+}
+
+void Label::setUnderline(bool enable) {
+    if (enable != underline) {
+        underline = enable;
+        dirty = true;
+    }
+}
+
+void Label::paint(Adafruit_GFX* gfx) {
+    // 按边界排版: 超出宽度的字符换到边界内的下一行，超出高度的字符不绘制，
+    // 不依赖GFX在屏幕边缘换行 (那样会画到边界外，且不会被清除)
+    const uint8_t charWidth = 6 * textSize;
+    const uint8_t charHeight = 8 * textSize;
+    uint8_t columns = width / charWidth;
+    uint8_t rows = height / charHeight;
+    uint8_t column = 0;
+    uint8_t row = 0;
+    
+    gfx->setTextSize(textSize);
+    for (const char* c = text; *c != '\0' && row < rows; c++) {
+        if (*c == '\n' || column >= columns) {
+            column = 0;
+            row++;
+            if (*c == '\n' || row >= rows) {
+                continue;
+            }
+        }
+        gfx->setCursor(x + column * charWidth, y + row * charHeight);
+        gfx->write((uint8_t)*c);
+        column++;
+    }
+    
+    if (underline) {
+        gfx->drawLine(x, y + height - 1, x + width - 1, y + height - 1, SSD1306_WHITE);
+    }
+}
+
+// ---------------- NumberField ----------------
+
+NumberField::NumberField() {
+    shownValue = 0;
+    decimals = 0;
+    prefix = "";
+    suffix = "";
+    textSize = 1;
+    suffixSize = 1;
+}
+
+void NumberField::setFormat(uint8_t _decimals, const char* _prefix, const char* _suffix, uint8_t _textSize, uint8_t _suffixSize) {
+    decimals = _decimals;
+    prefix = _prefix;
+    suffix = _suffix;
+    textSize = _textSize;
+    suffixSize = _suffixSize;
+    dirty = true;
+}
+
+void NumberField::setValue(float _value) {
+    // 按显示精度量化后比较，绘制时直接格式化量化值
+    int32_t shown = toFixed(_value, decimals);
+    if (shown != shownValue) {
+        shownValue = shown;
+        dirty = true;
+    }
+}
+
+void NumberField::paint(Adafruit_GFX* gfx) {
+    gfx->setTextSize(textSize);
+    gfx->setCursor(x, y);
+    gfx->print(prefix);
+    char text[NUM_FORMAT_LENGTH];
+    formatFixed(text, shownValue, decimals);
+    gfx->print(text);
+    gfx->setTextSize(suffixSize);
+    gfx->print(suffix);
+}
+
+// ---------------- BigNumberField ----------------
+
+BigNumberField::BigNumberField() {
+    shownValue = 0;
+    framebuffer = nullptr;
+}
+
+void BigNumberField::attachFramebuffer(uint8_t* buffer) {
+    framebuffer = buffer;
+    dirty = true;
+}
+
+void BigNumberField::setValue(float value) {
+    int32_t shown = toFixed(value, 1);
+    if (shown != shownValue) {
+        shownValue = shown;
+        dirty = true;
+    }
+}
+
+int16_t BigNumberField::blit(int16_t column, const uint8_t* glyph, uint8_t glyphWidth) {
+    // 水平裁剪到屏幕范围
+    int16_t start = column < 0 ? -column : 0;
+    int16_t end = column + glyphWidth > SCREEN_WIDTH ? SCREEN_WIDTH - column : glyphWidth;
+    
+    // 每页一行字节直接复制
+    uint8_t firstPage = y / 8;
+    for (uint8_t page = 0; page < BIG_DIGIT_PAGES && firstPage + page < OLED_PAGE_COUNT; page++) {
+        if (end > start) {
+            memcpy(framebuffer + (firstPage + page) * SCREEN_WIDTH + column + start,
+                   glyph + page * glyphWidth + start, end - start);
+        }
+    }
+    
+    return column + glyphWidth;
+}
+
+void BigNumberField::paint(Adafruit_GFX* gfx) {
+    // 格式化为整数和一位小数，不经过浮点格式化
+    char text[NUM_FORMAT_LENGTH];
+    uint8_t length = formatFixed(text, shownValue, 1);
+    
+    // 宽度不够时去掉小数部分 (四舍五入到整数)
+    int16_t textWidth = (length - 1) * BIG_DIGIT_WIDTH + BIG_DIGIT_POINT_WIDTH;
+    if (textWidth > width) {
+        int32_t rounded = shownValue < 0 ? -((-shownValue + 5) / 10) : (shownValue + 5) / 10;
+        length = formatInt(text, rounded);
+        textWidth = length * BIG_DIGIT_WIDTH;
+    }
+    
+    // 没有帧缓冲或未按页对齐时使用GFX字体
+    if (framebuffer == nullptr || (y & 7) != 0) {
+        gfx->setTextSize(2);
+        gfx->setCursor(x, y);
+        gfx->print(text);
+        return;
+    }
+    
+    int16_t column = x + width - textWidth;
+    for (uint8_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '.') {
+            column = blit(column, &BIG_DIGIT_POINT[0][0], BIG_DIGIT_POINT_WIDTH);
+        } else {
+            uint8_t index = c == '-' ? BIG_DIGIT_MINUS : c - '0';
+            column = blit(column, &BIG_DIGIT_GLYPHS[index][0][0], BIG_DIGIT_WIDTH);
+        }
+    }
+}
+
+// ---------------- BarWidget ----------------
+
+BarWidget::BarWidget() {
+    percentage = 0;
+    animated = false;
+    frame = 0;
+}
+
+void BarWidget::setValue(uint8_t _percentage) {
+    // 限制百分比范围
+    if (_percentage > 100) {
+        _percentage = 100;
+    }
+    if (_percentage != percentage) {
+        percentage = _percentage;
+        dirty = true;
+    }
+}
+
+void BarWidget::setAnimated(bool enable) {
+    if (enable != animated) {
+        animated = enable;
+        dirty = true;
+    }
+}
+
+void BarWidget::setFrame(uint8_t _frame) {
+    if (_frame != frame) {
+        frame = _frame;
+        if (animated && percentage > 0) {
+            dirty = true;
+        }
+    }
+}
+
+void BarWidget::paint(Adafruit_GFX* gfx) {
+    // 绘制外框
+    gfx->drawRect(x, y, width, height, SSD1306_WHITE);
+    
+    // 计算填充宽度
+    uint16_t fillWidth = (percentage * (width - 2)) / 100;
+    
+    // 填充进度条
+    if (fillWidth > 0) {
+        gfx->fillRect(x + 1, y + 1, fillWidth, height - 2, SSD1306_WHITE);
+    }
+    
+    // 动画点沿填充部分移动
+    if (animated && fillWidth > 2) {
+        uint16_t animPos = (frame * fillWidth) / 8;
+        gfx->drawPixel(x + 1 + animPos, y + height / 2, SSD1306_BLACK);
+    }
+}
+
+// ---------------- TrendWidget ----------------
+
+// 按TREND_RANGE_STEP向下取整 (负数同样向下)
+static int16_t floorToStep(int16_t value) {
+    int16_t steps = value / TREND_RANGE_STEP;
+    if (value % TREND_RANGE_STEP < 0) {
+        steps--;
+    }
+    return steps * TREND_RANGE_STEP;
+}
+
+TrendWidget::TrendWidget() {
+    source = nullptr;
+    framebuffer = nullptr;
+    scale = 0;
+    shownColumns = 0;
+    rangeLow = 0;
+    rangeHigh = TREND_MIN_SPAN;
+    hasData = false;
+}
+
+void TrendWidget::attachFramebuffer(uint8_t* buffer) {
+    framebuffer = buffer;
+    dirty = true;
+}
+
+void TrendWidget::setSource(TempTrend* _source) {
+    source = _source;
+    dirty = true;
+}
+
+void TrendWidget::setScale(uint8_t _scale) {
+    if (_scale >= TREND_SCALE_COUNT) {
+        _scale = 0;
+    }
+    if (_scale != scale) {
+        scale = _scale;
+        dirty = true;
+    }
+}
+
+uint8_t TrendWidget::getScale() {
+    return scale;
+}
+
+bool TrendWidget::hasNewColumns() {
+    return source != nullptr && source->getColumnCount(scale) != shownColumns;
+}
+
+void TrendWidget::computeRange(int16_t* low, int16_t* high, bool* valid) {
+    int16_t minValue, maxValue;
+    *valid = source != nullptr && source->getRange(scale, &minValue, &maxValue);
+    if (!*valid) {
+        *low = 0;
+        *high = TREND_MIN_SPAN;
+        return;
+    }
+    
+    // 范围取整到整步长，温度在同一区间内波动时纵轴不变，可以一直增量滚动
+    *low = floorToStep(minValue);
+    *high = -floorToStep(-maxValue);
+    int16_t span = *high - *low;
+    if (span < TREND_MIN_SPAN) {
+        *low -= floorToStep((TREND_MIN_SPAN - span) / 2);
+        *high = *low + TREND_MIN_SPAN;
+    }
+}
+
+int16_t TrendWidget::valueToRow(int16_t value) {
+    int32_t row = (int32_t)(rangeHigh - value) * (height - 1) / (rangeHigh - rangeLow);
+    if (row < 0) row = 0;
+    if (row > height - 1) row = height - 1;
+    return row;
+}
+
+void TrendWidget::drawColumn(int16_t column, const TrendColumn& data) {
+    bool empty = data.minValue > data.maxValue;
+    int16_t top = empty ? 0 : valueToRow(data.maxValue);
+    int16_t bottom = empty ? -1 : valueToRow(data.minValue);
+    
+    // 每页一个字节，最低位在上
+    uint8_t firstPage = y / 8;
+    for (uint8_t page = 0; page < height / 8; page++) {
+        int16_t pageTop = page * 8;
+        uint8_t bits = 0;
+        if (top <= pageTop + 7 && bottom >= pageTop) {
+            int16_t from = top > pageTop ? top - pageTop : 0;
+            int16_t to = bottom < pageTop + 7 ? bottom - pageTop : 7;
+            bits = (uint8_t)((0xFF << from) & (0xFF >> (7 - to)));
+        }
+        framebuffer[(firstPage + page) * SCREEN_WIDTH + column] = bits;
+    }
+}
+
+bool TrendWidget::scroll() {
+    if (source == nullptr || !visible) {
+        return false;
+    }
+    
+    // 已失效的控件由render()整图重绘，这里只更新纵轴范围供标签显示
+    if (dirty) {
+        computeRange(&rangeLow, &rangeHigh, &hasData);
+        return false;
+    }
+    
+    uint32_t count = source->getColumnCount(scale);
+    uint32_t newColumns = count - shownColumns;
+    if (newColumns == 0) {
+        return false;
+    }
+    
+    // 纵轴范围变化后全部列的高度都要重算
+    int16_t low, high;
+    bool valid;
+    computeRange(&low, &high, &valid);
+    if (valid != hasData || low != rangeLow || high != rangeHigh) {
+        rangeLow = low;
+        rangeHigh = high;
+        hasData = valid;
+        dirty = true;
+        return false;
+    }
+    
+    // 没有帧缓冲、未按页对齐或新列超过一屏时无法平移
+    if (framebuffer == nullptr || (y & 7) != 0 || (height & 7) != 0 || newColumns >= TREND_COLUMNS) {
+        dirty = true;
+        return false;
+    }
+    
+    // 绘图区每页左移newColumns列，再只画最右侧的新列
+    int16_t plotX = x + width - TREND_COLUMNS;
+    uint8_t firstPage = y / 8;
+    for (uint8_t page = 0; page < height / 8; page++) {
+        uint8_t* row = framebuffer + (firstPage + page) * SCREEN_WIDTH + plotX;
+        memmove(row, row + newColumns, TREND_COLUMNS - newColumns);
+    }
+    for (int16_t age = newColumns - 1; age >= 0; age--) {
+        drawColumn(plotX + TREND_COLUMNS - 1 - age, source->getColumn(scale, age));
+    }
+    
+    shownColumns = count;
+    return true;
+}
+
+bool TrendWidget::getRange(int16_t* low, int16_t* high) {
+    *low = rangeLow;
+    *high = rangeHigh;
+    return hasData;
+}
+
+void TrendWidget::paint(Adafruit_GFX* gfx) {
+    if (source == nullptr) {
+        return;
+    }
+    
+    computeRange(&rangeLow, &rangeHigh, &hasData);
+    shownColumns = source->getColumnCount(scale);
+    
+    // 纵轴: 竖线加顶部、中间、底部刻度
+    int16_t plotX = x + width - TREND_COLUMNS;
+    gfx->drawFastVLine(plotX - 2, y, height, SSD1306_WHITE);
+    gfx->drawFastHLine(plotX - 5, y, 3, SSD1306_WHITE);
+    gfx->drawFastHLine(plotX - 4, y + height / 2, 2, SSD1306_WHITE);
+    gfx->drawFastHLine(plotX - 5, y + height - 1, 3, SSD1306_WHITE);
+    
+    bool direct = framebuffer != nullptr && (y & 7) == 0 && (height & 7) == 0;
+    for (uint16_t age = 0; age < TREND_COLUMNS; age++) {
+        TrendColumn data = source->getColumn(scale, age);
+        int16_t column = plotX + TREND_COLUMNS - 1 - age;
+        if (direct) {
+            drawColumn(column, data);
+        } else if (data.minValue <= data.maxValue) {
+            int16_t top = valueToRow(data.maxValue);
+            gfx->drawFastVLine(column, y + top, valueToRow(data.minValue) - top + 1, SSD1306_WHITE);
+        }
+    }
+}
+
+// ---------------- SelectorWidget ----------------
+
+SelectorWidget::SelectorWidget() {
+    row = -1;
+    rowHeight = 10;
+    editing = false;
+}
+
+void SelectorWidget::setRowHeight(uint8_t _rowHeight) {
+    rowHeight = _rowHeight;
+    dirty = true;
+}
+
+void SelectorWidget::setRow(int8_t _row) {
+    if (_row != row) {
+        row = _row;
+        dirty = true;
+    }
+}
+
+void SelectorWidget::setEditing(bool enable) {
+    if (enable != editing) {
+        editing = enable;
+        dirty = true;
+    }
+}
+
+void SelectorWidget::paint(Adafruit_GFX* gfx) {
+    if (row < 0) {
+        return;
+    }
+    
+    int16_t top = y + row * rowHeight;
+    
+    // 选择器框 (编辑模式下只保留左侧竖条)
+    if (!editing) {
+        gfx->drawRect(x, top, width, rowHeight + 1, SSD1306_WHITE);
+    }
+    gfx->fillRect(x, top + 1, 3, rowHeight - 1, SSD1306_WHITE);
+}
+
+// ---------------- ListWidget ----------------
+
+ListWidget::ListWidget() {
+    rowFunction = nullptr;
+    context = nullptr;
+    selector = nullptr;
+    itemCount = 0;
+    selection = 0;
+    firstRow = 0;
+    visibleRows = 4;
+    rowHeight = 10;
+}
+
+void ListWidget::setLayout(uint8_t _visibleRows, uint8_t _rowHeight) {
+    visibleRows = _visibleRows;
+    rowHeight = _rowHeight;
+    if (selector != nullptr) {
+        selector->setRowHeight(rowHeight);
+    }
+    dirty = true;
+}
+
+void ListWidget::setSource(ListRowFunction _rowFunction, void* _context, uint8_t _itemCount) {
+    if (_rowFunction != rowFunction || _context != context || _itemCount != itemCount) {
+        rowFunction = _rowFunction;
+        context = _context;
+        itemCount = _itemCount;
+        scroll();
+        dirty = true;
+    }
+}
+
+void ListWidget::attachSelector(SelectorWidget* _selector) {
+    selector = _selector;
+    selector->setRowHeight(rowHeight);
+    scroll();
+}
+
+void ListWidget::setSelection(uint8_t _selection) {
+    if (_selection != selection) {
+        selection = _selection;
+        scroll();
+    }
+}
+
+void ListWidget::scroll() {
+    // 选中项之前保留一行，列表末尾不留空行
+    int first = 0;
+    if (selection > 1 && itemCount > visibleRows) {
+        first = selection - 1;
+    }
+    if (first + visibleRows > itemCount) {
+        first = itemCount - visibleRows;
+    }
+    if (first < 0) {
+        first = 0;
+    }
+    
+    if (first != firstRow) {
+        firstRow = first;
+        dirty = true;
+    }
+    if (selector != nullptr) {
+        selector->setRow(selection < itemCount ? selection - firstRow : -1);
+    }
+}
+
+void ListWidget::paint(Adafruit_GFX* gfx) {
+    if (rowFunction == nullptr) {
+        return;
+    }
+    
+    gfx->setTextSize(1);
+    for (uint8_t i = 0; i < visibleRows && firstRow + i < itemCount; i++) {
+        ListRow row;
+        row.title = "";
+        row.value[0] = '\0';
+        row.valueX = x + width - 28;
+        rowFunction(context, firstRow + i, row);
+        
+        // 文本在行内下移2像素，给选择器框留出空间
+        int16_t textY = y + 2 + i * rowHeight;
+        gfx->setCursor(x + 5, textY);
+        gfx->print(row.title);
+        if (row.value[0] != '\0') {
+            gfx->setCursor(row.valueX, textY);
+            gfx->print(row.value);
+        }
+    }
+}
+
+// ---------------- WidgetScreen ----------------
+
+WidgetScreen::WidgetScreen() {
+    first = nullptr;
+    last = nullptr;
+}
+
+void WidgetScreen::add(Widget* widget) {
+    widget->next = nullptr;
+    if (last == nullptr) {
+        first = widget;
+    } else {
+        last->next = widget;
+    }
+    last = widget;
+}
+
+void WidgetScreen::invalidateAll() {
+    for (Widget* widget = first; widget != nullptr; widget = widget->next) {
+        widget->dirty = true;
+    }
+}
+
+bool WidgetScreen::render(Adafruit_GFX* gfx) {
+    // 清除失效控件的边界会擦掉重叠控件的一部分，重叠的控件一起重绘
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (Widget* a = first; a != nullptr; a = a->next) {
+            if (!a->dirty) {
+                continue;
+            }
+            for (Widget* b = first; b != nullptr; b = b->next) {
+                if (!b->dirty && a->overlaps(b)) {
+                    b->dirty = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    // 先清除全部失效区域，再按顺序绘制，上层控件不会被下层的清除擦掉
+    bool drawn = false;
+    for (Widget* widget = first; widget != nullptr; widget = widget->next) {
+        if (widget->dirty) {
+            gfx->fillRect(widget->x, widget->y, widget->width, widget->height, SSD1306_BLACK);
+            drawn = true;
+        }
+    }
+    for (Widget* widget = first; widget != nullptr; widget = widget->next) {
+        if (widget->dirty) {
+            if (widget->visible) {
+                widget->paint(gfx);
+            }
+            widget->dirty = false;
+        }
+    }
+    
+    return drawn;
+}
@@ -1,125 +1,198 @@
 #include "user_input.h"
+#include "power_manager.h"
 
 // 全局变量用于中断处理
-static volatile bool g_buttonChanged = false;
+static SpscRing<ButtonEdge, INPUT_EDGE_QUEUE_SIZE> g_buttonEdges;
+static volatile uint32_t g_lastRotationTime = 0;
 static AiEsp32RotaryEncoder* g_encoder = nullptr;
 
 UserInput::UserInput() 
     : encoder(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_BTN_PIN, -1, ENCODER_STEPS_PER_NOTCH) {
     initialized = false;
+    recorder = nullptr;
+    replayMode = false;
     buttonPressed = false;
+    lastEdgeTime = 0;
     buttonPressTime = 0;
     lastButtonReleaseTime = 0;
     clickCount = 0;
     encoderValue = 0;
     encoderStep = 1;
-    processingLongPress = false;
-    processingDoubleClick = false;
 }
 
 bool UserInput::begin() {
+    // 存储全局指针，用于中断
+    g_encoder = &encoder;
+    
     // 初始化编码器
     encoder.begin();
-    encoder.setup(
-        [] { g_encoder->readEncoder_ISR(); },
-        [] { g_buttonChanged = true; }
-    );
+    encoder.setup(handleEncoderInterrupt, handleButtonInterrupt);
     
-    // 存储全局指针，用于中断
-    g_encoder = &encoder;
+    // 编码器库只在按钮上升沿触发中断，改为双边沿以记录按下和释放
+    attachInterrupt(digitalPinToInterrupt(ENCODER_BTN_PIN), handleButtonInterrupt, CHANGE);
     
     // 设置编码器相关属性
     encoder.setAcceleration(250); // 加速度，数值越大响应越灵敏
     
+    buttonPressed = digitalRead(ENCODER_BTN_PIN) == ENCODER_BTN_ACTIVE_LEVEL;
+    
     initialized = true;
     Serial.println("用户输入初始化成功");
     return true;
 }
 
-void UserInput::update() {
-    if (!initialized) {
+void UserInput::emit(EncoderEvent type, uint8_t steps, uint32_t timestamp) {
+    InputEvent event;
+    event.type = type;
+    event.steps = steps;
+    event.timestamp = timestamp;
+    events.push(event);
+}
+
+void UserInput::checkClickTimeout(uint32_t now) {
+    // 第一次释放后超过双击间隔仍没有第二次释放，确认为单击
+    if (clickCount == 1 && now - lastButtonReleaseTime > DOUBLE_CLICK_TIME) {
+        clickCount = 0;
+        emit(EV_SINGLE_CLICK, 0, lastButtonReleaseTime);
+    }
+}
+
+void UserInput::processEdge(const ButtonEdge& edge) {
+    // 记录消抖前的原始边沿，回放时重新经过同样的识别过程
+    if (recorder != nullptr) {
+        recorder->record(TRACE_BUTTON, 0, edge.level, edge.timestamp);
+    }
+    
+    bool pressed = edge.level == ENCODER_BTN_ACTIVE_LEVEL;
+    
+    // 消抖: 电平未变化或距上次有效边沿过近的边沿丢弃
+    if (pressed == buttonPressed || edge.timestamp - lastEdgeTime < INPUT_DEBOUNCE_MS) {
         return;
     }
+    lastEdgeTime = edge.timestamp;
+    buttonPressed = pressed;
     
-    // 处理按钮状态变化
-    if (g_buttonChanged) {
-        g_buttonChanged = false;
-        bool currentState = encoder.isEncoderButtonDown();
-        
-        // 按钮按下
-        if (currentState && !buttonPressed) {
-            buttonPressed = true;
-            buttonPressTime = millis();
-        }
-        // 按钮释放
-        else if (!currentState && buttonPressed) {
-            buttonPressed = false;
-            unsigned long pressDuration = millis() - buttonPressTime;
-            
-            // 检测长按
-            if (pressDuration >= LONG_PRESS_TIME) {
-                processingLongPress = true;
-            } 
-            // 检测单击/双击
-            else {
-                clickCount++;
-                if (clickCount == 1) {
-                    lastButtonReleaseTime = millis();
-                } else if (clickCount == 2) {
-                    processingDoubleClick = true;
-                    clickCount = 0;
-                }
-            }
-        }
+    // 按时间戳判断，先结算在此边沿之前已经超时的单击
+    checkClickTimeout(edge.timestamp);
+    
+    // 按钮按下
+    if (pressed) {
+        buttonPressTime = edge.timestamp;
+        return;
     }
     
-    // 检查双击超时
-    if (clickCount == 1 && (millis() - lastButtonReleaseTime > DOUBLE_CLICK_TIME)) {
+    // 按钮释放
+    uint32_t pressDuration = edge.timestamp - buttonPressTime;
+    
+    // 检测长按
+    if (pressDuration >= LONG_PRESS_TIME) {
         clickCount = 0;
+        emit(EV_LONG_PRESS, 0, edge.timestamp);
+        return;
     }
     
-    // 读取编码器值变化
-    int16_t newValue = encoder.readEncoder() / ENCODER_STEPS_PER_NOTCH;
-    if (newValue != encoderValue) {
-        encoderValue = newValue;
+    // 检测单击/双击
+    clickCount++;
+    if (clickCount == 1) {
+        lastButtonReleaseTime = edge.timestamp;
+    } else {
+        clickCount = 0;
+        emit(EV_DOUBLE_CLICK, 0, edge.timestamp);
     }
 }
 
-EncoderEvent UserInput::getEvent() {
+void UserInput::processRotation() {
+    int16_t newValue = encoder.readEncoder();
+    int16_t delta = newValue - encoderValue;
+    if (delta == 0) {
+        return;
+    }
+    encoderValue = newValue;
+    
+    if (recorder != nullptr) {
+        recorder->record(TRACE_ROTATION, 0, delta, g_lastRotationTime);
+    }
+    applyRotation(delta, g_lastRotationTime);
+}
+
+void UserInput::applyRotation(int16_t delta, uint32_t timestamp) {
+    // 一次输出全部格数，快速旋转不丢格
+    EncoderEvent type = delta > 0 ? EV_ROTATE_CW : EV_ROTATE_CCW;
+    uint16_t steps = abs(delta);
+    while (steps > 0) {
+        uint8_t chunk = steps > 255 ? 255 : steps;
+        emit(type, chunk, timestamp);
+        steps -= chunk;
+    }
+}
+
+void UserInput::update() {
     if (!initialized) {
-        return EV_NONE;
+        return;
     }
     
-    // 检查长按事件
-    if (processingLongPress) {
-        processingLongPress = false;
-        return EV_LONG_PRESS;
+    // 处理中断记录的按钮边沿
+    ButtonEdge edge;
+    uint32_t now = millis();
+    if (replayMode) {
+        // 回放期间丢弃硬件输入，只检查注入边沿的单击超时
+        while (g_buttonEdges.pop(edge)) {
+        }
+        checkClickTimeout(now);
+        return;
     }
     
-    // 检查双击事件
-    if (processingDoubleClick) {
-        processingDoubleClick = false;
-        return EV_DOUBLE_CLICK;
+    while (g_buttonEdges.pop(edge)) {
+        processEdge(edge);
     }
     
-    // 检查单击事件
-    if (clickCount == 0 && (millis() - lastButtonReleaseTime <= DOUBLE_CLICK_TIME) && 
-        lastButtonReleaseTime > 0) {
-        lastButtonReleaseTime = 0;  // 重置以避免重复检测
-        return EV_SINGLE_CLICK;
+    // 消抖窗口内被丢弃的最后一个边沿可能与实际电平不符，按当前电平补一个边沿
+    uint8_t level = digitalRead(ENCODER_BTN_PIN);
+    if ((level == ENCODER_BTN_ACTIVE_LEVEL) != buttonPressed && now - lastEdgeTime >= INPUT_DEBOUNCE_MS) {
+        edge.timestamp = now;
+        edge.level = level;
+        processEdge(edge);
     }
     
-    // 检查旋转事件
-    static int16_t lastReadValue = encoderValue;
-    if (encoderValue > lastReadValue) {
-        lastReadValue = encoderValue;
-        return EV_ROTATE_CW;
-    } else if (encoderValue < lastReadValue) {
-        lastReadValue = encoderValue;
-        return EV_ROTATE_CCW;
+    // 检查单击超时
+    checkClickTimeout(now);
+    
+    // 读取编码器值变化
+    processRotation();
+}
+
+void UserInput::attachRecorder(TraceRecorder* _recorder) {
+    recorder = _recorder;
+}
+
+void UserInput::setReplayMode(bool enable) {
+    replayMode = enable;
+    clickCount = 0;
+    
+    // 回放期间实际转动的格数不计入，退出时与硬件计数重新对齐
+    if (!enable) {
+        encoderValue = encoder.readEncoder();
+        buttonPressed = digitalRead(ENCODER_BTN_PIN) == ENCODER_BTN_ACTIVE_LEVEL;
+    }
+}
+
+void UserInput::injectEdge(const ButtonEdge& edge) {
+    processEdge(edge);
+}
+
+void UserInput::injectRotation(int16_t delta, uint32_t timestamp) {
+    applyRotation(delta, timestamp);
+}
+
+InputEvent UserInput::getEvent() {
+    InputEvent event;
+    if (!initialized || !events.pop(event)) {
+        event.type = EV_NONE;
+        event.steps = 0;
+        event.timestamp = 0;
     }
     
-    return EV_NONE;
+    return event;
 }
 
 int16_t UserInput::getEncoderValue() {
@@ -128,7 +201,7 @@ int16_t UserInput::getEncoderValue() {
 
 void UserInput::setEncoderValue(int16_t value) {
     encoderValue = value;
-    encoder.setEncoderValue(value * ENCODER_STEPS_PER_NOTCH);
+    encoder.setEncoderValue(value);
 }
 
 void UserInput::setEncoderStep(uint8_t step) {
@@ -140,11 +213,20 @@ uint8_t UserInput::getEncoderStep() {
 }
 
 void IRAM_ATTR UserInput::handleButtonInterrupt() {
-    g_buttonChanged = true;
+    ButtonEdge edge;
+    edge.timestamp = millis();
+    edge.level = digitalRead(ENCODER_BTN_PIN);
+    g_buttonEdges.push(edge);
+    PowerManager::armInputWake(ENCODER_BTN_PIN);
 }
 
 void IRAM_ATTR UserInput::handleEncoderInterrupt() {
     if (g_encoder != nullptr) {
         g_encoder->readEncoder_ISR();
+        g_lastRotationTime = millis();
     }
-} 
\ No newline at end of file
+    
+    // 编码器库同时读取A/B两相，不区分触发的引脚，两相都重新设置触发电平
+    PowerManager::armInputWake(ENCODER_PIN_A);
+    PowerManager::armInputWake(ENCODER_PIN_B);
+}
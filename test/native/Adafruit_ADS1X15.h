@@ -0,0 +1,63 @@
+#ifndef HOST_ADAFRUIT_ADS1X15_H
+#define HOST_ADAFRUIT_ADS1X15_H
+
+// 主机端替身: ADS1115 (换算与Adafruit库相同，转换结果取hostAdsCode)
+// 回放测试直接把记录的原始码送入TempSensor，hostAdsCode只用于begin()时的初始采样。
+
+#include <Arduino.h>
+
+#define ADS1X15_REG_CONFIG_MUX_SINGLE_0 0x4000
+#define ADS1X15_REG_CONFIG_MUX_SINGLE_1 0x5000
+#define ADS1X15_REG_CONFIG_MUX_SINGLE_2 0x6000
+#define ADS1X15_REG_CONFIG_MUX_SINGLE_3 0x7000
+
+typedef enum {
+    GAIN_TWOTHIRDS = 0x0000,
+    GAIN_ONE = 0x0200,
+    GAIN_TWO = 0x0400,
+    GAIN_FOUR = 0x0600,
+    GAIN_EIGHT = 0x0800,
+    GAIN_SIXTEEN = 0x0A00
+} adsGain_t;
+
+inline int16_t hostAdsCode[4] = {0, 0, 0, 0};
+
+class Adafruit_ADS1115 {
+private:
+    adsGain_t gain;
+    uint8_t channel;
+
+public:
+    Adafruit_ADS1115() {
+        gain = GAIN_TWOTHIRDS;
+        channel = 0;
+    }
+    
+    bool begin(uint8_t = 0x48) { return true; }
+    void setGain(adsGain_t _gain) { gain = _gain; }
+    adsGain_t getGain() { return gain; }
+    void setDataRate(uint16_t) {}
+    
+    void startADCReading(uint16_t mux, bool) {
+        channel = ((mux >> 12) & 0x7) - 4;
+    }
+    
+    bool conversionComplete() { return true; }
+    int16_t getLastConversionResults() { return hostAdsCode[channel & 3]; }
+    
+    float computeVolts(int16_t counts) {
+        float fsRange;
+        switch (gain) {
+            case GAIN_TWOTHIRDS: fsRange = 6.144f; break;
+            case GAIN_ONE: fsRange = 4.096f; break;
+            case GAIN_TWO: fsRange = 2.048f; break;
+            case GAIN_FOUR: fsRange = 1.024f; break;
+            case GAIN_EIGHT: fsRange = 0.512f; break;
+            case GAIN_SIXTEEN: fsRange = 0.256f; break;
+            default: fsRange = 0.0f;
+        }
+        return counts * (fsRange / 32768);
+    }
+};
+
+#endif // HOST_ADAFRUIT_ADS1X15_H
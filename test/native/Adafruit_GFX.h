@@ -0,0 +1,223 @@
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+// 主机端替身: Adafruit_GFX中本项目用到的绘图和经典5x7字体文本输出
+// 各函数的像素结果与库的算法一致 (矩形按列画竖线、直线为Bresenham、字符逐列逐行)，
+// 主机端渲染的页面与目标上的帧缓冲逐位相同。
+// 字体只包含可打印ASCII (0x20~0x7E)，其他字符绘制为空白；界面代码不使用非ASCII字符。
+
+#include <Arduino.h>
+
+// 经典字体 (glcdfont) 的可打印ASCII部分，每个字符5列，每列一个字节 (低位在上)
+inline const uint8_t HOST_GLCD_FONT[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x56, 0x20, 0x50}, {0x00, 0x08, 0x07, 0x03, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x80, 0x70, 0x30, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x00, 0x60, 0x60, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x72, 0x49, 0x49, 0x49, 0x46}, {0x21, 0x41, 0x49, 0x4D, 0x33}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x31}, {0x41, 0x21, 0x11, 0x09, 0x07},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x46, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x00, 0x14, 0x00, 0x00},
+    {0x00, 0x40, 0x34, 0x00, 0x00}, {0x00, 0x08, 0x14, 0x22, 0x41}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x59, 0x09, 0x06}, {0x3E, 0x41, 0x5D, 0x59, 0x4E},
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x26, 0x49, 0x49, 0x49, 0x32}, {0x03, 0x01, 0x7F, 0x01, 0x03}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x59, 0x49, 0x4D, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x41},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x41, 0x7F}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x03, 0x07, 0x08, 0x00}, {0x20, 0x54, 0x54, 0x78, 0x40},
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x28}, {0x38, 0x44, 0x44, 0x28, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x00, 0x08, 0x7E, 0x09, 0x02}, {0x18, 0xA4, 0xA4, 0x9C, 0x78},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x40, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x78, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0xFC, 0x18, 0x24, 0x24, 0x18},
+    {0x18, 0x24, 0x24, 0x18, 0xFC}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x24},
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x4C, 0x90, 0x90, 0x90, 0x7C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x77, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02}
+};
+
+class Adafruit_GFX : public Print {
+protected:
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x;
+    int16_t cursor_y;
+    uint16_t textcolor;
+    uint16_t textbgcolor;
+    uint8_t textsize;
+    bool wrap;
+
+public:
+    Adafruit_GFX(int16_t w, int16_t h) {
+        _width = w;
+        _height = h;
+        cursor_x = 0;
+        cursor_y = 0;
+        textcolor = 0xFFFF;
+        textbgcolor = 0xFFFF;
+        textsize = 1;
+        wrap = true;
+    }
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        for (int16_t i = 0; i < h; i++) {
+            drawPixel(x, y + i, color);
+        }
+    }
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        for (int16_t i = 0; i < w; i++) {
+            drawPixel(x + i, y, color);
+        }
+    }
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t i = x; i < x + w; i++) {
+            drawFastVLine(i, y, h, color);
+        }
+    }
+
+    void fillScreen(uint16_t color) {
+        fillRect(0, 0, _width, _height, color);
+    }
+
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        if (x0 == x1) {
+            if (y0 > y1) {
+                std::swap(y0, y1);
+            }
+            drawFastVLine(x0, y0, y1 - y0 + 1, color);
+            return;
+        }
+        if (y0 == y1) {
+            if (x0 > x1) {
+                std::swap(x0, x1);
+            }
+            drawFastHLine(x0, y0, x1 - x0 + 1, color);
+            return;
+        }
+
+        bool steep = abs(y1 - y0) > abs(x1 - x0);
+        if (steep) {
+            std::swap(x0, y0);
+            std::swap(x1, y1);
+        }
+        if (x0 > x1) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+        int16_t dx = x1 - x0;
+        int16_t dy = abs(y1 - y0);
+        int16_t err = dx / 2;
+        int16_t ystep = y0 < y1 ? 1 : -1;
+        for (; x0 <= x1; x0++) {
+            if (steep) {
+                drawPixel(y0, x0, color);
+            } else {
+                drawPixel(x0, y0, color);
+            }
+            err -= dy;
+            if (err < 0) {
+                y0 += ystep;
+                err += dx;
+            }
+        }
+    }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+        if (x >= _width || y >= _height || x + 6 * size - 1 < 0 || y + 8 * size - 1 < 0) {
+            return;
+        }
+        const uint8_t* glyph = c >= 0x20 && c <= 0x7E ? HOST_GLCD_FONT[c - 0x20] : HOST_GLCD_FONT[0];
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = glyph[i];
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1) {
+                    if (size == 1) {
+                        drawPixel(x + i, y + j, color);
+                    } else {
+                        fillRect(x + i * size, y + j * size, size, size, color);
+                    }
+                } else if (bg != color) {
+                    if (size == 1) {
+                        drawPixel(x + i, y + j, bg);
+                    } else {
+                        fillRect(x + i * size, y + j * size, size, size, bg);
+                    }
+                }
+            }
+        }
+        if (bg != color) {
+            if (size == 1) {
+                drawFastVLine(x + 5, y, 8, bg);
+            } else {
+                fillRect(x + 5 * size, y, size, 8 * size, bg);
+            }
+        }
+    }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        } else if (c != '\r') {
+            if (wrap && cursor_x + textsize * 6 > _width) {
+                cursor_x = 0;
+                cursor_y += textsize * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+            cursor_x += textsize * 6;
+        }
+        return 1;
+    }
+
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) {
+        cursor_x = x;
+        cursor_y = y;
+    }
+
+    void setTextSize(uint8_t size) {
+        textsize = size > 0 ? size : 1;
+    }
+
+    // 只设前景色时背景色与之相同，即透明背景
+    void setTextColor(uint16_t color) {
+        textcolor = color;
+        textbgcolor = color;
+    }
+
+    void setTextColor(uint16_t color, uint16_t background) {
+        textcolor = color;
+        textbgcolor = background;
+    }
+
+    void setTextWrap(bool enable) {
+        wrap = enable;
+    }
+
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+};
+
+#endif // HOST_ADAFRUIT_GFX_H
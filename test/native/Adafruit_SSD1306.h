@@ -0,0 +1,252 @@
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+// 主机端替身: SSD1306帧缓冲 (与库相同的按页存放格式) 和内存中的SSD1306屏幕
+// Adafruit_SSD1306的display()与库一样经Wire按水平寻址模式发送整屏；
+// HostSsd1306Panel挂接在Wire上解码命令流和数据流，ram[]就是屏幕上显示的内容。
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_MEMORYMODE 0x20
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define SSD1306_SETCONTRAST 0x81
+#define SSD1306_DISPLAYOFF 0xAE
+#define SSD1306_DISPLAYON 0xAF
+#define SSD1306_NORMALDISPLAY 0xA6
+#define SSD1306_INVERTDISPLAY 0xA7
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+private:
+    TwoWire* wire;
+    uint8_t* buffer;
+    uint8_t i2caddr;
+
+    void sendCommands(const uint8_t* commands, size_t size) {
+        wire->beginTransmission(i2caddr);
+        wire->write((uint8_t)0x00);
+        wire->write(commands, size);
+        wire->endTransmission();
+    }
+
+public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t rst_pin = -1)
+        : Adafruit_GFX(w, h), wire(twi), buffer(nullptr), i2caddr(0x3C) {}
+
+    ~Adafruit_SSD1306() {
+        delete[] buffer;
+    }
+
+    bool begin(uint8_t vcs = SSD1306_SWITCHCAPVCC, uint8_t addr = 0, bool reset = true, bool periphBegin = true) {
+        if (buffer == nullptr) {
+            buffer = new uint8_t[_width * ((_height + 7) / 8)];
+        }
+        clearDisplay();
+        i2caddr = addr != 0 ? addr : 0x3C;
+
+        // 水平寻址模式并打开显示
+        const uint8_t init[] = {SSD1306_DISPLAYOFF, SSD1306_MEMORYMODE, 0x00, SSD1306_DISPLAYON};
+        sendCommands(init, sizeof(init));
+        return true;
+    }
+
+    void display() {
+        const uint8_t window[] = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0, (uint8_t)(_width - 1)};
+        sendCommands(window, sizeof(window));
+
+        size_t size = _width * ((_height + 7) / 8);
+        for (size_t offset = 0; offset < size; offset += 31) {
+            wire->beginTransmission(i2caddr);
+            wire->write((uint8_t)0x40);
+            wire->write(buffer + offset, size - offset < 31 ? size - offset : 31);
+            wire->endTransmission();
+        }
+    }
+
+    void clearDisplay() {
+        memset(buffer, 0, _width * ((_height + 7) / 8));
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || x >= _width || y < 0 || y >= _height) {
+            return;
+        }
+        uint8_t& byte = buffer[x + (y / 8) * _width];
+        switch (color) {
+            case SSD1306_WHITE:
+                byte |= 1 << (y & 7);
+                break;
+            case SSD1306_BLACK:
+                byte &= ~(1 << (y & 7));
+                break;
+            case SSD1306_INVERSE:
+                byte ^= 1 << (y & 7);
+                break;
+        }
+    }
+
+    // 与库的优化版本一样先裁剪，长度不大于0时不绘制
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+        if (y < 0 || y >= _height) {
+            return;
+        }
+        if (x < 0) {
+            w += x;
+            x = 0;
+        }
+        if (x + w > _width) {
+            w = _width - x;
+        }
+        for (int16_t i = 0; i < w; i++) {
+            drawPixel(x + i, y, color);
+        }
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+        if (x < 0 || x >= _width) {
+            return;
+        }
+        if (y < 0) {
+            h += y;
+            y = 0;
+        }
+        if (y + h > _height) {
+            h = _height - y;
+        }
+        for (int16_t i = 0; i < h; i++) {
+            drawPixel(x, y + i, color);
+        }
+    }
+
+    uint8_t* getBuffer() {
+        return buffer;
+    }
+
+    void ssd1306_command(uint8_t command) {
+        sendCommands(&command, 1);
+    }
+
+    void invertDisplay(bool invert) {
+        ssd1306_command(invert ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+    }
+
+    void dim(bool dim) {
+        const uint8_t contrast[] = {SSD1306_SETCONTRAST, (uint8_t)(dim ? 0 : 0xCF)};
+        sendCommands(contrast, sizeof(contrast));
+    }
+};
+
+// 内存中的128x64 SSD1306 (水平寻址模式)
+// 控制字节0x00后为命令流，0x40后为写入GDDRAM的数据，地址在窗口内自动递增并回绕。
+class HostSsd1306Panel : public HostI2CDevice {
+private:
+    uint8_t pageStart;
+    uint8_t pageEnd;
+    uint8_t columnStart;
+    uint8_t columnEnd;
+    uint8_t page;
+    uint8_t column;
+
+    // 跨事务的命令参数
+    uint8_t command;
+    uint8_t args[2];
+    uint8_t argCount;
+    uint8_t argsNeeded;
+
+    static uint8_t argumentCount(uint8_t command) {
+        switch (command) {
+            case SSD1306_COLUMNADDR:
+            case SSD1306_PAGEADDR:
+                return 2;
+            case SSD1306_MEMORYMODE:
+            case SSD1306_SETCONTRAST:
+            case 0x8D:  // 电荷泵
+            case 0xA8:  // 复用率
+            case 0xD3:  // 显示偏移
+            case 0xD5:  // 时钟分频
+            case 0xD9:  // 预充电周期
+            case 0xDA:  // COM引脚配置
+            case 0xDB:  // VCOMH电平
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    void executeCommand() {
+        if (command == SSD1306_COLUMNADDR) {
+            columnStart = args[0] & 0x7F;
+            columnEnd = args[1] & 0x7F;
+            column = columnStart;
+        } else if (command == SSD1306_PAGEADDR) {
+            pageStart = args[0] & 0x07;
+            pageEnd = args[1] & 0x07;
+            page = pageStart;
+        }
+        commandCount++;
+    }
+
+    void writeData(uint8_t data) {
+        ram[page * 128 + column] = data;
+        dataBytes++;
+        if (column < columnEnd) {
+            column++;
+            return;
+        }
+        column = columnStart;
+        page = page < pageEnd ? page + 1 : pageStart;
+    }
+
+public:
+    uint8_t ram[128 * 8];       // GDDRAM，与帧缓冲格式相同
+    uint32_t commandCount;      // 执行的命令数
+    uint32_t dataBytes;         // 写入的显示数据字节数
+
+    HostSsd1306Panel() {
+        memset(ram, 0, sizeof(ram));
+        pageStart = 0;
+        pageEnd = 7;
+        columnStart = 0;
+        columnEnd = 127;
+        page = 0;
+        column = 0;
+        command = 0;
+        argCount = 0;
+        argsNeeded = 0;
+        commandCount = 0;
+        dataBytes = 0;
+    }
+
+    void receive(const uint8_t* data, size_t size) override {
+        if (size == 0) {
+            return;
+        }
+        bool isData = data[0] == 0x40;
+        for (size_t i = 1; i < size; i++) {
+            if (isData) {
+                writeData(data[i]);
+            } else if (argsNeeded > 0) {
+                args[argCount++] = data[i];
+                if (--argsNeeded == 0) {
+                    executeCommand();
+                }
+            } else {
+                command = data[i];
+                argCount = 0;
+                argsNeeded = argumentCount(command);
+                if (argsNeeded == 0) {
+                    executeCommand();
+                }
+            }
+        }
+    }
+};
+
+#endif // HOST_ADAFRUIT_SSD1306_H
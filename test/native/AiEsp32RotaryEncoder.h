@@ -0,0 +1,26 @@
+#ifndef HOST_AI_ESP32_ROTARY_ENCODER_H
+#define HOST_AI_ESP32_ROTARY_ENCODER_H
+
+// 主机端替身: 旋转编码器，计数由测试直接设置
+
+#include <Arduino.h>
+
+class AiEsp32RotaryEncoder {
+private:
+    long value;
+
+public:
+    AiEsp32RotaryEncoder(uint8_t pinA, uint8_t pinB, int pinButton, int pinVcc, uint8_t steps) : value(0) {}
+
+    void begin() {}
+    void setup(void (*encoderISR)(void), void (*buttonISR)(void)) {}
+    void readEncoder_ISR() {}
+    void readButton_ISR() {}
+    void setAcceleration(unsigned long acceleration) {}
+    void disableAcceleration() {}
+
+    long readEncoder() { return value; }
+    void setEncoderValue(long newValue) { value = newValue; }
+};
+
+#endif // HOST_AI_ESP32_ROTARY_ENCODER_H
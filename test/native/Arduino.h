@@ -0,0 +1,268 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// 主机端替身: 本项目用到的Arduino核心子集
+// millis()/micros()/delay()走虚拟时钟，由测试显式推进，同一输入每次运行结果相同；
+// 需要测量实际耗时的测试直接使用std::chrono。
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include "host_clock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+template<class T, class L, class H>
+inline T constrain(T value, L low, H high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+inline void delay(uint32_t ms) {
+    hostAdvanceMillis(ms);
+}
+
+inline void delayMicroseconds(uint32_t us) {
+    hostAdvanceMicros(us);
+}
+
+// ---- GPIO (引脚电平由测试设置，默认上拉为高) ----
+
+inline uint8_t hostPinLevel[64] = {
+    HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH,
+    HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH,
+    HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH,
+    HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH, HIGH
+};
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline int digitalRead(uint8_t pin) {
+    return hostPinLevel[pin % 64];
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+    hostPinLevel[pin % 64] = level;
+}
+
+#define digitalPinToInterrupt(pin) (pin)
+
+inline void attachInterrupt(uint8_t, void (*)(void), int) {}
+inline void detachInterrupt(uint8_t) {}
+
+// ---- LEDC和硬件定时器 (PWMController) ----
+
+inline uint32_t ledcSetup(uint8_t, uint32_t frequency, uint8_t) {
+    return frequency;
+}
+
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+
+// 定时器不产生中断: 整周期模式的窗口由测试直接调用中断处理函数推进
+struct hw_timer_t {
+    uint64_t alarm;
+    bool enabled;
+};
+
+inline hw_timer_t* timerBegin(uint8_t, uint16_t, bool) {
+    return new hw_timer_t{0, false};
+}
+
+inline void timerAttachInterrupt(hw_timer_t*, void (*)(void), bool) {}
+
+inline void timerAlarmWrite(hw_timer_t* timer, uint64_t alarm, bool) {
+    timer->alarm = alarm;
+}
+
+inline void timerWrite(hw_timer_t*, uint64_t) {}
+
+inline void timerAlarmEnable(hw_timer_t* timer) {
+    timer->enabled = true;
+}
+
+inline void timerAlarmDisable(hw_timer_t* timer) {
+    timer->enabled = false;
+}
+
+// ---- 串口输出 ----
+
+// 数值格式与Arduino核心的Print一致 (浮点为加0.5个末位后逐位截断)
+class Print {
+private:
+    size_t printNumber(unsigned long long n, uint8_t base) {
+        char buf[8 * sizeof(n) + 1];
+        char* str = &buf[sizeof(buf) - 1];
+        *str = '\0';
+        if (base < 2) {
+            base = 10;
+        }
+        do {
+            char c = n % base;
+            n /= base;
+            *--str = c < 10 ? c + '0' : c + 'A' - 10;
+        } while (n);
+        return write(str);
+    }
+    
+    size_t printSigned(long long n, int base) {
+        if (base == 10 && n < 0) {
+            return print('-') + printNumber(0ULL - (unsigned long long)n, 10);
+        }
+        return printNumber((unsigned long long)n, base);
+    }
+    
+    size_t printFloat(double number, uint8_t digits) {
+        if (isnan(number)) {
+            return print("nan");
+        }
+        if (isinf(number)) {
+            return print("inf");
+        }
+        if (number > 4294967040.0 || number < -4294967040.0) {
+            return print("ovf");
+        }
+        
+        size_t n = 0;
+        if (number < 0.0) {
+            n += print('-');
+            number = -number;
+        }
+        
+        double rounding = 0.5;
+        for (uint8_t i = 0; i < digits; ++i) {
+            rounding /= 10.0;
+        }
+        number += rounding;
+        
+        unsigned long intPart = (unsigned long)number;
+        double remainder = number - (double)intPart;
+        n += print(intPart);
+        if (digits > 0) {
+            n += print('.');
+        }
+        while (digits-- > 0) {
+            remainder *= 10.0;
+            unsigned int toPrint = (unsigned int)remainder;
+            n += print(toPrint);
+            remainder -= toPrint;
+        }
+        return n;
+    }
+
+public:
+    virtual ~Print() {}
+    
+    virtual size_t write(uint8_t c) = 0;
+    
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+    
+    size_t write(const char* str) {
+        return str == nullptr ? 0 : write((const uint8_t*)str, strlen(str));
+    }
+    
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC) { return printNumber(n, base); }
+    size_t print(int n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned int n, int base = DEC) { return printNumber(n, base); }
+    size_t print(long n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(long long n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(double n, int digits = 2) { return printFloat(n, digits); }
+    
+    size_t println() { return write("\r\n"); }
+    
+    template<class T>
+    size_t println(T value) { return print(value) + println(); }
+    
+    template<class T>
+    size_t println(T value, int format) { return print(value, format) + println(); }
+    
+    size_t printf(const char* format, ...) {
+        char buf[256];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        return len > 0 ? write(buf) : 0;
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+};
+
+// 输出到标准输出
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long) {}
+    
+    size_t write(uint8_t c) override {
+        return fputc(c, stdout) == EOF ? 0 : 1;
+    }
+    
+    using Print::write;
+    
+    operator bool() { return true; }
+};
+
+inline HardwareSerial Serial;
+
+// ---- 芯片信息 ----
+
+// 周期计数器按1GHz换算实际纳秒，Profiler的周期数即为纳秒
+class EspClass {
+public:
+    uint32_t getCycleCount() {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+    
+    uint32_t getCpuFreqMHz() { return 1000; }
+    uint32_t getFreeHeap() { return 0; }
+};
+
+inline EspClass ESP;
+
+#endif // HOST_ARDUINO_H
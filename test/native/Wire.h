@@ -0,0 +1,83 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+// 主机端替身: I2C总线
+// 每次endTransmission()把整个事务交给按地址挂接的内存设备；没有设备的地址返回2 (地址无应答)，
+// 设置failResult可以模拟总线错误 (此时数据不送达设备)。
+
+#include <Arduino.h>
+
+#define I2C_BUFFER_LENGTH 128
+
+// 挂接在主机端总线上的设备
+class HostI2CDevice {
+public:
+    virtual ~HostI2CDevice() {}
+
+    // 收到一个完整的写事务
+    virtual void receive(const uint8_t* data, size_t size) = 0;
+};
+
+class TwoWire : public Stream {
+private:
+    HostI2CDevice* devices[128];
+    uint8_t txAddress;
+    uint8_t txBuffer[I2C_BUFFER_LENGTH];
+    size_t txLength;
+
+public:
+    uint8_t failResult;         // 非0时每次endTransmission()返回该值
+    uint32_t transactions;      // 成功送达的事务数
+
+    TwoWire() : txAddress(0), txLength(0), failResult(0), transactions(0) {
+        memset(devices, 0, sizeof(devices));
+    }
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    bool setClock(uint32_t frequency) { return true; }
+
+    void attach(uint8_t address, HostI2CDevice* device) {
+        devices[address & 0x7F] = device;
+    }
+
+    void beginTransmission(uint8_t address) {
+        txAddress = address & 0x7F;
+        txLength = 0;
+    }
+
+    size_t write(uint8_t c) override {
+        if (txLength >= sizeof(txBuffer)) {
+            return 0;
+        }
+        txBuffer[txLength++] = c;
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        size_t n = 0;
+        while (n < size && write(data[n])) {
+            n++;
+        }
+        return n;
+    }
+
+    using Print::write;
+
+    uint8_t endTransmission(bool sendStop = true) {
+        if (failResult != 0) {
+            return failResult;
+        }
+        if (devices[txAddress] == nullptr) {
+            return 2;
+        }
+        devices[txAddress]->receive(txBuffer, txLength);
+        transactions++;
+        return 0;
+    }
+
+    uint8_t requestFrom(uint8_t address, uint8_t size) { return 0; }
+};
+
+inline TwoWire Wire;
+
+#endif // HOST_WIRE_H
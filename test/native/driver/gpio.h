@@ -0,0 +1,34 @@
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+// 主机端替身: GPIO中断类型和唤醒设置 (无硬件，全部为空操作)
+
+#include "esp_err.h"
+
+typedef enum {
+    GPIO_NUM_NC = -1
+} gpio_num_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL,
+    GPIO_INTR_MAX
+} gpio_int_type_t;
+
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_wakeup_disable(gpio_num_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_set_intr_type(gpio_num_t, gpio_int_type_t) {
+    return ESP_OK;
+}
+
+#endif // HOST_DRIVER_GPIO_H
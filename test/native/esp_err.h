@@ -0,0 +1,16 @@
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+
+// 主机端替身: ESP-IDF错误码
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NOT_SUPPORTED 0x106
+
+inline const char* esp_err_to_name(esp_err_t code) {
+    return code == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
+
+#endif // HOST_ESP_ERR_H
@@ -0,0 +1,41 @@
+#ifndef HOST_ESP_PM_H
+#define HOST_ESP_PM_H
+
+// 主机端替身: 动态调频和电源锁 (主机上不调频，配置一律失败，PowerManager保持未初始化)
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+    ESP_PM_CPU_FREQ_MAX = 0,
+    ESP_PM_APB_FREQ_MAX,
+    ESP_PM_NO_LIGHT_SLEEP
+} esp_pm_lock_type_t;
+
+struct esp_pm_lock;
+typedef esp_pm_lock* esp_pm_lock_handle_t;
+
+typedef struct {
+    int max_freq_mhz;
+    int min_freq_mhz;
+    bool light_sleep_enable;
+} esp_pm_config_esp32s3_t;
+
+inline esp_err_t esp_pm_lock_create(esp_pm_lock_type_t, int, const char*, esp_pm_lock_handle_t* handle) {
+    *handle = nullptr;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t) {
+    return ESP_OK;
+}
+
+inline esp_err_t esp_pm_configure(const void*) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // HOST_ESP_PM_H
@@ -0,0 +1,12 @@
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+// 主机端替身: 睡眠唤醒源 (空操作)
+
+#include "esp_err.h"
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup() {
+    return ESP_OK;
+}
+
+#endif // HOST_ESP_SLEEP_H
@@ -0,0 +1,41 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// 主机端替身: FreeRTOS基本类型和临界区 (1 tick = 1毫秒，与目标配置一致)
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define portMAX_DELAY 0xFFFFFFFFu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// 临界区用自旋锁实现，跨线程测试时同样互斥
+typedef struct {
+    int locked;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+static inline void vPortEnterCritical(portMUX_TYPE* mux) {
+    while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static inline void vPortExitCritical(portMUX_TYPE* mux) {
+    __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define portYIELD_FROM_ISR()
+
+#endif // HOST_FREERTOS_H
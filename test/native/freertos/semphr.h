@@ -0,0 +1,60 @@
+#ifndef HOST_SEMPHR_H
+#define HOST_SEMPHR_H
+
+// 主机端替身: 信号量 (二值信号量和互斥锁)，等待超时按实际时间计
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include "freertos/FreeRTOS.h"
+
+struct HostSemaphore {
+    std::mutex lock;
+    std::condition_variable ready;
+    UBaseType_t count;
+};
+
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+    SemaphoreHandle_t semaphore = new HostSemaphore();
+    semaphore->count = 0;
+    return semaphore;
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t semaphore = new HostSemaphore();
+    semaphore->count = 1;
+    return semaphore;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> guard(semaphore->lock);
+    auto available = [semaphore] { return semaphore->count > 0; };
+    if (ticks == portMAX_DELAY) {
+        semaphore->ready.wait(guard, available);
+    } else if (!semaphore->ready.wait_for(guard, std::chrono::milliseconds(ticks), available)) {
+        return pdFALSE;
+    }
+    semaphore->count--;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> guard(semaphore->lock);
+    if (semaphore->count > 0) {
+        return pdFALSE;
+    }
+    semaphore->count = 1;
+    semaphore->ready.notify_one();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+    if (woken != nullptr) {
+        *woken = pdFALSE;
+    }
+    return xSemaphoreGive(semaphore);
+}
+
+#endif // HOST_SEMPHR_H
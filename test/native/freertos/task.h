@@ -0,0 +1,63 @@
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+// 主机端替身: 任务、任务通知、延时和让出 (延时推进虚拟时钟)
+// 任务为分离的std::thread，核心号和优先级被忽略。
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "freertos/FreeRTOS.h"
+#include "host_clock.h"
+
+struct HostTask {
+    std::mutex lock;
+    std::condition_variable notified;
+    uint32_t notifyCount;
+};
+
+typedef HostTask* TaskHandle_t;
+
+// 当前线程对应的任务 (ulTaskNotifyTake等待的对象)
+inline thread_local HostTask* hostCurrentTask = nullptr;
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*function)(void*), const char* name, uint32_t stackDepth,
+                                          void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                          BaseType_t core) {
+    HostTask* task = new HostTask();
+    task->notifyCount = 0;
+    if (handle != nullptr) {
+        *handle = task;
+    }
+    std::thread([=]() {
+        hostCurrentTask = task;
+        function(parameter);
+    }).detach();
+    return pdPASS;
+}
+
+inline void xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notifyCount++;
+    task->notified.notify_one();
+}
+
+// 只支持无限等待 (本项目的用法)
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    HostTask* task = hostCurrentTask;
+    std::unique_lock<std::mutex> guard(task->lock);
+    task->notified.wait(guard, [task]() { return task->notifyCount > 0; });
+    uint32_t count = task->notifyCount;
+    task->notifyCount = clearOnExit ? 0 : count - 1;
+    return count;
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+    hostAdvanceMillis(ticks);
+}
+
+inline void taskYIELD() {
+    std::this_thread::yield();
+}
+
+#endif // HOST_TASK_H
@@ -0,0 +1,27 @@
+#ifndef HOST_HAL_GPIO_LL_H
+#define HOST_HAL_GPIO_LL_H
+
+// 主机端替身: GPIO寄存器访问 (无硬件，全部为空操作)
+
+#include "driver/gpio.h"
+
+typedef struct {
+    int unused;
+} gpio_dev_t;
+
+#define GPIO_PORT_0 0
+
+inline gpio_dev_t* GPIO_LL_GET_HW(int) {
+    static gpio_dev_t device;
+    return &device;
+}
+
+inline int gpio_ll_get_level(gpio_dev_t*, gpio_num_t) {
+    return 1;
+}
+
+inline void gpio_ll_set_intr_type(gpio_dev_t*, gpio_num_t, gpio_int_type_t) {}
+inline void gpio_ll_wakeup_enable(gpio_dev_t*, gpio_num_t, gpio_int_type_t) {}
+inline void gpio_ll_wakeup_disable(gpio_dev_t*, gpio_num_t) {}
+
+#endif // HOST_HAL_GPIO_LL_H
@@ -0,0 +1,48 @@
+#ifndef HOST_HAL_LEDC_LL_H
+#define HOST_HAL_LEDC_LL_H
+
+// 主机端替身: LEDC寄存器访问
+// 占空比写入hostLedcDuty[通道]，在ledc_ll_ls_channel_update时生效 (与硬件一样需要更新后才输出)。
+
+#include <stdint.h>
+
+typedef enum {
+    LEDC_LOW_SPEED_MODE = 0
+} ledc_mode_t;
+
+typedef enum {
+    LEDC_CHANNEL_0 = 0
+} ledc_channel_t;
+
+typedef enum {
+    LEDC_DUTY_DIR_DECREASE = 0,
+    LEDC_DUTY_DIR_INCREASE
+} ledc_duty_direction_t;
+
+typedef struct {
+    uint32_t pendingDuty[8];
+} ledc_dev_t;
+
+// 各通道当前输出的占空比
+inline uint32_t hostLedcDuty[8] = {0};
+
+inline ledc_dev_t* LEDC_LL_GET_HW() {
+    static ledc_dev_t device;
+    return &device;
+}
+
+inline void ledc_ll_set_duty_int_part(ledc_dev_t* hw, ledc_mode_t, ledc_channel_t channel, uint32_t duty) {
+    hw->pendingDuty[channel & 7] = duty;
+}
+
+inline void ledc_ll_set_duty_direction(ledc_dev_t*, ledc_mode_t, ledc_channel_t, ledc_duty_direction_t) {}
+inline void ledc_ll_set_duty_num(ledc_dev_t*, ledc_mode_t, ledc_channel_t, uint32_t) {}
+inline void ledc_ll_set_duty_cycle(ledc_dev_t*, ledc_mode_t, ledc_channel_t, uint32_t) {}
+inline void ledc_ll_set_duty_scale(ledc_dev_t*, ledc_mode_t, ledc_channel_t, uint32_t) {}
+inline void ledc_ll_set_duty_start(ledc_dev_t*, ledc_mode_t, ledc_channel_t, bool) {}
+
+inline void ledc_ll_ls_channel_update(ledc_dev_t* hw, ledc_mode_t, ledc_channel_t channel) {
+    hostLedcDuty[channel & 7] = hw->pendingDuty[channel & 7];
+}
+
+#endif // HOST_HAL_LEDC_LL_H
@@ -0,0 +1,27 @@
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+// 主机端虚拟时钟 (微秒)
+// millis()/micros()/delay()/vTaskDelay()都走这个时钟，只由测试和延时推进。
+
+#include <stdint.h>
+
+inline uint64_t hostClockMicros = 0;
+
+inline void hostAdvanceMicros(uint64_t us) {
+    hostClockMicros += us;
+}
+
+inline void hostAdvanceMillis(uint32_t ms) {
+    hostClockMicros += (uint64_t)ms * 1000;
+}
+
+inline unsigned long millis() {
+    return (unsigned long)(uint32_t)(hostClockMicros / 1000);
+}
+
+inline unsigned long micros() {
+    return (unsigned long)(uint32_t)hostClockMicros;
+}
+
+#endif // HOST_CLOCK_H
@@ -0,0 +1,130 @@
+#include <unity.h>
+#include "heater_monitor.h"
+
+// 加热器故障分类: 在检测周期上模拟温度曲线、输出占空比和电源电压。
+// 先关断输出一段时间 (测量空载电源电压)，再按场景输出并让温度按固定速率变化，
+// 检查确认的故障类型。每种温度响应分别在有压降、无压降和没有有效电源电压时运行:
+// 温升不足时有压降 (有电流) 为传感器脱落，无压降为加热器开路，没有电压时按温升比例判断。
+
+#define AMBIENT_TEMP 25.0f
+#define IDLE_TIME 10000UL           // 开始时关断输出的时间 (毫秒)
+#define RUN_TIME 30000UL            // 按场景输出的时间 (毫秒)
+#define NO_SUPPLY 0.0f              // 未接分压 (低于SUPPLY_VOLTAGE_MIN)
+
+// 一个场景
+struct MonitorCase {
+    const char* name;
+    float duty;                     // 场景输出占空比
+    float tempRate;                 // 场景温度变化速率 (℃/s)
+    float idleSupply;               // 关断时电源电压
+    float loadSupply;               // 场景输出时电源电压
+    HeaterFault expected;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// 运行一个场景，返回确认的故障 (没有故障时为HEATER_FAULT_NONE)
+static HeaterFault runCase(HeaterMonitor& monitor, const MonitorCase& c, unsigned long start) {
+    unsigned long now = start;
+    for (; now < start + IDLE_TIME; now += HEATER_MONITOR_INTERVAL) {
+        TEST_ASSERT_FALSE_MESSAGE(monitor.update(AMBIENT_TEMP, 0.0f, c.idleSupply, now), c.name);
+    }
+
+    // 输出变化后有热滞后宽限期，零输出不重新开始宽限期，只需持续确认时间
+    unsigned long changed = now;
+    unsigned long minTime = c.duty > 0.0f ? HEATER_FAULT_SETTLE_TIME + HEATER_FAULT_CONFIRM_TIME : HEATER_FAULT_CONFIRM_TIME;
+    for (; now < changed + RUN_TIME; now += HEATER_MONITOR_INTERVAL) {
+        float temp = AMBIENT_TEMP + c.tempRate * (now - changed) / 1000.0f;
+        if (monitor.update(temp, c.duty, c.loadSupply, now)) {
+            TEST_ASSERT_TRUE_MESSAGE(now - changed >= minTime, c.name);
+            break;
+        }
+    }
+    return monitor.getFault();
+}
+
+static void checkCases(const MonitorCase* cases, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        HeaterMonitor monitor;
+        TEST_ASSERT_EQUAL_INT_MESSAGE(cases[i].expected, runCase(monitor, cases[i], 0), cases[i].name);
+    }
+}
+
+// 满占空比无温升: 没有电流为开路，有电流为传感器脱落
+void test_no_response() {
+    static const MonitorCase cases[] = {
+        {"no rise, no droop", 1.0f, 0.0f, 12.0f, 12.0f, HEATER_FAULT_OPEN},
+        {"no rise, droop", 1.0f, 0.0f, 12.0f, 11.5f, HEATER_FAULT_SENSOR_DETACHED},
+        {"no rise, no supply", 1.0f, 0.0f, NO_SUPPLY, NO_SUPPLY, HEATER_FAULT_OPEN},
+        {"no rise, load supply invalid", 1.0f, 0.0f, 12.0f, NO_SUPPLY, HEATER_FAULT_OPEN}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 满占空比温升微弱 (约为预期的20%): 有电压时仍按压降判断，没有电压时为传感器脱落
+void test_weak_response() {
+    static const MonitorCase cases[] = {
+        {"weak rise, no droop", 1.0f, 0.4f, 12.0f, 12.0f, HEATER_FAULT_OPEN},
+        {"weak rise, droop", 1.0f, 0.4f, 12.0f, 11.5f, HEATER_FAULT_SENSOR_DETACHED},
+        {"weak rise, no supply", 1.0f, 0.4f, NO_SUPPLY, NO_SUPPLY, HEATER_FAULT_SENSOR_DETACHED}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 零输出持续升温: 与电源电压无关，均为MOS管常通
+void test_stuck_on() {
+    static const MonitorCase cases[] = {
+        {"stuck, no droop", 0.0f, 0.5f, 12.0f, 12.0f, HEATER_FAULT_STUCK_ON},
+        {"stuck, droop", 0.0f, 0.5f, 11.5f, 11.5f, HEATER_FAULT_STUCK_ON},
+        {"stuck, no supply", 0.0f, 0.5f, NO_SUPPLY, NO_SUPPLY, HEATER_FAULT_STUCK_ON}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 正常响应和低占空比不判定故障
+void test_no_fault() {
+    static const MonitorCase cases[] = {
+        {"heating, droop", 1.0f, 1.8f, 12.0f, 11.5f, HEATER_FAULT_NONE},
+        {"heating, no supply", 1.0f, 1.8f, NO_SUPPLY, NO_SUPPLY, HEATER_FAULT_NONE},
+        {"idle", 0.0f, 0.0f, 12.0f, 12.0f, HEATER_FAULT_NONE},
+        {"low duty, no rise", 0.5f, 0.0f, 12.0f, 12.0f, HEATER_FAULT_NONE}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 上一次高占空比的压降不用于下一次: 重新进入高占空比后没有有效电压时按温升比例判断
+void test_stale_load_supply() {
+    static const MonitorCase heating = {"heating", 1.0f, 1.8f, 12.0f, 11.5f, HEATER_FAULT_NONE};
+    static const MonitorCase open = {"open, load supply invalid", 1.0f, 0.0f, 12.0f, NO_SUPPLY, HEATER_FAULT_OPEN};
+    HeaterMonitor monitor;
+
+    // 第一次加热时有压降，第二次无温升且加热时电压无效: 不使用第一次的压降，按温升比例判定为开路
+    TEST_ASSERT_EQUAL_INT(HEATER_FAULT_NONE, runCase(monitor, heating, 0));
+    TEST_ASSERT_EQUAL_INT(open.expected, runCase(monitor, open, IDLE_TIME + RUN_TIME));
+}
+
+// 故障保持到重置
+void test_fault_latched_until_reset() {
+    static const MonitorCase stuck = {"stuck", 0.0f, 0.5f, 12.0f, 12.0f, HEATER_FAULT_STUCK_ON};
+    HeaterMonitor monitor;
+
+    TEST_ASSERT_EQUAL_INT(HEATER_FAULT_STUCK_ON, runCase(monitor, stuck, 0));
+    TEST_ASSERT_TRUE(monitor.update(AMBIENT_TEMP, 0.0f, 12.0f, 100000));
+    TEST_ASSERT_EQUAL_STRING("Heater stuck on", monitor.getFaultMessage());
+
+    monitor.reset();
+    TEST_ASSERT_EQUAL_INT(HEATER_FAULT_NONE, monitor.getFault());
+    TEST_ASSERT_FALSE(monitor.update(AMBIENT_TEMP, 0.0f, 12.0f, 100000));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_response);
+    RUN_TEST(test_weak_response);
+    RUN_TEST(test_stuck_on);
+    RUN_TEST(test_no_fault);
+    RUN_TEST(test_stale_load_supply);
+    RUN_TEST(test_fault_latched_until_reset);
+    return UNITY_END();
+}
@@ -0,0 +1,231 @@
+#include <unity.h>
+#include <chrono>
+#include "num_format.h"
+
+// 数值格式化: formatFloat按float的实际值四舍五入 (恰好为.5时远离0)，结果为0时不输出负号。
+// 与Print::print(float)有意不同的两类输入单独列出: 名义上为x.x5的值 (Print加0.5个末位后截断，
+// 结果取决于double加法的舍入) 和四舍五入为0的负数 (Print输出"-0.0")。
+// 最后一个测试在主机上比较Print与formatFloat/formatInt的耗时，输出 FMT,方法,次数,平均ns。
+
+#define BENCH_ITERATIONS 100000
+
+// 一条期望结果
+struct FormatCase {
+    float value;
+    uint8_t decimals;
+    const char* expected;
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void checkCases(const FormatCase* cases, size_t count) {
+    char text[NUM_FORMAT_LENGTH];
+    for (size_t i = 0; i < count; i++) {
+        char message[64];
+        snprintf(message, sizeof(message), "%.9g, %u decimals", cases[i].value, cases[i].decimals);
+        formatFloat(text, cases[i].value, cases[i].decimals);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(cases[i].expected, text, message);
+    }
+}
+
+static const float POW10_CASES[NUM_FORMAT_MAX_DECIMALS + 1] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f};
+
+// 正确结果: float转double和乘以10^decimals (不超过4位) 都是精确的，round()恰好为.5时远离0
+static int32_t referenceFixed(float value, uint8_t decimals) {
+    return (int32_t)round((double)value * POW10_CASES[decimals]);
+}
+
+// 恰好为.5和名义上为.5的值
+void test_format_float_ties() {
+    static const FormatCase cases[] = {
+        // 二进制可精确表示的.5: 远离0
+        {0.25f, 1, "0.3"},
+        {-0.25f, 1, "-0.3"},
+        {2.5f, 0, "3"},
+        {-2.5f, 0, "-3"},
+        {0.125f, 2, "0.13"},
+        {-0.375f, 2, "-0.38"},
+        {1.0625f, 3, "1.063"},
+        // 名义上为x.x5，按float的实际值取整:
+        // k*0.1731f中1731k≡500 (mod 1000) 的k=±500，乘积为±86.549995
+        {500 * 0.1731f, 1, "86.5"},
+        {-500 * 0.1731f, 1, "-86.5"},
+        // 86.55f = 86.550003
+        {86.55f, 1, "86.6"},
+        {-86.55f, 1, "-86.6"},
+        // 77.85f = 77.849998，乘以10的舍入恰好得到778.5
+        {77.85f, 1, "77.8"},
+        {-77.85f, 1, "-77.8"},
+        // 0.35f = 0.34999999，0.15f = 0.15000001
+        {0.35f, 1, "0.3"},
+        {0.15f, 1, "0.2"},
+        {-0.15f, 1, "-0.2"},
+        // 1.005f = 1.00499999
+        {1.005f, 2, "1.00"}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 四舍五入为0的负数和-0.0不输出负号
+void test_format_float_negative_zero() {
+    static const FormatCase cases[] = {
+        {-0.0f, 0, "0"},
+        {-0.0f, 1, "0.0"},
+        {-0.0f, 4, "0.0000"},
+        {-0.04f, 1, "0.0"},
+        {-0.049f, 1, "0.0"},
+        {-0.4f, 0, "0"},
+        {-0.00004f, 4, "0.0000"},
+        // 0.00005f = 0.0000499999987，名义上的.5实际不足，同样为0
+        {-0.00005f, 4, "0.0000"},
+        // 0.05f = 0.050000001，幅值超过.5，保留负号
+        {-0.05f, 1, "-0.1"},
+        {-0.5f, 0, "-1"}
+    };
+    checkCases(cases, sizeof(cases) / sizeof(cases[0]));
+}
+
+// 大量取值与正确结果逐条比较: 定点值与referenceFixed相同，
+// 文本与printf相同 (printf对恰好为.5的值向偶数取整、对负零输出负号，这两类已在上面列出，此处跳过)
+void test_format_float_matches_reference() {
+    char text[NUM_FORMAT_LENGTH];
+    char expected[32];
+    uint32_t checked = 0;
+    uint32_t seed = 12345;
+
+    for (int32_t n = 0; n < 200000; n++) {
+        float value;
+        uint8_t decimals;
+        if (n <= 2000) {
+            value = (n - 1000) * 0.1731f;
+            decimals = 1;
+        } else {
+            // 放大后的幅值在2^23以内 (formatFloat保证正确舍入的范围)，数量级随机分布
+            seed = seed * 1103515245u + 12345u;
+            decimals = (seed >> 4) % (NUM_FORMAT_MAX_DECIMALS + 1);
+            float limit = 8388607.0f / POW10_CASES[decimals] / (float)(1u << (seed & 15));
+            seed = seed * 1103515245u + 12345u;
+            value = ((int32_t)(seed >> 8) - (1 << 23)) / 8388608.0f * limit;
+        }
+
+        int32_t fixed = referenceFixed(value, decimals);
+        TEST_ASSERT_EQUAL_INT32(fixed, toFixed(value, decimals));
+
+        formatFloat(text, value, decimals);
+        double scaled = (double)value * POW10_CASES[decimals];
+        bool tie = fabs(scaled - trunc(scaled)) == 0.5;
+        if (tie || fixed == 0) {
+            continue;
+        }
+        snprintf(expected, sizeof(expected), "%.*f", decimals, (double)value);
+        TEST_ASSERT_EQUAL_STRING(expected, text);
+        checked++;
+    }
+    TEST_ASSERT_TRUE(checked > 190000);
+}
+
+void test_format_int() {
+    char text[NUM_FORMAT_LENGTH];
+    char expected[32];
+
+    formatInt(text, INT32_MIN);
+    TEST_ASSERT_EQUAL_STRING("-2147483648", text);
+    formatInt(text, INT32_MAX);
+    TEST_ASSERT_EQUAL_STRING("2147483647", text);
+    formatUnsigned(text, UINT32_MAX);
+    TEST_ASSERT_EQUAL_STRING("4294967295", text);
+    formatInt(text, -42, 5);
+    TEST_ASSERT_EQUAL_STRING("  -42", text);
+    formatFixed(text, -5, 2, 6);
+    TEST_ASSERT_EQUAL_STRING(" -0.05", text);
+
+    for (uint32_t i = 0; i < 200001; i++) {
+        int32_t value = (int32_t)((i * 7919u) % 200001u) - 100000;
+        formatInt(text, value);
+        snprintf(expected, sizeof(expected), "%ld", (long)value);
+        TEST_ASSERT_EQUAL_STRING(expected, text);
+    }
+}
+
+// 把Print的输出写入内存 (与formatFloat/formatInt一样只写内存)
+class BufferPrint : public Print {
+private:
+    char* buffer;
+    uint8_t capacity;
+    uint8_t length;
+
+public:
+    BufferPrint(char* _buffer, uint8_t _capacity) {
+        buffer = _buffer;
+        capacity = _capacity;
+        length = 0;
+        buffer[0] = '\0';
+    }
+
+    void reset() {
+        length = 0;
+        buffer[0] = '\0';
+    }
+
+    size_t write(uint8_t c) override {
+        if (length + 1 < capacity) {
+            buffer[length++] = c;
+            buffer[length] = '\0';
+        }
+        return 1;
+    }
+
+    using Print::write;
+};
+
+static float sampleFloat(uint32_t i) {
+    return ((int32_t)(i % 2001) - 1000) * 0.1731f;
+}
+
+static int32_t sampleInt(uint32_t i) {
+    return (int32_t)((i * 7919u) % 200001u) - 100000;
+}
+
+template<class F>
+static void benchLine(const char* name, F body) {
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        sink += body(i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("FMT,%s,%u,%.1f\n", name, BENCH_ITERATIONS, ns / BENCH_ITERATIONS);
+}
+
+// 主机端耗时 (只用于相对比较，目标上的绝对耗时见串口prof的页面绘制区段)
+void test_format_benchmark() {
+    char expected[NUM_FORMAT_LENGTH];
+    char actual[NUM_FORMAT_LENGTH];
+    BufferPrint printer(expected, sizeof(expected));
+
+    benchLine("print_float", [&](uint32_t i) {
+        printer.reset();
+        return (uint32_t)printer.print(sampleFloat(i), 1);
+    });
+    benchLine("format_float", [&](uint32_t i) {
+        return (uint32_t)formatFloat(actual, sampleFloat(i), 1);
+    });
+    benchLine("print_int", [&](uint32_t i) {
+        printer.reset();
+        return (uint32_t)printer.print((long)sampleInt(i));
+    });
+    benchLine("format_int", [&](uint32_t i) {
+        return (uint32_t)formatInt(actual, sampleInt(i));
+    });
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_format_float_ties);
+    RUN_TEST(test_format_float_negative_zero);
+    RUN_TEST(test_format_float_matches_reference);
+    RUN_TEST(test_format_int);
+    RUN_TEST(test_format_benchmark);
+    return UNITY_END();
+}
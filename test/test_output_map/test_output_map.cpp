@@ -0,0 +1,129 @@
+#include <unity.h>
+#include "output_map.h"
+
+// PTC输出线性化: powerToDuty是默认功率表的反插值。
+// 在节点和节点之间检查具体数值，用表的正向双线性插值检查往返误差，
+// 并检查功率指令超出范围、温度超出表范围和禁用线性化时的饱和。
+
+#define MAX_DUTY ((1 << PWM_RESOLUTION) - 1)
+
+// 与src/output_map.cpp的默认表相同 (温度节点 0/20/40/60/80/100℃)
+static const uint16_t POWER_TABLE[OUTPUT_MAP_TEMP_POINTS][OUTPUT_MAP_DUTY_POINTS] = {
+    {0, 256, 512, 768, 1023},
+    {0, 245, 485, 720, 950},
+    {0, 225, 440, 650, 850},
+    {0, 195, 380, 555, 720},
+    {0, 155, 300, 435, 560},
+    {0, 110, 210, 300, 380}
+};
+
+void setUp() {}
+void tearDown() {}
+
+// 正向: 占空比在表中双线性插值得到有效功率
+static float referencePower(float duty, float temp) {
+    float t = (temp - TEMP_MIN) / (TEMP_MAX - TEMP_MIN) * (OUTPUT_MAP_TEMP_POINTS - 1);
+    float d = duty / MAX_DUTY * (OUTPUT_MAP_DUTY_POINTS - 1);
+    int row = t >= OUTPUT_MAP_TEMP_POINTS - 1 ? OUTPUT_MAP_TEMP_POINTS - 2 : (int)t;
+    int col = d >= OUTPUT_MAP_DUTY_POINTS - 1 ? OUTPUT_MAP_DUTY_POINTS - 2 : (int)d;
+    float tf = t - row;
+    float df = d - col;
+
+    float low = POWER_TABLE[row][col] + df * (POWER_TABLE[row][col + 1] - POWER_TABLE[row][col]);
+    float high = POWER_TABLE[row + 1][col] + df * (POWER_TABLE[row + 1][col + 1] - POWER_TABLE[row + 1][col]);
+    return low + tf * (high - low);
+}
+
+// 表节点上和节点之间的反插值
+void test_inverse_interpolation() {
+    OutputMap map;
+
+    // 冷态 (0℃) 表为直线，功率指令即占空比
+    TEST_ASSERT_EQUAL_UINT16(256, map.powerToDuty(256.0, 0.0f));
+    TEST_ASSERT_EQUAL_UINT16(512, map.powerToDuty(512.0, 0.0f));
+
+    // 60℃节点: 功率节点对应占空比节点，节点之间线性
+    TEST_ASSERT_EQUAL_UINT16(256, map.powerToDuty(195.0, 60.0f));
+    TEST_ASSERT_EQUAL_UINT16(512, map.powerToDuty(380.0, 60.0f));
+    TEST_ASSERT_EQUAL_UINT16(384, map.powerToDuty(287.5, 60.0f));
+    TEST_ASSERT_EQUAL_UINT16(128, map.powerToDuty(97.5, 60.0f));
+
+    // 50℃在40℃和60℃两行中间: 第二个节点功率为 (440 + 380) / 2 = 410
+    TEST_ASSERT_EQUAL_UINT16(512, map.powerToDuty(410.0, 50.0f));
+
+    // 同一功率指令温度越高占空比越大
+    TEST_ASSERT_TRUE(map.powerToDuty(300.0, 90.0f) > map.powerToDuty(300.0, 30.0f));
+}
+
+// 正向插值后再反插值，占空比误差不超过1
+void test_round_trip() {
+    OutputMap map;
+
+    for (int temp = 0; temp <= 100; temp += 5) {
+        for (int duty = 0; duty < MAX_DUTY; duty += 7) {
+            float power = referencePower(duty, temp);
+            int result = map.powerToDuty(power, temp);
+            char message[48];
+            snprintf(message, sizeof(message), "duty %d at %d C", duty, temp);
+            TEST_ASSERT_TRUE_MESSAGE(abs(result - duty) <= 1, message);
+        }
+    }
+}
+
+// 功率指令单调，结果不超过满占空比
+void test_monotonic() {
+    OutputMap map;
+
+    for (int temp = -20; temp <= 120; temp += 10) {
+        uint16_t last = 0;
+        for (int power = 0; power <= 1100; power++) {
+            uint16_t duty = map.powerToDuty(power, temp);
+            TEST_ASSERT_TRUE(duty >= last);
+            TEST_ASSERT_TRUE(duty <= MAX_DUTY);
+            last = duty;
+        }
+    }
+}
+
+// 饱和: 不大于0时为0，达到当前温度的最大功率时满占空比；温度超出表范围按两端的行
+void test_saturation() {
+    OutputMap map;
+
+    TEST_ASSERT_EQUAL_UINT16(0, map.powerToDuty(0.0, 50.0f));
+    TEST_ASSERT_EQUAL_UINT16(0, map.powerToDuty(-10.0, 50.0f));
+
+    TEST_ASSERT_EQUAL_FLOAT(1023.0f, map.maxPower(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(785.0f, map.maxPower(50.0f));
+    TEST_ASSERT_EQUAL_FLOAT(380.0f, map.maxPower(100.0f));
+    TEST_ASSERT_EQUAL_UINT16(MAX_DUTY, map.powerToDuty(785.0, 50.0f));
+    TEST_ASSERT_EQUAL_UINT16(MAX_DUTY, map.powerToDuty(PID_OUTPUT_MAX, 50.0f));
+    TEST_ASSERT_TRUE(map.powerToDuty(784.0, 50.0f) < MAX_DUTY);
+
+    TEST_ASSERT_EQUAL_FLOAT(1023.0f, map.maxPower(-10.0f));
+    TEST_ASSERT_EQUAL_FLOAT(380.0f, map.maxPower(150.0f));
+    TEST_ASSERT_EQUAL_UINT16(map.powerToDuty(300.0, TEMP_MIN), map.powerToDuty(300.0, -10.0f));
+    TEST_ASSERT_EQUAL_UINT16(map.powerToDuty(300.0, TEMP_MAX), map.powerToDuty(300.0, 150.0f));
+    TEST_ASSERT_EQUAL_UINT16(MAX_DUTY, map.powerToDuty(380.0, 150.0f));
+}
+
+// 禁用线性化: 功率指令直接作为占空比，上限为满占空比
+void test_disabled() {
+    OutputMap map;
+    map.setEnabled(false);
+
+    TEST_ASSERT_FALSE(map.isEnabled());
+    TEST_ASSERT_EQUAL_UINT16(300, map.powerToDuty(300.0, 90.0f));
+    TEST_ASSERT_EQUAL_UINT16(MAX_DUTY, map.powerToDuty(2000.0, 90.0f));
+    TEST_ASSERT_EQUAL_UINT16(0, map.powerToDuty(-1.0, 90.0f));
+    TEST_ASSERT_EQUAL_FLOAT(1023.0f, map.maxPower(90.0f));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_inverse_interpolation);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_monotonic);
+    RUN_TEST(test_saturation);
+    RUN_TEST(test_disabled);
+    return UNITY_END();
+}
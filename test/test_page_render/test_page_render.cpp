@@ -0,0 +1,347 @@
+#include <unity.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ui_adapter.h"
+#include "oled_flusher.h"
+#include "i2c_arbiter.h"
+#include "temp_trend.h"
+#include "control_channel.h"
+#include "profiler.h"
+
+// 主机端页面渲染: 用固定的测试数据经UIAdapter::update()绘制每个页面，由OledFlusher发送到内存中的SSD1306，
+// 屏幕内容与baseline/<页面>.pbm逐位比较，并在输出目录写出<页面>.pbm/.png供查看，同时测量每页整页重绘的主机耗时。
+// 界面有意改动时设置UPDATE_BASELINE=1重新生成基准并随改动一起提交；输出目录由RENDER_DIR指定 (默认.pio/page_render)。
+// 基准与串口`page snap`的输出去掉"PBM,"前缀后格式相同 (P1，1为点亮)。
+
+#define RENDER_ITERATIONS 200
+#define PNG_SCALE 4
+
+// 渲染环境，与main.cpp中的显示部分对应 (刷新器不启动任务，同步发送)
+struct RenderRig {
+    Adafruit_SSD1306 display;
+    HostSsd1306Panel panel;
+    I2CArbiter arbiter;
+    OledFlusher flusher;
+    TempTrend trend;
+    ControlChannel control;
+    UIAdapter ui;
+
+    RenderRig() : display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire),
+                  flusher(&display, &Wire, &arbiter, OLED_ADDR),
+                  ui(&display, nullptr) {}
+};
+
+static RenderRig* rig = nullptr;
+
+// 各区段的固定耗时 (周期数，主机端按1000MHz换算，即纳秒)
+static const uint32_t PROFILE_FIXTURE[PROF_ZONE_COUNT] = {
+    480000, 12000, 35000, 8000, 2400000, 4100000
+};
+
+// 性能分析页面的数据: 每个区段100次记录，耗时线性分布在固定值的1~2倍之间
+static void loadProfileFixture() {
+    profiler.reset();
+    for (uint8_t zone = 0; zone < PROF_ZONE_COUNT; zone++) {
+        for (uint32_t n = 0; n < 100; n++) {
+            profiler.record((ProfileZone)zone, PROFILE_FIXTURE[zone] + PROFILE_FIXTURE[zone] / 100 * n);
+        }
+    }
+}
+
+// 固定的界面数据: 加热到90℃附近 (在TEMP_MAX以内，温度显示含小数位)，运行1:02:03，有一条加热器错误
+static void loadFixture() {
+    hostClockMicros = 3723ULL * 1000000;
+
+    Wire.attach(OLED_ADDR, &rig->panel);
+    rig->arbiter.begin();
+    rig->display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR);
+    rig->display.setTextSize(1);
+    rig->display.setTextColor(SSD1306_WHITE);
+
+    rig->control.kp.store(2.5f);
+    rig->control.ki.store(0.08f);
+    rig->control.kd.store(12.0f);
+    rig->control.tempOffset.store(-1.5f);
+    rig->control.burstMode.store(true);
+
+    // 3分钟的控制周期采样: 线性升温后保持，叠加0.5℃的三角波纹
+    for (uint32_t i = 0; i < 1800; i++) {
+        float ramp = i < 1625 ? 25.0f + i * 0.04f : 90.0f;
+        uint32_t phase = i % 20;
+        float ripple = (phase < 10 ? phase : 20 - phase) * 0.05f;
+        rig->trend.addSample(ramp + ripple);
+    }
+
+    TEST_ASSERT_TRUE(rig->ui.begin());
+    rig->ui.attachFlusher(&rig->flusher);
+    rig->ui.attachTrend(&rig->trend);
+    rig->ui.attachControl(&rig->control);
+    rig->ui.setTemperature(85.3f, 90.0f);
+    rig->ui.setPowerPercentage(42);
+    rig->ui.setSystemState(STATE_WORKING);
+    rig->ui.setEnergy(12.34f, 567.8f);
+    rig->ui.showError(ERROR_HEATER, "Heater open circuit");
+}
+
+// 切换到页面并绘制一帧 (整页)，经刷新器发送到屏幕
+static void showPage(UIPage page) {
+    rig->ui.setPage(page);
+    rig->ui.redraw();
+    loadProfileFixture();
+    rig->ui.update();
+}
+
+static bool panelMatchesFramebuffer() {
+    return memcmp(rig->panel.ram, rig->display.getBuffer(), sizeof(rig->panel.ram)) == 0;
+}
+
+static bool pixelAt(const uint8_t* buffer, uint8_t x, uint8_t y) {
+    return (buffer[x + (y / 8) * SCREEN_WIDTH] >> (y & 7)) & 1;
+}
+
+static std::string baselinePath(UIPage page) {
+    std::string file = __FILE__;
+    return file.substr(0, file.find_last_of("/\\") + 1) + "baseline/" + UIAdapter::getPageName(page) + ".pbm";
+}
+
+static std::string outputDir() {
+    const char* dir = getenv("RENDER_DIR");
+    return dir != nullptr ? dir : ".pio/page_render";
+}
+
+// plain PBM (P1)，每行一行像素
+static bool writePbm(const std::string& path, const uint8_t* buffer) {
+    std::ofstream file(path);
+    file << "P1\n" << SCREEN_WIDTH << " " << SCREEN_HEIGHT << "\n";
+    for (uint8_t y = 0; y < SCREEN_HEIGHT; y++) {
+        for (uint8_t x = 0; x < SCREEN_WIDTH; x++) {
+            file << (pixelAt(buffer, x, y) ? '1' : '0');
+        }
+        file << "\n";
+    }
+    return file.good();
+}
+
+// 读取P1文件到帧缓冲格式，尺寸不符或文件不存在时返回false
+static bool readPbm(const std::string& path, uint8_t* buffer) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    // 去掉注释
+    std::string clean;
+    bool comment = false;
+    for (char c : text) {
+        if (c == '#') {
+            comment = true;
+        } else if (c == '\n' || c == '\r') {
+            comment = false;
+        }
+        if (!comment) {
+            clean += c;
+        }
+    }
+
+    std::istringstream tokens(clean);
+    std::string magic;
+    int width = 0;
+    int height = 0;
+    tokens >> magic >> width >> height;
+    if (magic != "P1" || width != SCREEN_WIDTH || height != SCREEN_HEIGHT) {
+        return false;
+    }
+
+    memset(buffer, 0, SCREEN_WIDTH * OLED_PAGE_COUNT);
+    int count = 0;
+    char c;
+    while (count < width * height && tokens.get(c)) {
+        if (c != '0' && c != '1') {
+            continue;
+        }
+        if (c == '1') {
+            buffer[count % width + (count / width / 8) * width] |= 1 << ((count / width) & 7);
+        }
+        count++;
+    }
+    return count == width * height;
+}
+
+static uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+static void appendChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> body(type, type + 4);
+    body.insert(body.end(), data.begin(), data.end());
+    appendBigEndian(out, data.size());
+    out.insert(out.end(), body.begin(), body.end());
+    appendBigEndian(out, crc32(body.data(), body.size()));
+}
+
+// 1位灰度PNG，点亮为白色，放大PNG_SCALE倍；图像数据用不压缩的deflate块
+static bool writePng(const std::string& path, const uint8_t* buffer) {
+    const uint32_t width = SCREEN_WIDTH * PNG_SCALE;
+    const uint32_t height = SCREEN_HEIGHT * PNG_SCALE;
+    const uint32_t stride = width / 8 + 1;     // 每行前有一个滤波类型字节 (0)
+
+    std::vector<uint8_t> raw(stride * height, 0);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            if (pixelAt(buffer, x / PNG_SCALE, y / PNG_SCALE)) {
+                raw[y * stride + 1 + x / 8] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    for (size_t offset = 0; offset < raw.size() || offset == 0; offset += 65535) {
+        uint16_t length = raw.size() - offset < 65535 ? raw.size() - offset : 65535;
+        zlib.push_back(offset + length >= raw.size() ? 1 : 0);
+        zlib.push_back(length & 0xFF);
+        zlib.push_back(length >> 8);
+        zlib.push_back(~length & 0xFF);
+        zlib.push_back((~length >> 8) & 0xFF);
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    appendBigEndian(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, width);
+    appendBigEndian(header, height);
+    header.insert(header.end(), {1, 0, 0, 0, 0});  // 位深1，灰度，deflate，无隔行
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", zlib);
+    appendChunk(png, "IEND", {});
+
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char*)png.data(), png.size());
+    return file.good();
+}
+
+// 每个测试使用新的渲染环境，页面内容 (含主页面动画帧) 与测试顺序无关
+void setUp() {
+    rig = new RenderRig();
+    loadFixture();
+}
+
+void tearDown() {
+    delete rig;
+    rig = nullptr;
+}
+
+// 刷新器把每个页面完整送到屏幕，屏幕内容与帧缓冲一致
+void test_panel_matches_framebuffer() {
+    for (uint8_t i = 0; i < UI_PAGE_COUNT; i++) {
+        showPage((UIPage)i);
+        TEST_ASSERT_TRUE_MESSAGE(panelMatchesFramebuffer(), UIAdapter::getPageName((UIPage)i));
+    }
+}
+
+// 每个页面的屏幕内容与基准逐位相同，同时写出.pbm/.png
+void test_pages_match_baseline() {
+    bool update = getenv("UPDATE_BASELINE") != nullptr;
+    std::string dir = outputDir();
+    std::filesystem::create_directories(dir);
+    std::string mismatched;
+
+    for (uint8_t i = 0; i < UI_PAGE_COUNT; i++) {
+        UIPage page = (UIPage)i;
+        const char* name = UIAdapter::getPageName(page);
+        showPage(page);
+
+        TEST_ASSERT_TRUE(writePbm(dir + "/" + name + ".pbm", rig->panel.ram));
+        TEST_ASSERT_TRUE(writePng(dir + "/" + name + ".png", rig->panel.ram));
+        if (update) {
+            TEST_ASSERT_TRUE(writePbm(baselinePath(page), rig->panel.ram));
+            continue;
+        }
+
+        uint8_t expected[SCREEN_WIDTH * OLED_PAGE_COUNT];
+        if (!readPbm(baselinePath(page), expected) ||
+            memcmp(expected, rig->panel.ram, sizeof(expected)) != 0) {
+            mismatched += mismatched.empty() ? name : std::string(" ") + name;
+        }
+    }
+
+    printf("RENDER,输出目录,%s\n", dir.c_str());
+    if (!mismatched.empty()) {
+        std::string message = "pages differ from baseline: " + mismatched;
+        TEST_FAIL_MESSAGE(message.c_str());
+    }
+}
+
+// 页面切换发送的字节数和整页重绘的主机耗时:
+// RENDER,页面,切换发送字节 (与上一页面相比),重绘次数,平均us,最长us
+void test_render_timing() {
+    for (uint8_t i = 0; i < UI_PAGE_COUNT; i++) {
+        UIPage page = (UIPage)i;
+        uint32_t bytes = rig->panel.dataBytes;
+        showPage(page);
+        bytes = rig->panel.dataBytes - bytes;
+
+        double total = 0;
+        double longest = 0;
+        for (uint16_t n = 0; n < RENDER_ITERATIONS; n++) {
+            auto start = std::chrono::steady_clock::now();
+            rig->ui.redraw();
+            rig->ui.update();
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            total += us;
+            longest = us > longest ? us : longest;
+        }
+
+        printf("RENDER,%s,%u,%u,%.1f,%.1f\n", UIAdapter::getPageName(page), bytes,
+               RENDER_ITERATIONS, total / RENDER_ITERATIONS, longest);
+        TEST_ASSERT_TRUE(panelMatchesFramebuffer());
+    }
+}
+
+// 总线错误期间的一帧没有送达；内容不变的下一帧整屏重发，屏幕恢复一致
+void test_flush_recovers_after_bus_error() {
+    showPage(UI_PAGE_MAIN);
+    TEST_ASSERT_TRUE(panelMatchesFramebuffer());
+
+    Wire.failResult = 4;
+    showPage(UI_PAGE_SYSTEM_INFO);
+    Wire.failResult = 0;
+    TEST_ASSERT_FALSE(panelMatchesFramebuffer());
+
+    showPage(UI_PAGE_SYSTEM_INFO);
+    TEST_ASSERT_TRUE(panelMatchesFramebuffer());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_panel_matches_framebuffer);
+    RUN_TEST(test_pages_match_baseline);
+    RUN_TEST(test_render_timing);
+    RUN_TEST(test_flush_recovers_after_bus_error);
+    return UNITY_END();
+}
@@ -0,0 +1,221 @@
+#include <unity.h>
+#include "scheduler.h"
+
+// 调度器: 在虚拟时钟上运行，任务函数按设定的执行时间推进时钟。
+// 检查释放相位和周期、同时到期时的优先级顺序、超过截止期限的计数、
+// 落后超过一个周期时的跳过计数和之后的释放时间、延迟统计和millis()回绕。
+
+#define MAX_RUNS 64
+
+// 测试任务: 记录每次运行的开始时间，执行时间可逐次指定
+struct TestJob {
+    uint32_t execTime;              // 每次执行推进的毫秒数
+    int32_t slowRun;                // 这一次运行 (从0计) 改用slowTime，-1为不使用
+    uint32_t slowTime;
+    uint32_t count;
+    unsigned long starts[MAX_RUNS];
+    char tag;                       // 写入运行顺序
+};
+
+static char order[MAX_RUNS + 1];
+static uint8_t orderLength;
+
+static void testJob(void* context) {
+    TestJob* job = (TestJob*)context;
+    if (job->count < MAX_RUNS) {
+        job->starts[job->count] = millis();
+    }
+    if (orderLength < MAX_RUNS) {
+        order[orderLength++] = job->tag;
+        order[orderLength] = '\0';
+    }
+    hostAdvanceMillis((int32_t)job->count == job->slowRun ? job->slowTime : job->execTime);
+    job->count++;
+}
+
+static void initJob(TestJob* job, char tag, uint32_t execTime) {
+    memset(job, 0, sizeof(*job));
+    job->tag = tag;
+    job->execTime = execTime;
+    job->slowRun = -1;
+}
+
+// 运行调度器直到虚拟时间到达end (每次休眠到下一次释放)
+static void runUntil(Scheduler& scheduler, unsigned long end) {
+    while ((int32_t)(millis() - end) < 0) {
+        uint32_t wait = scheduler.runDue();
+        if ((int32_t)(millis() + wait - end) > 0) {
+            wait = end - millis();
+        }
+        hostAdvanceMillis(wait);
+    }
+}
+
+void setUp() {
+    hostClockMicros = 1000 * 1000ULL;
+    orderLength = 0;
+    order[0] = '\0';
+}
+
+void tearDown() {}
+
+// 同周期的任务按相位错开，释放时间不随执行时间漂移，没有延迟
+void test_phase() {
+    Scheduler scheduler("test");
+    TestJob a, b;
+    initJob(&a, 'a', 3);
+    initJob(&b, 'b', 5);
+    scheduler.addJob("a", testJob, &a, 100, 0, 1, 100);
+    scheduler.addJob("b", testJob, &b, 100, 30, 1, 100);
+
+    scheduler.start();
+    runUntil(scheduler, 1000 + 1000);
+
+    TEST_ASSERT_EQUAL_UINT32(10, a.count);
+    TEST_ASSERT_EQUAL_UINT32(10, b.count);
+    for (uint32_t i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL_UINT32(1000 + i * 100, a.starts[i]);
+        TEST_ASSERT_EQUAL_UINT32(1030 + i * 100, b.starts[i]);
+    }
+
+    const SchedulerJob* job = scheduler.getJob(1);
+    TEST_ASSERT_EQUAL_UINT32(10, job->runs);
+    TEST_ASSERT_EQUAL_UINT32(0, job->overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, job->skipped);
+    TEST_ASSERT_EQUAL_UINT32(0, job->maxLateness);
+    TEST_ASSERT_EQUAL_UINT32(10, job->latenessHistogram[0]);
+    TEST_ASSERT_EQUAL_UINT32(5000, job->maxExecTime);
+
+    // 每100毫秒执行8毫秒
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.0f, scheduler.getLoad());
+}
+
+// 同时到期: 优先级高者先运行，同优先级先释放者先运行
+void test_priority_order() {
+    Scheduler scheduler("test");
+    TestJob low, high, early;
+    initJob(&low, 'l', 1);
+    initJob(&high, 'h', 1);
+    initJob(&early, 'e', 1);
+    scheduler.addJob("low", testJob, &low, 100, 10, 1, 100);
+    scheduler.addJob("high", testJob, &high, 100, 10, 5, 100);
+    scheduler.addJob("early", testJob, &early, 100, 5, 1, 100);
+
+    // 三个任务都已到期时才运行
+    scheduler.start();
+    hostAdvanceMillis(20);
+    scheduler.runDue();
+
+    TEST_ASSERT_EQUAL_STRING("hel", order);
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.getJob(1)->maxLateness);
+    TEST_ASSERT_EQUAL_UINT32(16, scheduler.getJob(2)->maxLateness);
+    TEST_ASSERT_EQUAL_UINT32(12, scheduler.getJob(0)->maxLateness);
+}
+
+// 超过截止期限: 完成时间晚于释放时间加截止期限时计数，低优先级任务的启动延迟计入分布
+void test_overrun() {
+    Scheduler scheduler("test");
+    TestJob control, ui;
+    initJob(&control, 'c', 5);
+    initJob(&ui, 'u', 1);
+    control.slowRun = 2;
+    control.slowTime = 30;
+    scheduler.addJob("control", testJob, &control, 100, 0, 2, 20);
+    scheduler.addJob("ui", testJob, &ui, 100, 10, 1, 50);
+
+    scheduler.start();
+    runUntil(scheduler, 1000 + 500);
+
+    const SchedulerJob* job = scheduler.getJob(0);
+    TEST_ASSERT_EQUAL_UINT32(5, job->runs);
+    TEST_ASSERT_EQUAL_UINT32(1, job->overruns);
+    TEST_ASSERT_EQUAL_UINT32(0, job->skipped);
+
+    // 第三个周期ui在control完成后才开始，延迟20毫秒 (分布区间16-31)，未超过ui的截止期限
+    job = scheduler.getJob(1);
+    TEST_ASSERT_EQUAL_UINT32(1230, ui.starts[2]);
+    TEST_ASSERT_EQUAL_UINT32(20, job->maxLateness);
+    TEST_ASSERT_EQUAL_UINT32(4, job->latenessHistogram[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, job->latenessHistogram[5]);
+    TEST_ASSERT_EQUAL_UINT32(0, job->overruns);
+
+    // 之后的周期恢复原来的释放时间
+    TEST_ASSERT_EQUAL_UINT32(1300, control.starts[3]);
+    TEST_ASSERT_EQUAL_UINT32(1310, ui.starts[3]);
+}
+
+// 落后超过一个周期: 跳过错过的周期，不连续补跑，之后仍按原相位释放
+void test_skip() {
+    Scheduler scheduler("test");
+    TestJob job;
+    initJob(&job, 'j', 2);
+    job.slowRun = 1;
+    job.slowTime = 250;
+    scheduler.addJob("job", testJob, &job, 100, 0, 1, 100);
+
+    scheduler.start();
+    runUntil(scheduler, 1000 + 600);
+
+    // 1100开始的一次在1350完成: 跳过1200，1300的一次延迟50毫秒运行
+    const SchedulerJob* stats = scheduler.getJob(0);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->overruns);
+    TEST_ASSERT_EQUAL_UINT32(5, job.count);
+    TEST_ASSERT_EQUAL_UINT32(1000, job.starts[0]);
+    TEST_ASSERT_EQUAL_UINT32(1100, job.starts[1]);
+    TEST_ASSERT_EQUAL_UINT32(1350, job.starts[2]);
+    TEST_ASSERT_EQUAL_UINT32(1400, job.starts[3]);
+    TEST_ASSERT_EQUAL_UINT32(1500, job.starts[4]);
+    TEST_ASSERT_EQUAL_UINT32(50, stats->maxLateness);
+}
+
+// 修改周期从下一次释放后生效
+void test_set_period() {
+    Scheduler scheduler("test");
+    TestJob job;
+    initJob(&job, 'j', 1);
+    int8_t index = scheduler.addJob("job", testJob, &job, 100, 0, 1, 100);
+
+    scheduler.start();
+    runUntil(scheduler, 1000 + 150);
+    scheduler.setPeriod(index, 500, 500);
+    runUntil(scheduler, 1000 + 1200);
+
+    TEST_ASSERT_EQUAL_UINT32(4, job.count);
+    TEST_ASSERT_EQUAL_UINT32(1100, job.starts[1]);
+    TEST_ASSERT_EQUAL_UINT32(1200, job.starts[2]);
+    TEST_ASSERT_EQUAL_UINT32(1700, job.starts[3]);
+}
+
+// millis()回绕前后释放间隔不变，不产生延迟或跳过
+void test_millis_wraparound() {
+    Scheduler scheduler("test");
+    TestJob job;
+    initJob(&job, 'j', 1);
+    scheduler.addJob("job", testJob, &job, 100, 0, 1, 100);
+
+    hostClockMicros = (0x100000000ULL - 250) * 1000;
+    unsigned long begin = millis();
+    scheduler.start();
+    runUntil(scheduler, begin + 600);
+
+    TEST_ASSERT_EQUAL_UINT32(6, job.count);
+    for (uint32_t i = 1; i < job.count; i++) {
+        TEST_ASSERT_EQUAL_UINT32(100, (uint32_t)(job.starts[i] - job.starts[i - 1]));
+    }
+    TEST_ASSERT_TRUE(job.starts[5] < begin);
+    const SchedulerJob* stats = scheduler.getJob(0);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->maxLateness);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->skipped);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_phase);
+    RUN_TEST(test_priority_order);
+    RUN_TEST(test_overrun);
+    RUN_TEST(test_skip);
+    RUN_TEST(test_set_period);
+    RUN_TEST(test_millis_wraparound);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+#include <unity.h>
+#include <thread>
+#include "spsc_ring.h"
+
+// 容量取小值，让压力测试中的索引绕回很多次
+#define STRESS_CAPACITY 8
+#define STRESS_ITEMS 2000000u
+
+// 每项带校验字段，读到写了一半的项时两个字段不一致
+struct StressItem {
+    uint32_t sequence;
+    uint32_t check;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// 单线程: 满时拒绝写入并计数，读出顺序与写入一致
+void test_push_pop_order() {
+    SpscRing<uint32_t, 4> ring;
+    uint32_t value;
+    
+    TEST_ASSERT_FALSE(ring.pop(value));
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_FALSE(ring.push(99));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(4, ring.size());
+    
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(i, value);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+// 单线程: 交替读写多次绕回后仍保持顺序
+void test_wraparound() {
+    SpscRing<uint32_t, 4> ring;
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    uint32_t value;
+    
+    for (int round = 0; round < 1000; round++) {
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(ring.push(next++));
+        }
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(ring.pop(value));
+            TEST_ASSERT_EQUAL_UINT32(expected++, value);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ring.getDropped());
+}
+
+// 生产者和消费者线程并发: 每一项恰好读出一次、顺序不变、内容完整；
+// 生产者遇到满时重试，丢弃计数应等于重试次数
+void test_concurrent_stress() {
+    static SpscRing<StressItem, STRESS_CAPACITY> ring;
+    uint32_t retries = 0;
+    
+    std::thread producer([&retries]() {
+        for (uint32_t i = 0; i < STRESS_ITEMS; i++) {
+            StressItem item = {i, ~i};
+            while (!ring.push(item)) {
+                retries++;
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    uint32_t received = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t torn = 0;
+    while (received < STRESS_ITEMS) {
+        StressItem item;
+        if (!ring.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (item.sequence != received) {
+            outOfOrder++;
+        }
+        if (item.check != ~item.sequence) {
+            torn++;
+        }
+        received++;
+    }
+    producer.join();
+    
+    StressItem extra;
+    TEST_ASSERT_FALSE(ring.pop(extra));
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(retries, ring.getDropped());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_push_pop_order);
+    RUN_TEST(test_wraparound);
+    RUN_TEST(test_concurrent_stress);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+#include <unity.h>
+#include "temp_trend.h"
+
+// 温度趋势记录: 采样按5个一列合并进1分钟尺度，1分钟尺度10列合并为10分钟尺度一列，
+// 10分钟尺度6列合并为1小时尺度一列。采样值取递增序列，每列的包络可由采样序号直接算出，
+// 检查各尺度的列数和包络、未完成的列不可见，以及写满后getColumn按age绕回读取。
+
+// 各尺度一列包含的采样数
+#define SCALE0_SAMPLES TREND_SAMPLES_PER_COLUMN
+#define SCALE1_SAMPLES (SCALE0_SAMPLES * TREND_SCALE_RATIO_10MIN)
+#define SCALE2_SAMPLES (SCALE1_SAMPLES * TREND_SCALE_RATIO_1H)
+
+void setUp() {}
+void tearDown() {}
+
+// 第i个采样为 i * 0.1°C (记录值为i)
+static void addSamples(TempTrend& trend, uint32_t first, uint32_t count) {
+    for (uint32_t i = first; i < first + count; i++) {
+        trend.addSample(i / 10.0f);
+    }
+}
+
+// 第index列 (从0计) 由采样 index*samples 到 (index+1)*samples-1 合并而成
+static void checkColumn(TempTrend& trend, uint8_t scale, uint16_t age, uint32_t index, uint32_t samples) {
+    char message[48];
+    snprintf(message, sizeof(message), "scale %u age %u", scale, age);
+    TrendColumn column = trend.getColumn(scale, age);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(index * samples, column.minValue, message);
+    TEST_ASSERT_EQUAL_INT_MESSAGE((index + 1) * samples - 1, column.maxValue, message);
+}
+
+static void checkEmpty(TempTrend& trend, uint8_t scale, uint16_t age) {
+    TrendColumn column = trend.getColumn(scale, age);
+    TEST_ASSERT_TRUE(column.minValue > column.maxValue);
+}
+
+// 5/10/6逐级合并: 各尺度的列数和最新列的包络
+void test_cascade() {
+    TempTrend trend;
+
+    // 1小时尺度的一列减1个采样: 各尺度当前列都未完成
+    addSamples(trend, 0, SCALE2_SAMPLES - 1);
+    TEST_ASSERT_EQUAL_UINT32(SCALE2_SAMPLES / SCALE0_SAMPLES - 1, trend.getColumnCount(0));
+    TEST_ASSERT_EQUAL_UINT32(TREND_SCALE_RATIO_1H - 1, trend.getColumnCount(1));
+    TEST_ASSERT_EQUAL_UINT32(0, trend.getColumnCount(2));
+    checkColumn(trend, 0, 0, SCALE2_SAMPLES / SCALE0_SAMPLES - 2, SCALE0_SAMPLES);
+    checkColumn(trend, 1, 0, TREND_SCALE_RATIO_1H - 2, SCALE1_SAMPLES);
+    checkEmpty(trend, 2, 0);
+
+    // 最后一个采样同时完成三个尺度的列
+    addSamples(trend, SCALE2_SAMPLES - 1, 1);
+    TEST_ASSERT_EQUAL_UINT32(SCALE2_SAMPLES / SCALE0_SAMPLES, trend.getColumnCount(0));
+    TEST_ASSERT_EQUAL_UINT32(TREND_SCALE_RATIO_1H, trend.getColumnCount(1));
+    TEST_ASSERT_EQUAL_UINT32(1, trend.getColumnCount(2));
+    checkColumn(trend, 0, 0, SCALE2_SAMPLES / SCALE0_SAMPLES - 1, SCALE0_SAMPLES);
+    checkColumn(trend, 1, 0, TREND_SCALE_RATIO_1H - 1, SCALE1_SAMPLES);
+    checkColumn(trend, 2, 0, 0, SCALE2_SAMPLES);
+
+    // 较早的列
+    checkColumn(trend, 0, 7, SCALE2_SAMPLES / SCALE0_SAMPLES - 8, SCALE0_SAMPLES);
+    checkColumn(trend, 1, TREND_SCALE_RATIO_1H - 1, 0, SCALE1_SAMPLES);
+    checkEmpty(trend, 1, TREND_SCALE_RATIO_1H);
+}
+
+// 写满后新列覆盖最旧的列: age按写入位置绕回，age超出保存的列数时为空列
+void test_column_wraparound() {
+    TempTrend trend;
+    const uint32_t extra = 7;
+    const uint32_t total = TREND_COLUMNS + extra;
+
+    addSamples(trend, 0, total * SCALE0_SAMPLES);
+    TEST_ASSERT_EQUAL_UINT32(total, trend.getColumnCount(0));
+    for (uint16_t age = 0; age < TREND_COLUMNS; age++) {
+        checkColumn(trend, 0, age, total - 1 - age, SCALE0_SAMPLES);
+    }
+    checkEmpty(trend, 0, TREND_COLUMNS);
+    checkEmpty(trend, 0, UINT16_MAX);
+    checkEmpty(trend, TREND_SCALE_COUNT, 0);
+
+    // 范围只包含仍保存的列
+    int16_t minValue, maxValue;
+    TEST_ASSERT_TRUE(trend.getRange(0, &minValue, &maxValue));
+    TEST_ASSERT_EQUAL_INT(extra * SCALE0_SAMPLES, minValue);
+    TEST_ASSERT_EQUAL_INT(total * SCALE0_SAMPLES - 1, maxValue);
+
+    // 绕回多圈后仍然正确
+    addSamples(trend, total * SCALE0_SAMPLES, 3 * TREND_COLUMNS * SCALE0_SAMPLES);
+    uint32_t count = trend.getColumnCount(0);
+    TEST_ASSERT_EQUAL_UINT32(total + 3 * TREND_COLUMNS, count);
+    for (uint16_t age = 0; age < TREND_COLUMNS; age += 13) {
+        checkColumn(trend, 0, age, count - 1 - age, SCALE0_SAMPLES);
+    }
+}
+
+// 包络: 一列内非单调的采样取最低和最高值；超出int16范围的读数限幅
+void test_envelope_and_clamp() {
+    TempTrend trend;
+    static const float samples[SCALE0_SAMPLES] = {25.0f, 24.2f, 26.06f, 25.5f, 25.1f};
+    for (uint8_t i = 0; i < SCALE0_SAMPLES; i++) {
+        trend.addSample(samples[i]);
+    }
+    TrendColumn column = trend.getColumn(0, 0);
+    TEST_ASSERT_EQUAL_INT(242, column.minValue);
+    TEST_ASSERT_EQUAL_INT(261, column.maxValue);
+
+    trend.addSample(-5000.0f);
+    for (uint8_t i = 1; i < SCALE0_SAMPLES; i++) {
+        trend.addSample(5000.0f);
+    }
+    column = trend.getColumn(0, 0);
+    TEST_ASSERT_EQUAL_INT(INT16_MIN + 1, column.minValue);
+    TEST_ASSERT_EQUAL_INT(INT16_MAX - 1, column.maxValue);
+}
+
+// 清除后没有数据
+void test_clear() {
+    TempTrend trend;
+    int16_t minValue, maxValue;
+
+    TEST_ASSERT_FALSE(trend.getRange(0, &minValue, &maxValue));
+    addSamples(trend, 0, SCALE2_SAMPLES);
+    TEST_ASSERT_TRUE(trend.getRange(2, &minValue, &maxValue));
+
+    trend.clear();
+    for (uint8_t scale = 0; scale < TREND_SCALE_COUNT; scale++) {
+        TEST_ASSERT_EQUAL_UINT32(0, trend.getColumnCount(scale));
+        TEST_ASSERT_FALSE(trend.getRange(scale, &minValue, &maxValue));
+        checkEmpty(trend, scale, 0);
+    }
+    TEST_ASSERT_EQUAL_STRING("1h", TempTrend::getScaleName(2));
+    TEST_ASSERT_EQUAL_STRING("", TempTrend::getScaleName(TREND_SCALE_COUNT));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_cascade);
+    RUN_TEST(test_column_wraparound);
+    RUN_TEST(test_envelope_and_clamp);
+    RUN_TEST(test_clear);
+    return UNITY_END();
+}
@@ -0,0 +1,378 @@
+#include <unity.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "trace_recorder.h"
+#include "control_loop.h"
+#include "user_input.h"
+#include "ui_adapter.h"
+#include "scheduler.h"
+
+// 主机端回放: 记录的ADC码、控制命令/参数和输入事件按记录时间送入与固件相同的ControlLoop、
+// UserInput和UIAdapter (astra前端不在主机端构建中，主界面长按不做处理)，
+// 调度器和时钟都是虚拟的，同一份记录每次回放结果逐位相同，可以用摘要对比不同提交 (二分定位)。
+// 设置环境变量TRACE_FILE为串口`trace dump`的输出文件时回放该记录，否则回放内置的合成记录。
+
+#define SYNTH_TARGET_TEMP 60.0f
+#define SYNTH_DURATION_MS 30000
+
+// 一次回放的结果
+struct ReplayResult {
+    uint32_t inputEvents;       // UserInput识别出的事件数
+    uint32_t controlTicks;      // 控制周期数
+    uint32_t elapsed;           // 回放耗用的虚拟时间 (毫秒)
+    uint64_t digest;            // 每个控制周期的温度/输出/占空比/状态和每个输入事件后的页面/目标温度摘要
+    uint32_t uiCommands;        // UI由回放的输入事件发出的命令 (回放期间不生效，与记录中的命令对照)
+    float finalTemp;
+    double finalOutput;
+    float finalTarget;          // 控制回路最后使用的目标温度 (来自记录)
+    float uiTarget;             // UI的目标温度 (由回放的旋转得到)
+    SystemState stateAfter;     // 回放结束后下一个控制周期的状态
+    bool finished;
+};
+
+// 回放环境，与main.cpp中的采样/控制/输入任务对应
+struct ReplayRig {
+    TraceRecorder recorder;
+    TempSensor sensor;
+    PIDController pid;
+    PWMController pwm;
+    OutputMap outputMap;
+    HeaterMonitor monitor;
+    ControlChannel channel;
+    ControlLoop control;
+    UserInput input;
+    Adafruit_SSD1306 display;
+    UIAdapter ui;
+    Scheduler scheduler;
+    TelemetryFrame telemetry;
+    uint32_t lastErrorSequence;
+    uint32_t replayStart;       // 回放开始时钟，摘要中的时间都相对于它
+    ReplayResult result;
+
+    ReplayRig() : control(&sensor, &pid, &pwm, &monitor, &outputMap, &channel),
+                  display(SCREEN_WIDTH, SCREEN_HEIGHT), ui(&display, &input), scheduler("replay") {}
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void digestAppend(uint64_t& digest, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        digest = (digest ^ bytes[i]) * 0x100000001B3ULL;
+    }
+}
+
+// 与sampleJob相同
+static void replaySampleJob(void* context) {
+    ReplayRig* rig = (ReplayRig*)context;
+    rig->control.sampleTemperature(millis());
+}
+
+// 与controlJob相同 (电源管理除外)，之后把本周期的结果计入摘要
+static void replayControlJob(void* context) {
+    ReplayRig* rig = (ReplayRig*)context;
+    unsigned long now = millis();
+
+    rig->result.uiCommands |= rig->channel.commands.load();
+    rig->control.step(now);
+
+    uint32_t timestamp = now - rig->replayStart;
+    float temp = rig->sensor.readTemperature();
+    float target = rig->pid.getTargetTemp();
+    double output = rig->pid.getOutput();
+    uint16_t duty = rig->pwm.getDutyCycle();
+    uint8_t state = rig->control.getState();
+    digestAppend(rig->result.digest, &timestamp, sizeof(timestamp));
+    digestAppend(rig->result.digest, &temp, sizeof(temp));
+    digestAppend(rig->result.digest, &target, sizeof(target));
+    digestAppend(rig->result.digest, &output, sizeof(output));
+    digestAppend(rig->result.digest, &duty, sizeof(duty));
+    digestAppend(rig->result.digest, &state, sizeof(state));
+    rig->result.controlTicks++;
+    rig->result.finalTemp = temp;
+    rig->result.finalOutput = output;
+    rig->result.finalTarget = target;
+}
+
+// 与inputJob相同 (astra前端除外): 同步遥测，注入记录的输入，分发识别出的事件
+static void replayInputJob(void* context) {
+    ReplayRig* rig = (ReplayRig*)context;
+
+    while (rig->channel.telemetry.pop(rig->telemetry)) {
+        if (rig->telemetry.errorSequence != rig->lastErrorSequence) {
+            rig->lastErrorSequence = rig->telemetry.errorSequence;
+            rig->ui.showError((ErrorCode)rig->telemetry.errorCode, rig->telemetry.errorMessage);
+        }
+    }
+    rig->channel.targetTemp.store(rig->ui.getTargetTemp());
+    rig->ui.setTemperature(rig->telemetry.currentTemp, rig->ui.getTargetTemp());
+    rig->ui.setSystemState((SystemState)rig->telemetry.systemState);
+
+    if (rig->recorder.isReplaying()) {
+        TraceRecord record;
+        while (rig->recorder.nextReplay(TRACE_SOURCE_INPUT, millis(), record)) {
+            if (record.type == TRACE_BUTTON) {
+                ButtonEdge edge;
+                edge.timestamp = record.timestamp;
+                edge.level = record.value;
+                rig->input.injectEdge(edge);
+            } else {
+                rig->input.injectRotation(record.value, record.timestamp);
+            }
+        }
+        if (rig->recorder.replayFinished()) {
+            rig->recorder.stop();
+            rig->input.setReplayMode(false);
+            rig->result.finished = true;
+        }
+    }
+
+    rig->input.update();
+    InputEvent event;
+    while ((event = rig->input.getEvent()).type != EV_NONE) {
+        if (!rig->ui.handleControlInput(event)) {
+            rig->ui.handleInput(event);
+        }
+
+        uint32_t timestamp = event.timestamp - rig->replayStart;
+        uint8_t page = rig->ui.getPage();
+        float target = rig->ui.getTargetTemp();
+        digestAppend(rig->result.digest, &timestamp, sizeof(timestamp));
+        digestAppend(rig->result.digest, &event.type, sizeof(event.type));
+        digestAppend(rig->result.digest, &page, sizeof(page));
+        digestAppend(rig->result.digest, &target, sizeof(target));
+        rig->result.inputEvents++;
+    }
+}
+
+// 从时钟startTime开始回放一组记录，直到全部送完，之后再运行一个控制周期 (回放结束时停止加热)
+static ReplayResult replay(const std::vector<TraceRecord>& records, uint32_t startTime, float uiTarget) {
+    hostClockMicros = (uint64_t)startTime * 1000;
+
+    ReplayRig* rig = new ReplayRig();
+    rig->result = {0, 0, 0, 0xCBF29CE484222325ULL, 0, 0.0f, 0.0, 0.0f, 0.0f, STATE_IDLE, false};
+    rig->telemetry = {};
+    rig->lastErrorSequence = 0;
+
+    // 初始采样取第一条记录的原始码，滤波缓冲区与目标上电时一样被填满
+    for (const TraceRecord& record : records) {
+        if (record.type == TRACE_ADC && record.channel == NTC_CHANNEL) {
+            hostAdsCode[NTC_CHANNEL] = record.value;
+            break;
+        }
+    }
+    rig->sensor.begin();
+    rig->pid.begin();
+    rig->pwm.begin();
+    rig->input.begin();
+    rig->display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR);
+    rig->ui.attachControl(&rig->channel);
+    TEST_ASSERT_TRUE(rig->ui.begin());
+    rig->ui.setTargetTemp(uiTarget);
+    rig->control.attachRecorder(&rig->recorder);
+
+    // 与setup()一样，控制通道中的参数以各模块的当前值为起点
+    double kp, ki, kd;
+    rig->pid.getTunings(&kp, &ki, &kd);
+    rig->channel.kp.store(kp);
+    rig->channel.ki.store(ki);
+    rig->channel.kd.store(kd);
+    rig->channel.targetTemp.store(uiTarget);
+
+    for (const TraceRecord& record : records) {
+        TEST_ASSERT_TRUE(rig->recorder.append(record));
+    }
+
+    rig->scheduler.addJob("control", replayControlJob, rig, PID_COMPUTE_INTERVAL, CONTROL_PHASE_MS, 3, PID_COMPUTE_INTERVAL / 2);
+    rig->scheduler.addJob("sample", replaySampleJob, rig, TEMP_SAMPLE_INTERVAL, 0, 2, TEMP_SAMPLE_INTERVAL / 2);
+    rig->scheduler.addJob("input", replayInputJob, rig, UI_TASK_PERIOD_MS, 0, 4, UI_TASK_PERIOD_MS * 2);
+
+    // 与`trace play`相同
+    rig->replayStart = millis();
+    TEST_ASSERT_TRUE(rig->recorder.startReplay(rig->replayStart));
+    rig->input.setReplayMode(true);
+    rig->scheduler.start();
+    while (!rig->result.finished) {
+        hostAdvanceMillis(rig->scheduler.runDue());
+    }
+    ReplayResult result = rig->result;
+    result.elapsed = millis() - rig->replayStart;
+    result.uiTarget = rig->ui.getTargetTemp();
+
+    uint32_t ticks = rig->result.controlTicks;
+    while (rig->result.controlTicks == ticks) {
+        hostAdvanceMillis(rig->scheduler.runDue());
+    }
+    result.stateAfter = rig->control.getState();
+    TEST_ASSERT_FALSE(rig->pwm.isEnabled());
+    TEST_ASSERT_FALSE(rig->pwm.isOutputInhibited());
+
+    delete rig;
+    return result;
+}
+
+// NTC温度对应的ADS1115原始码 (TempSensor::voltageToTemp的逆运算，增益±4.096V)
+static int16_t ntcCode(double temp) {
+    double r = NTC_R25 * exp(NTC_B * (1.0 / (temp + 273.15) - 1.0 / 298.15));
+    double volts = NTC_VCC * NTC_SERIES_R / (NTC_SERIES_R + r);
+    return (int16_t)lround(volts / (4.096 / 32768));
+}
+
+static int16_t supplyCode(double volts) {
+    return (int16_t)lround(volts / SUPPLY_DIVIDER_RATIO / (4.096 / 32768));
+}
+
+// 一个控制参数的两条记录 (与TraceRecorder::recordSetting相同)
+static void pushSetting(std::vector<TraceRecord>& records, uint32_t at, TraceSetting setting, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    records.push_back({at, TRACE_SETTING, (uint8_t)(setting * 2), (int16_t)(bits & 0xFFFF)});
+    records.push_back({at, TRACE_SETTING, (uint8_t)(setting * 2 + 1), (int16_t)(bits >> 16)});
+}
+
+// 合成记录: 开始记录时的参数快照，一阶升温到目标附近，采样时间带几毫秒抖动；
+// 5秒时单击开始加热 (单击在双击间隔后才确认，控制任务在下一个周期收到命令)，
+// 12秒时旋转+2、-1格调整目标温度，控制任务依次收到62℃和61℃
+static std::vector<TraceRecord> synthTrace() {
+    std::vector<TraceRecord> records;
+    uint32_t jitter = 12345;
+    const uint32_t base = 700000;   // 记录时的时钟，与回放时钟无关
+
+    pushSetting(records, base, TRACE_SETTING_TARGET, SYNTH_TARGET_TEMP);
+    pushSetting(records, base, TRACE_SETTING_KP, PID_KP_DEFAULT);
+    pushSetting(records, base, TRACE_SETTING_KI, PID_KI_DEFAULT);
+    pushSetting(records, base, TRACE_SETTING_KD, PID_KD_DEFAULT);
+    pushSetting(records, base, TRACE_SETTING_OUTPUT_MODE, 0.0f);
+    pushSetting(records, base, TRACE_SETTING_CALIBRATION, 0.0f);
+
+    for (uint32_t t = 0; t < SYNTH_DURATION_MS; t += TEMP_SAMPLE_INTERVAL) {
+        jitter = jitter * 1103515245u + 12345u;
+        uint32_t at = base + t + (jitter >> 16) % 4;
+        double temp = 25.0 + (SYNTH_TARGET_TEMP + 2.0 - 25.0) * (1.0 - exp(-(double)t / 8000.0));
+        records.push_back({at, TRACE_ADC, NTC_CHANNEL, ntcCode(temp)});
+        if (t % SUPPLY_SAMPLE_INTERVAL == 0) {
+            records.push_back({at + SUPPLY_PHASE_MS, TRACE_ADC, SUPPLY_CHANNEL, supplyCode(11.8)});
+        }
+        if (t == 5000) {
+            records.push_back({at + 3, TRACE_BUTTON, 0, LOW});
+            records.push_back({at + 83, TRACE_BUTTON, 0, HIGH});
+        }
+        if (t == 5700) {
+            records.push_back({base + t + CONTROL_PHASE_MS, TRACE_COMMAND, 0, CMD_START});
+        }
+        if (t == 12000 || t == 12100) {
+            records.push_back({at + 7, TRACE_ROTATION, 0, (int16_t)(t == 12000 ? 2 : -1)});
+        }
+        if (t == 12100 || t == 12200) {
+            pushSetting(records, base + t + CONTROL_PHASE_MS, TRACE_SETTING_TARGET, t == 12100 ? 62.0f : 61.0f);
+        }
+    }
+    return records;
+}
+
+// 读取串口dump输出 (忽略TRC,BEGIN/END和其他行)
+static std::vector<TraceRecord> loadTrace(const char* path) {
+    std::vector<TraceRecord> records;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) {
+            line.pop_back();
+        }
+        size_t pos = line.find("TRC,");
+        TraceRecord record;
+        if (pos != std::string::npos && TraceRecorder::parseRecord(line.c_str() + pos + 4, record)) {
+            records.push_back(record);
+        }
+    }
+    return records;
+}
+
+static void printResult(const char* name, const ReplayResult& result, double hostMs) {
+    printf("REPLAY,%s,events=%u,ticks=%u,virtual=%ums,host=%.2fms,temp=%.3f,output=%.3f,target=%.1f,digest=%016llX\n",
+           name, result.inputEvents, result.controlTicks, result.elapsed, hostMs,
+           result.finalTemp, result.finalOutput, result.finalTarget, (unsigned long long)result.digest);
+}
+
+// 同一记录回放两次 (且回放开始时钟不同)，全部结果逐位相同
+void test_replay_deterministic() {
+    std::vector<TraceRecord> records = synthTrace();
+
+    auto start = std::chrono::steady_clock::now();
+    ReplayResult first = replay(records, 1000, SYNTH_TARGET_TEMP);
+    double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ReplayResult second = replay(records, 4000000, SYNTH_TARGET_TEMP);
+    printResult("synth", first, hostMs);
+
+    TEST_ASSERT_TRUE(first.finished);
+    TEST_ASSERT_EQUAL_UINT32(first.inputEvents, second.inputEvents);
+    TEST_ASSERT_EQUAL_UINT32(first.controlTicks, second.controlTicks);
+    TEST_ASSERT_TRUE(first.digest == second.digest);
+}
+
+// 控制回路按记录中的命令和参数工作，UI由记录的输入得到相同的命令和目标温度
+void test_replay_delivers_trace() {
+    std::vector<TraceRecord> records = synthTrace();
+
+    ReplayResult result = replay(records, 0, SYNTH_TARGET_TEMP);
+    TEST_ASSERT_TRUE(result.finished);
+
+    // 单击和两次旋转
+    TEST_ASSERT_EQUAL_UINT32(3, result.inputEvents);
+    TEST_ASSERT_EQUAL_UINT32(CMD_START, result.uiCommands);
+    TEST_ASSERT_EQUAL_FLOAT(61.0f, result.finalTarget);
+    TEST_ASSERT_EQUAL_FLOAT(61.0f, result.uiTarget);
+
+    // 记录末尾约61.1℃，升温已趋平，滑动平均的滞后可以忽略；略高于目标，输出很小
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, 61.1f, result.finalTemp);
+    TEST_ASSERT_TRUE(result.finalOutput < 100.0);
+
+    // 回放结束后停止加热
+    TEST_ASSERT_EQUAL_INT(STATE_IDLE, result.stateAfter);
+}
+
+// 回放期间控制回路只使用记录中的命令和参数: UI的目标温度不同，控制结果相同
+void test_replay_ignores_ui_target() {
+    std::vector<TraceRecord> records = synthTrace();
+
+    ReplayResult field = replay(records, 0, SYNTH_TARGET_TEMP);
+    ReplayResult other = replay(records, 0, 40.0f);
+    TEST_ASSERT_EQUAL_FLOAT(41.0f, other.uiTarget);
+    TEST_ASSERT_EQUAL_FLOAT(field.finalTarget, other.finalTarget);
+    TEST_ASSERT_TRUE(field.finalOutput == other.finalOutput);
+    TEST_ASSERT_EQUAL_UINT32(field.controlTicks, other.controlTicks);
+    TEST_ASSERT_EQUAL_INT(STATE_IDLE, other.stateAfter);
+}
+
+// TRACE_FILE指定的现场记录
+void test_replay_trace_file() {
+    const char* path = getenv("TRACE_FILE");
+    if (path == nullptr) {
+        TEST_IGNORE_MESSAGE("TRACE_FILE not set");
+        return;
+    }
+
+    std::vector<TraceRecord> records = loadTrace(path);
+    TEST_ASSERT_TRUE(records.size() > 0);
+    TEST_ASSERT_TRUE(records.size() <= TRACE_BUFFER_SIZE);
+
+    auto start = std::chrono::steady_clock::now();
+    ReplayResult first = replay(records, 1000, TEMP_DEFAULT);
+    double hostMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ReplayResult second = replay(records, 1000, TEMP_DEFAULT);
+    printResult(path, first, hostMs);
+
+    TEST_ASSERT_TRUE(first.digest == second.digest);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_replay_deterministic);
+    RUN_TEST(test_replay_delivers_trace);
+    RUN_TEST(test_replay_ignores_ui_target);
+    RUN_TEST(test_replay_trace_file);
+    return UNITY_END();
+}